@@ -0,0 +1,87 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "bench_utils.h"
+
+BENCH_HANDLES::BENCH_HANDLES() {
+    SQLHDBC hdbc = nullptr;
+    SQLHSTMT hstmt = nullptr;
+
+    SQLAllocHandle(SQL_HANDLE_ENV, nullptr, &env);
+    SQLAllocHandle(SQL_HANDLE_DBC, env, &hdbc);
+    dbc = static_cast<DBC*>(hdbc);
+
+    ds = new DataSource();
+    ds->opt_NO_SSPS = true;
+    dbc->ds = ds;
+    dbc->connection_proxy = new FAKE_CONNECTION_PROXY(dbc, ds);
+    dbc->cxn_charset_info = get_charset_by_csname("utf8mb4", MYF(MY_CS_PRIMARY), MYF(0));
+    dbc->ansi_charset_info = dbc->cxn_charset_info;
+
+    SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    stmt = static_cast<STMT*>(hstmt);
+}
+
+BENCH_HANDLES::~BENCH_HANDLES() {
+    if (stmt) {
+        SQLFreeHandle(SQL_HANDLE_STMT, static_cast<SQLHSTMT>(stmt));
+    }
+    if (dbc) {
+        dbc->ds = nullptr;
+        SQLFreeHandle(SQL_HANDLE_DBC, static_cast<SQLHDBC>(dbc));
+    }
+    if (env) {
+        SQLFreeHandle(SQL_HANDLE_ENV, env);
+    }
+    delete ds;
+}
+
+CANNED_RESULT::CANNED_RESULT(unsigned int columns, enum_field_types type, const std::string& value)
+    : fields(columns), values(columns, value), row(columns) {
+
+    for (unsigned int i = 0; i < columns; ++i) {
+        MYSQL_FIELD& field = fields[i];
+        field.name = const_cast<char*>("col");
+        field.org_name = field.name;
+        field.table = const_cast<char*>("t");
+        field.org_table = field.table;
+        field.db = const_cast<char*>("test");
+        field.catalog = const_cast<char*>("def");
+        field.def = const_cast<char*>("");
+        field.type = type;
+        field.length = 255;
+        field.max_length = (unsigned long)value.size();
+        field.charsetnr = 255; /* utf8mb4_0900_ai_ci */
+        row[i] = &values[i][0];
+    }
+
+    result.fields = fields.data();
+    result.field_count = columns;
+    result.row_count = 1;
+}
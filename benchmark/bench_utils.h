@@ -0,0 +1,98 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __BENCHUTILS_H__
+#define __BENCHUTILS_H__
+
+#include "driver/driver.h"
+#include "driver/connection_proxy.h"
+
+#include <string>
+#include <vector>
+
+// Connection proxy that answers from memory, so that the driver code above it
+// can be measured without a server.
+class FAKE_CONNECTION_PROXY : public CONNECTION_PROXY {
+public:
+    FAKE_CONNECTION_PROXY(DBC* dbc, DataSource* ds) : CONNECTION_PROXY(dbc, ds) {}
+
+    void delete_ds() override {}
+    uint64_t num_rows(MYSQL_RES* res) override { return res ? res->row_count : 0; }
+    unsigned int num_fields(MYSQL_RES* res) override { return res ? res->field_count : 0; }
+    MYSQL_FIELD* fetch_field_direct(MYSQL_RES* res, unsigned int fieldnr) override { return res->fields + fieldnr; }
+    unsigned int field_count() override { return 0; }
+    uint64_t affected_rows() override { return 0; }
+    unsigned int error_code() override { return 0; }
+    const char* error() override { return ""; }
+    const char* sqlstate() override { return "00000"; }
+    int query(const char* q) override { return 0; }
+    int real_query(const char* q, unsigned long length) override { return 0; }
+    MYSQL_RES* store_result() override { return nullptr; }
+    MYSQL_RES* use_result() override { return nullptr; }
+    void free_result(MYSQL_RES* result) override {}
+    MYSQL_ROW fetch_row(MYSQL_RES* result) override { return nullptr; }
+    unsigned long* fetch_lengths(MYSQL_RES* result) override { return nullptr; }
+    unsigned long real_escape_string(char* to, const char* from, unsigned long length) override {
+        return mysql_escape_string(to, from, length);
+    }
+    bool more_results() override { return false; }
+    int next_result() override { return -1; }
+    void close() override {}
+    bool is_connected() override { return true; }
+    char* get_server_version() const override { return const_cast<char*>("8.0.36"); }
+    unsigned long get_max_packet() const override { return 64 * 1024 * 1024; }
+    unsigned int get_server_status() const override { return 0; }
+    std::string get_host() override { return "localhost"; }
+    unsigned int get_port() override { return 3306; }
+};
+
+// Environment, connection and statement handles wired to a FAKE_CONNECTION_PROXY.
+class BENCH_HANDLES {
+public:
+    BENCH_HANDLES();
+    ~BENCH_HANDLES();
+
+    SQLHENV env = nullptr;
+    DBC* dbc = nullptr;
+    DataSource* ds = nullptr;
+    STMT* stmt = nullptr;
+};
+
+// Result set with string columns, laid out the way libmysql returns a stored result.
+class CANNED_RESULT {
+public:
+    CANNED_RESULT(unsigned int columns, enum_field_types type, const std::string& value);
+
+    MYSQL_RES result{};
+    std::vector<MYSQL_FIELD> fields;
+    std::vector<std::string> values;
+    std::vector<char*> row;
+};
+
+#endif /* __BENCHUTILS_H__ */
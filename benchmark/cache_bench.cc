@@ -0,0 +1,74 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "bench_utils.h"
+#include "driver/cache_map.h"
+#include "driver/custom_endpoint_info.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+    const long long expiration_nanos = 60000000000;
+}
+
+static void BM_CacheMapGet(benchmark::State& state) {
+    CACHE_MAP<std::string, std::shared_ptr<CUSTOM_ENDPOINT_INFO>> cache;
+    const int entries = (int)state.range(0);
+    std::vector<std::string> keys;
+    for (int i = 0; i < entries; ++i) {
+        keys.push_back("custom-endpoint-" + std::to_string(i) + ".cluster-custom-xyz.us-east-2.rds.amazonaws.com");
+        cache.put(keys.back(), nullptr, expiration_nanos);
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.get(keys[i++ % keys.size()], nullptr));
+    }
+}
+BENCHMARK(BM_CacheMapGet)->Arg(1)->Arg(100)->Arg(10000);
+
+static void BM_CacheMapPut(benchmark::State& state) {
+    CACHE_MAP<std::string, std::shared_ptr<CUSTOM_ENDPOINT_INFO>> cache;
+    const std::string key = "custom-endpoint.cluster-custom-xyz.us-east-2.rds.amazonaws.com";
+
+    for (auto _ : state) {
+        cache.put(key, nullptr, expiration_nanos);
+    }
+}
+BENCHMARK(BM_CacheMapPut);
+
+static void BM_SspsCacheKey(benchmark::State& state) {
+    const std::string query = "  SELECT id, name, created_at FROM customers WHERE id = ? AND status = ?  ";
+    const std::string database = "test";
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SSPS_CACHE::make_key(query.c_str(), query.size(), 255, database));
+    }
+}
+BENCHMARK(BM_SspsCacheKey);
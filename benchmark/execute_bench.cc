@@ -0,0 +1,90 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+
+// Client side interpolation of character parameters into the query text.
+static void BM_InsertParams(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    STMT* stmt = handles.stmt;
+    const int param_count = (int)state.range(0);
+
+    std::string query = "INSERT INTO t VALUES (";
+    for (int i = 0; i < param_count; ++i) {
+        query += i ? ", ?" : "?";
+    }
+    query += ")";
+
+    if (prepare(stmt, &query[0], (SQLINTEGER)query.size(), false, false) != SQL_SUCCESS) {
+        state.SkipWithError("prepare failed");
+        return;
+    }
+
+    std::vector<std::string> values(param_count, "it's a value with \"quotes\"");
+    std::vector<SQLLEN> lengths(param_count, SQL_NTS);
+    for (int i = 0; i < param_count; ++i) {
+        SQLBindParameter(static_cast<SQLHSTMT>(stmt), (SQLUSMALLINT)(i + 1), SQL_PARAM_INPUT,
+                         SQL_C_CHAR, SQL_VARCHAR, 255, 0, &values[i][0], 0, &lengths[i]);
+    }
+
+    const char* final_query;
+    SQLULEN final_length;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(insert_params(stmt, 0, &final_query, &final_length));
+    }
+    state.SetItemsProcessed(state.iterations() * param_count);
+}
+BENCHMARK(BM_InsertParams)->Arg(1)->Arg(8)->Arg(64);
+
+// Interpolation of one large character parameter, as in LOAD-style INSERTs.
+static void BM_InsertLargeParam(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    STMT* stmt = handles.stmt;
+
+    std::string query = "INSERT INTO t (doc) VALUES (?)";
+    if (prepare(stmt, &query[0], (SQLINTEGER)query.size(), false, false) != SQL_SUCCESS) {
+        state.SkipWithError("prepare failed");
+        return;
+    }
+
+    std::string value(state.range(0), 'x');
+    SQLLEN length = (SQLLEN)value.size();
+    SQLBindParameter(static_cast<SQLHSTMT>(stmt), 1, SQL_PARAM_INPUT, SQL_C_CHAR,
+                     SQL_LONGVARCHAR, value.size(), 0, &value[0], 0, &length);
+
+    const char* final_query;
+    SQLULEN final_length;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(insert_params(stmt, 0, &final_query, &final_length));
+    }
+    state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK(BM_InsertLargeParam)->Arg(1 << 20)->Arg(16 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,98 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "bench_utils.h"
+#include "driver/query_parsing.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+    const std::vector<std::string> queries = {
+        "SELECT id, name, created_at FROM customers WHERE id = ?",
+        "INSERT INTO orders (customer_id, product_id, quantity, price, note) VALUES (?, ?, ?, ?, 'a;b \\'c\\' ?')",
+        "/* report */ SELECT o.id, SUM(l.price * l.quantity) AS total FROM orders o "
+        "JOIN order_lines l ON l.order_id = o.id -- by order\n"
+        "WHERE o.created_at BETWEEN ? AND ? AND o.status IN ('new', 'paid', \"sent\") "
+        "GROUP BY o.id HAVING total > ? ORDER BY total DESC LIMIT 100"
+    };
+
+    // Multi-row INSERT of about the given size, as built for batched parameter arrays
+    std::string make_insert(size_t size) {
+        std::string query = "INSERT INTO orders (id, customer, note, price) VALUES ";
+        for (size_t i = 0; query.size() < size; ++i) {
+            query += "(" + std::to_string(i) + ", 'customer \\'" + std::to_string(i) +
+                     "\\'', 'caf\xC3\xA9; note with some text ?', 12.50),";
+        }
+        query.back() = ' ';
+        return query;
+    }
+}
+
+static void BM_Parse(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    std::string query = queries[state.range(0)];
+    MY_PARSED_QUERY pq;
+
+    for (auto _ : state) {
+        pq.reset(&query[0], &query[0] + query.size(), handles.dbc->cxn_charset_info);
+        benchmark::DoNotOptimize(parse(&pq));
+    }
+    state.SetBytesProcessed(state.iterations() * query.size());
+}
+BENCHMARK(BM_Parse)->DenseRange(0, 2);
+
+static void BM_ParseQueryIntoStatements(benchmark::State& state) {
+    std::string batch;
+    for (const auto& query : queries) {
+        batch += query + ";\n";
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_query_into_statements(batch.c_str()));
+    }
+    state.SetBytesProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(BM_ParseQueryIntoStatements);
+
+// Arguments are the query size and whether the ASCII byte scan is used
+static void BM_TokenizeLargeInsert(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    std::string query = make_insert(state.range(0));
+    MY_PARSED_QUERY pq;
+    MY_PARSER parser;
+
+    for (auto _ : state) {
+        pq.reset(&query[0], &query[0] + query.size(), handles.dbc->cxn_charset_info);
+        init_parser(&parser, &pq);
+        parser.ascii_scan = state.range(1) != 0;
+        benchmark::DoNotOptimize(tokenize(&parser));
+    }
+    state.SetBytesProcessed(state.iterations() * query.size());
+}
+BENCHMARK(BM_TokenizeLargeInsert)->ArgsProduct({{1 << 20, 8 << 20}, {0, 1}})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,85 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "bench_utils.h"
+#include "driver/efm_proxy.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+    // Hands out a context without starting a monitor, so only the proxy's own work is measured.
+    class BENCH_MONITOR_SERVICE : public MONITOR_SERVICE {
+    public:
+        BENCH_MONITOR_SERVICE() : MONITOR_SERVICE(std::shared_ptr<MONITOR_THREAD_CONTAINER>()) {}
+
+        std::shared_ptr<MONITOR_CONNECTION_CONTEXT> start_monitoring(
+            DBC* dbc, DataSource* ds, std::set<std::string> node_keys, std::shared_ptr<HOST_INFO> host,
+            std::chrono::milliseconds failure_detection_time, std::chrono::seconds failure_detection_timeout,
+            std::chrono::milliseconds failure_detection_interval, int failure_detection_count,
+            std::chrono::milliseconds disposal_time) override {
+
+            return std::make_shared<MONITOR_CONNECTION_CONTEXT>(
+                nullptr, node_keys, failure_detection_time, failure_detection_interval, failure_detection_count);
+        }
+
+        void stop_monitoring(std::shared_ptr<MONITOR_CONNECTION_CONTEXT> context) override {}
+        void stop_monitoring_for_all_connections(std::set<std::string> node_keys) override {}
+    };
+}
+
+static void BM_ProxyQuery(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    handles.ds->opt_ENABLE_FAILURE_DETECTION = state.range(0) != 0;
+
+    auto* fake_proxy = new FAKE_CONNECTION_PROXY(handles.dbc, handles.ds);
+    EFM_PROXY efm_proxy(handles.dbc, handles.ds, fake_proxy, std::make_shared<BENCH_MONITOR_SERVICE>());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(efm_proxy.query("SELECT 1"));
+    }
+}
+BENCHMARK(BM_ProxyQuery)->Arg(0)->Arg(1);
+
+static void BM_ProxyFetchRow(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    handles.ds->opt_ENABLE_FAILURE_DETECTION = true;
+
+    auto* fake_proxy = new FAKE_CONNECTION_PROXY(handles.dbc, handles.ds);
+    EFM_PROXY efm_proxy(handles.dbc, handles.ds, fake_proxy, std::make_shared<BENCH_MONITOR_SERVICE>());
+
+    // A stored result has its rows in client memory, an unbuffered one reads them from the server
+    CANNED_RESULT canned(4, MYSQL_TYPE_VAR_STRING, "value");
+    MYSQL_DATA data{};
+    canned.result.data = state.range(0) ? &data : nullptr;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(efm_proxy.fetch_row(&canned.result));
+    }
+}
+BENCHMARK(BM_ProxyFetchRow)->Arg(0)->Arg(1);
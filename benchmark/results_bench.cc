@@ -0,0 +1,121 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+
+static void BM_CopyWcharResult(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    CANNED_RESULT canned(1, MYSQL_TYPE_VAR_STRING, std::string(state.range(0), 'x'));
+    std::vector<SQLWCHAR> buffer(state.range(0) + 1);
+    SQLLEN length = 0;
+
+    for (auto _ : state) {
+        handles.stmt->reset_getdata_position();
+        benchmark::DoNotOptimize(copy_wchar_result(
+            handles.stmt, buffer.data(), (SQLINTEGER)(buffer.size() * sizeof(SQLWCHAR)), &length,
+            &canned.fields[0], canned.row[0], (long)canned.values[0].size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CopyWcharResult)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_SqlGetData(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    const bool numeric = state.range(0) != 0;
+    CANNED_RESULT canned(1, numeric ? MYSQL_TYPE_LONG : MYSQL_TYPE_VAR_STRING,
+                         numeric ? "1234567" : "a string value of moderate length");
+    handles.stmt->result = &canned.result;
+
+    char buffer[256];
+    SQLINTEGER number = 0;
+    SQLLEN length = 0;
+
+    for (auto _ : state) {
+        handles.stmt->reset_getdata_position();
+        if (numeric) {
+            benchmark::DoNotOptimize(sql_get_data(handles.stmt, SQL_C_LONG, 0, &number, 0, &length,
+                                                  canned.row[0], (ulong)canned.values[0].size(), nullptr));
+        }
+        else {
+            benchmark::DoNotOptimize(sql_get_data(handles.stmt, SQL_C_CHAR, 0, buffer, sizeof(buffer), &length,
+                                                  canned.row[0], (ulong)canned.values[0].size(), nullptr));
+        }
+    }
+    handles.stmt->result = nullptr;
+}
+BENCHMARK(BM_SqlGetData)->Arg(0)->Arg(1);
+
+// Filling of bound column buffers for one row, as done by SQLFetch.
+static void BM_FillFetchBuffers(benchmark::State& state) {
+    BENCH_HANDLES handles;
+    STMT* stmt = handles.stmt;
+    const unsigned int columns = (unsigned int)state.range(0);
+    CANNED_RESULT canned(columns, MYSQL_TYPE_VAR_STRING, "bound column value");
+    stmt->result = &canned.result;
+    fix_result_types(stmt);
+
+    std::vector<std::vector<char>> buffers(columns, std::vector<char>(64));
+    std::vector<SQLLEN> lengths(columns);
+    for (unsigned int i = 0; i < columns; ++i) {
+        SQLBindCol(static_cast<SQLHSTMT>(stmt), (SQLUSMALLINT)(i + 1), SQL_C_CHAR,
+                   buffers[i].data(), (SQLLEN)buffers[i].size(), &lengths[i]);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fill_fetch_buffers(stmt, canned.row.data(), 0));
+    }
+    state.SetItemsProcessed(state.iterations() * columns);
+    stmt->result = nullptr;
+}
+BENCHMARK(BM_FillFetchBuffers)->Arg(1)->Arg(16)->Arg(128);
+
+static void BM_RowStorageFill(benchmark::State& state) {
+    const size_t rows = (size_t)state.range(0);
+    const size_t columns = 8;
+    ROW_STORAGE storage;
+
+    for (auto _ : state) {
+        // Filled the way catalog functions do: one row is added at a time
+        storage.invalidate();
+        storage.set_size(1, columns);
+        for (size_t r = 0; r < rows; ++r) {
+            if (r) {
+                storage.next_row();
+            }
+            for (size_t c = 0; c < columns; ++c) {
+                storage[c] = "row storage value";
+            }
+        }
+        benchmark::DoNotOptimize(storage.data());
+    }
+    state.SetItemsProcessed(state.iterations() * rows * columns);
+}
+BENCHMARK(BM_RowStorageFill)->Arg(1)->Arg(100)->Arg(10000);
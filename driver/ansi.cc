@@ -344,9 +344,11 @@ SQLExecDirect(SQLHSTMT hstmt, SQLCHAR *str, SQLINTEGER str_len)
 
   LOCK_STMT(hstmt);
 
-  if ((error= SQLPrepareImpl(hstmt, str, str_len, false)))
+  /* A call that returned SQL_STILL_EXECUTING continues the execution */
+  if (!((STMT *)hstmt)->async.pending() &&
+      (error= SQLPrepareImpl(hstmt, str, str_len, false)))
     return error;
-  error= my_SQLExecute((STMT *)hstmt);
+  error= my_SQLExecuteAsync((STMT *)hstmt, SQL_API_SQLEXECDIRECT);
 
   return error;
 }
@@ -35,6 +35,8 @@
 
 #include "driver.h"
 #include "catalog.h"
+#include <algorithm>
+#include <functional>
 
 static char SC_type[10],SC_typename[20],SC_precision[10],SC_length[10],SC_scale[10],
 SC_nullable[10], SC_coldef[10], SC_sqltype[10],SC_octlen[10],
@@ -96,7 +98,7 @@ size_t ROW_STORAGE::set_size(size_t rnum, size_t cnum)
 
   if (new_size)
   {
-    m_data.resize(new_size, "");
+    m_data.resize(new_size);
     m_pdata.resize(new_size, nullptr);
 
     // Move the current row back if the array had shrunk
@@ -105,12 +107,18 @@ size_t ROW_STORAGE::set_size(size_t rnum, size_t cnum)
   }
   else
   {
-    // Clear if the size is zero
+    // Clear if the size is zero, allocated memory is kept for reuse
     m_data.clear();
     m_pdata.clear();
+    m_arena.clear();
+    m_garbage = 0;
     m_cur_row = 0;
   }
 
+  // New cells point to the empty string at the start of the arena
+  if (m_arena.empty())
+    m_arena.push_back('\0');
+
   return new_size;
 }
 
@@ -127,21 +135,94 @@ bool ROW_STORAGE::next_row()
   return false;
 }
 
-const xstring & ROW_STORAGE::operator=(const xstring &val)
+void ROW_STORAGE::set_cell(size_t cell_idx, const char *data, size_t size)
+{
+  CELL &cell = m_data[cell_idx];
+
+  if (cell.offset)
+    m_garbage += cell.length + 1;
+
+  cell.is_null = data == nullptr;
+  cell.length = cell.is_null ? 0 : size;
+  cell.offset = 0;
+
+  if (cell.length == 0)
+    return;
+
+  // The value may come from the arena, which can move below
+  std::less<const char*> before;
+  std::string copy;
+  if (!before(data, m_arena.data()) &&
+      before(data, m_arena.data() + m_arena.size()))
+  {
+    copy.assign(data, size);
+    data = copy.data();
+  }
+
+  if (m_garbage >= ROW_STORAGE_MIN_GARBAGE && m_garbage > m_arena.size() / 2)
+    compact();
+
+  cell.offset = m_arena.size();
+  m_arena.resize(cell.offset + size + 1);
+  memcpy(m_arena.data() + cell.offset, data, size);
+  m_arena[cell.offset + size] = '\0';
+}
+
+void ROW_STORAGE::compact()
+{
+  // Cells are visited in the order of their values, so that every value
+  // moves towards the start of the arena and is moved only once
+  std::vector<CELL*> cells;
+  for (CELL &cell : m_data)
+  {
+    if (cell.offset)
+      cells.push_back(&cell);
+  }
+  std::sort(cells.begin(), cells.end(), [](const CELL *a, const CELL *b) {
+    return a->offset < b->offset;
+  });
+
+  size_t end = 1, last_offset = 0, last_moved_to = 0;
+  for (CELL *cell : cells)
+  {
+    // Copied cells share the value
+    if (cell->offset == last_offset)
+    {
+      cell->offset = last_moved_to;
+      continue;
+    }
+
+    last_offset = cell->offset;
+    last_moved_to = end;
+    memmove(m_arena.data() + end, m_arena.data() + cell->offset,
+            cell->length + 1);
+    cell->offset = end;
+    end += cell->length + 1;
+  }
+
+  m_arena.resize(end);
+  m_garbage = 0;
+}
+
+void ROW_STORAGE::copy_cell(size_t dest_idx, size_t src_idx)
+{
+  // Cell values are immutable, so the copy can share the bytes
+  m_data[dest_idx] = m_data[src_idx];
+}
+
+const ROW_STORAGE & ROW_STORAGE::operator=(const xstring &val)
 {
-  size_t offs = m_cur_row * m_cnum + m_cur_col;
-  m_data[offs] = val;
-  m_pdata[offs] = m_data[offs].c_str();
-  return m_data[offs];
+  (*this)[m_cur_col] = val;
+  return *this;
 }
 
-xstring& ROW_STORAGE::operator[](size_t idx)
+ROW_STORAGE::cell_ref ROW_STORAGE::operator[](size_t idx)
 {
   if (idx >= m_cnum)
     throw ("Column number is out of bounds");
 
   m_cur_col = idx;
-  return m_data[m_cur_row * m_cnum + m_cur_col];
+  return cell_ref(*this, m_cur_row * m_cnum + m_cur_col);
 }
 
 const char** ROW_STORAGE::data()
@@ -151,7 +232,8 @@ const char** ROW_STORAGE::data()
 
   while(m_data_it != m_data.end())
   {
-    *m_pdata_it = m_data_it->c_str();
+    *m_pdata_it = m_data_it->is_null ? nullptr :
+                  m_arena.data() + m_data_it->offset;
     ++m_pdata_it;
     ++m_data_it;
   }
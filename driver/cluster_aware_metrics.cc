@@ -45,6 +45,10 @@ void CLUSTER_AWARE_METRICS::register_reader_failover_procedure_time(long long ti
 	reader_failover_procedure->register_query_execution_time(time_ms);
 }
 
+void CLUSTER_AWARE_METRICS::register_writer_failover_poll_interval(long long time_ms) {
+	writer_failover_poll_interval->register_query_execution_time(time_ms);
+}
+
 void CLUSTER_AWARE_METRICS::register_topology_query_time(long long time_ms) {
 	topology_query->register_query_execution_time(time_ms);
 }
@@ -67,6 +71,7 @@ std::string CLUSTER_AWARE_METRICS::report_metrics() {
 	log_message.append(failure_detection->report_metrics());
 	log_message.append(writer_failover_procedure->report_metrics());
 	log_message.append(reader_failover_procedure->report_metrics());
+	log_message.append(writer_failover_poll_interval->report_metrics());
 	log_message.append(topology_query->report_metrics());
 	log_message.append(use_cached_topology->report_metrics());
 	log_message.append(invalid_initial_connection->report_metrics());
@@ -42,6 +42,7 @@ public:
 	void register_failure_detection_time(long long time_ms);
 	void register_writer_failover_procedure_time(long long time_ms);
 	void register_reader_failover_procedure_time(long long time_ms);
+	void register_writer_failover_poll_interval(long long time_ms);
 	void register_topology_query_time(long long time_ms);
 	void register_failover_connects(bool is_hit);
 	void register_invalid_initial_connection(bool is_hit);
@@ -53,6 +54,7 @@ private:
 	std::shared_ptr<CLUSTER_AWARE_TIME_METRICS_HOLDER> failure_detection = std::make_shared<CLUSTER_AWARE_TIME_METRICS_HOLDER>("Failover Detection");
 	std::shared_ptr<CLUSTER_AWARE_TIME_METRICS_HOLDER> writer_failover_procedure = std::make_shared<CLUSTER_AWARE_TIME_METRICS_HOLDER>("Writer Failover Procedure");
 	std::shared_ptr<CLUSTER_AWARE_TIME_METRICS_HOLDER> reader_failover_procedure = std::make_shared<CLUSTER_AWARE_TIME_METRICS_HOLDER>("Reader Failover Procedure");
+	std::shared_ptr<CLUSTER_AWARE_TIME_METRICS_HOLDER> writer_failover_poll_interval = std::make_shared<CLUSTER_AWARE_TIME_METRICS_HOLDER>("Writer Failover Poll Interval");
 	std::shared_ptr<CLUSTER_AWARE_TIME_METRICS_HOLDER> topology_query = std::make_shared<CLUSTER_AWARE_TIME_METRICS_HOLDER>("Topology Query");
 	std::shared_ptr<CLUSTER_AWARE_HIT_METRICS_HOLDER> failover_connects = std::make_shared<CLUSTER_AWARE_HIT_METRICS_HOLDER>("Successful Failover Reconnects");
 	std::shared_ptr<CLUSTER_AWARE_HIT_METRICS_HOLDER> invalid_initial_connection = std::make_shared<CLUSTER_AWARE_HIT_METRICS_HOLDER>("Invalid Initial Connection");
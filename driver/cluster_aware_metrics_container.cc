@@ -59,6 +59,10 @@ void CLUSTER_AWARE_METRICS_CONTAINER::register_reader_failover_procedure_time(lo
     CLUSTER_AWARE_METRICS_CONTAINER::register_metrics([time_ms](std::shared_ptr<CLUSTER_AWARE_METRICS> metrics){metrics->register_reader_failover_procedure_time(time_ms);});
 }
 
+void CLUSTER_AWARE_METRICS_CONTAINER::register_writer_failover_poll_interval(long long time_ms) {
+    CLUSTER_AWARE_METRICS_CONTAINER::register_metrics([time_ms](std::shared_ptr<CLUSTER_AWARE_METRICS> metrics){metrics->register_writer_failover_poll_interval(time_ms);});
+}
+
 void CLUSTER_AWARE_METRICS_CONTAINER::register_failover_connects(bool is_hit) {
     CLUSTER_AWARE_METRICS_CONTAINER::register_metrics([is_hit](std::shared_ptr<CLUSTER_AWARE_METRICS> metrics){metrics->register_failover_connects(is_hit);});
 }
@@ -53,6 +53,7 @@ public:
     void register_failure_detection_time(long long time_ms);
     void register_writer_failover_procedure_time(long long time_ms);
     void register_reader_failover_procedure_time(long long time_ms);
+    void register_writer_failover_poll_interval(long long time_ms);
     void register_failover_connects(bool is_hit);
     void register_invalid_initial_connection(bool is_hit);
     void register_use_cached_topology(bool is_hit);
@@ -1148,6 +1148,40 @@ SQLRETURN DBC::connect(DataSource *dsrc, bool failover_enabled, bool is_monitor_
 }
 
 
+/*
+  Creates the proxy chain and the failover handler for the data source and
+  connects through them. With SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE, if
+  allowed, the connection is established on a worker thread of the
+  environment and SQL_STILL_EXECUTING is returned until it is. The caller
+  then calls the connect function again to continue.
+*/
+SQLRETURN DBC::init_connection(DataSource *dsrc, bool allow_async)
+{
+  if (!pending_connect.valid())
+  {
+    init_proxy_chain(dsrc);
+    connection_handler = std::make_shared<CONNECTION_HANDLER>(this);
+    fh = new FAILOVER_HANDLER(this, dsrc);
+
+    if (!allow_async || !async_dbc_functions)
+    {
+      return fh->init_connection();
+    }
+
+    pending_connect_ds = dsrc;
+    pending_connect = env->start_connect([this]() { return fh->init_connection(); });
+  }
+
+  if (pending_connect.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+  {
+    return SQL_STILL_EXECUTING;
+  }
+
+  pending_connect_ds = nullptr;
+  return pending_connect.get();
+}
+
+
 /**
   Establish a connection to a data source.
 
@@ -1171,13 +1205,24 @@ SQLRETURN SQL_API MySQLConnect(SQLHDBC   hdbc,
 {
   SQLRETURN rc;
   DBC *dbc= (DBC *)hdbc;
-  DataSource* ds = new DataSource();
 
 #ifdef NO_DRIVERMANAGER
   return ((DBC*)dbc)->set_error("HY000",
                        "SQLConnect requires DSN and driver manager", 0);
 #else
 
+  /* The connection that returned SQL_STILL_EXECUTING continues */
+  if (dbc->pending_connect.valid())
+  {
+    rc = dbc->init_connection(dbc->pending_connect_ds, true);
+    if (rc != SQL_STILL_EXECUTING && !SQL_SUCCEEDED(rc))
+      dbc->telemetry.set_error(dbc, dbc->error.message);
+
+    return rc;
+  }
+
+  DataSource* ds = new DataSource();
+
   /* Can't connect if we're already connected. */
   if (dbc->connection_proxy != nullptr && dbc->connection_proxy->is_connected())
     return ((DBC*)hdbc)->set_error(MYERR_08002, NULL, 0);
@@ -1200,11 +1245,8 @@ SQLRETURN SQL_API MySQLConnect(SQLHDBC   hdbc,
   if (ds->opt_LOG_QUERY && !dbc->log_file)
       dbc->log_file = init_log_file();
 
-  dbc->init_proxy_chain(ds);
-  dbc->connection_handler = std::make_shared<CONNECTION_HANDLER>(dbc);
-  dbc->fh = new FAILOVER_HANDLER(dbc, ds);
-  rc = dbc->fh->init_connection();
-  if (!SQL_SUCCEEDED(rc))
+  rc = dbc->init_connection(ds, true);
+  if (rc != SQL_STILL_EXECUTING && !SQL_SUCCEEDED(rc))
     dbc->telemetry.set_error(dbc, dbc->error.message);
 
   return rc;
@@ -1265,6 +1307,19 @@ SQLRETURN SQL_API MySQLDriverConnect(SQLHDBC hdbc, SQLHWND hwnd,
   else
     conn_str_in = szConnStrIn;
 
+  /* The connection that returned SQL_STILL_EXECUTING continues */
+  if (dbc->pending_connect.valid())
+  {
+    delete ds;
+    ds = dbc->pending_connect_ds;
+
+    rc = dbc->init_connection(ds, true);
+    if (rc == SQL_STILL_EXECUTING)
+      return rc;
+
+    goto connect_done;
+  }
+
   /* Parse the incoming string */
   if (ds->from_kvpair(conn_str_in.c_str(), (SQLWCHAR)';'))
   {
@@ -1319,10 +1374,8 @@ SQLRETURN SQL_API MySQLDriverConnect(SQLHDBC hdbc, SQLHWND hwnd,
       if (ds->opt_LOG_QUERY && !log_file)
           log_file = init_log_file();
 
-    dbc->init_proxy_chain(ds);
-    dbc->connection_handler = std::make_shared<CONNECTION_HANDLER>(dbc);
-    dbc->fh = new FAILOVER_HANDLER(dbc, ds);
-    rc = dbc->fh->init_connection();
+    /* Prompting depends on the result, so the connection is synchronous */
+    rc = dbc->init_connection(ds, false);
 
     if (!SQL_SUCCEEDED(rc))
       dbc->telemetry.set_error(dbc, dbc->error.message);
@@ -1495,11 +1548,11 @@ SQLRETURN SQL_API MySQLDriverConnect(SQLHDBC hdbc, SQLHWND hwnd,
   if (ds->opt_LOG_QUERY && !log_file)
       log_file = init_log_file();
 
-  dbc->init_proxy_chain(ds);
-  dbc->connection_handler = std::make_shared<CONNECTION_HANDLER>(dbc);
-  dbc->fh = new FAILOVER_HANDLER(dbc, ds);
+  rc = dbc->init_connection(ds, !bPrompt);
+  if (rc == SQL_STILL_EXECUTING)
+    return rc;
 
-  rc = dbc->fh->init_connection();
+connect_done:
   if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
   {
     goto error;
@@ -1619,6 +1672,12 @@ SQLRETURN SQL_API SQLDisconnect(SQLHDBC hdbc)
 
   dbc->close();
 
+  if (dbc->fh)
+  {
+    dbc->fh->stop_standby_connections();
+    dbc->fh->stop_topology_monitoring();
+  }
+
   if (ds->opt_LOG_QUERY)
       end_log_file();
 
@@ -1632,6 +1691,14 @@ SQLRETURN SQL_API SQLDisconnect(SQLHDBC hdbc)
 void DBC::execute_prep_stmt(MYSQL_STMT *pstmt, std::string &query,
   std::vector<MYSQL_BIND> &param_bind, MYSQL_BIND *result_bind)
 {
+  /* The connection still reads the response to a statement */
+  if (async_stmt)
+  {
+    set_error(MYERR_S1010, "A statement of the connection is still "
+              "executing asynchronously", 0);
+    throw error;
+  }
+
   STMT stmt{this, param_bind.size()};
   telemetry::Telemetry<STMT> stmt_telemetry;
 
@@ -1714,6 +1781,13 @@ SQLRETURN DBC::execute_query(const char* query,
     query_length = strlen(query);
   }
 
+  /* The connection still reads the response to a statement */
+  if (async_stmt)
+  {
+    return set_error(MYERR_S1010, "A statement of the connection is still "
+                     "executing asynchronously", 0);
+  }
+
   // return immediately if not connected
   if (!this->connection_proxy->is_connected())
   {
@@ -1722,33 +1796,79 @@ SQLRETURN DBC::execute_query(const char* query,
 
   bool server_alive = is_server_alive(this);
   if (!server_alive || this->connection_proxy->real_query(query, query_length)) {
-    const unsigned int mysql_error_code = this->connection_proxy->error_code();
+    result = handle_query_error(server_alive);
+  }
 
-    MYLOG_DBC_TRACE(this, this->connection_proxy->error());
-    result = set_error(MYERR_S1000, this->connection_proxy->error(), mysql_error_code);
+  return result;
 
-    if (!server_alive || is_connection_lost(mysql_error_code)) {
-      bool rollback = (!autocommit_on(this) && trans_supported(this)) || this->transaction_open;
-      if (rollback) {
-        MYLOG_DBC_TRACE(this, "Rolling back");
-        this->connection_proxy->real_query("ROLLBACK", 8);
-      }
+}
 
-      const char *error_code, *error_msg;
-      if (this->fh->trigger_failover_if_needed("08S01", error_code, error_msg)) {
-        if (strcmp(error_code, "08007") == 0) {
-          result = set_error(MYERR_08007, "Connection failure during transaction.", 0);
-        } else if (strcmp(error_code, "08S02") == 0) {
-          result = set_error(MYERR_08S02, "The active SQL connection has changed.", 0);
-        } else {
-          result = set_error(MYERR_08S01, "The active SQL connection was lost.", 0);
-        }
-      }
 
-      this->transaction_open = false;
+/*
+  Sends the query, or continues sending it and reading the response, without
+  waiting for the server. The caller holds the lock and repeats the call with
+  the same query until it returns something other than SQL_STILL_EXECUTING.
+*/
+SQLRETURN DBC::execute_query_nonblocking(const char* query,
+  SQLULEN query_length, bool first_call)
+{
+  if (first_call)
+  {
+    if (!this->connection_proxy->is_connected())
+    {
+      return set_error(MYERR_08S01, "The active SQL connection was lost. Please discard this connection.", 0);
+    }
+
+    if (!is_server_alive(this))
+    {
+      return handle_query_error(false);
+    }
+  }
+
+  switch (this->connection_proxy->real_query_nonblocking(query,
+            (unsigned long)query_length))
+  {
+    case NET_ASYNC_NOT_READY:
+      return SQL_STILL_EXECUTING;
+    case NET_ASYNC_ERROR:
+      return handle_query_error(true);
+    default:
+      return SQL_SUCCESS;
+  }
+}
+
+
+/*
+  Sets the error of a failed query and starts the failover if the
+  connection was lost.
+*/
+SQLRETURN DBC::handle_query_error(bool server_alive)
+{
+  const unsigned int mysql_error_code = this->connection_proxy->error_code();
+
+  MYLOG_DBC_TRACE(this, this->connection_proxy->error());
+  SQLRETURN result = set_error(MYERR_S1000, this->connection_proxy->error(), mysql_error_code);
+
+  if (!server_alive || is_connection_lost(mysql_error_code)) {
+    bool rollback = (!autocommit_on(this) && trans_supported(this)) || this->transaction_open;
+    if (rollback) {
+      MYLOG_DBC_TRACE(this, "Rolling back");
+      this->connection_proxy->real_query("ROLLBACK", 8);
     }
+
+    const char *error_code, *error_msg;
+    if (this->fh->trigger_failover_if_needed("08S01", error_code, error_msg)) {
+      if (strcmp(error_code, "08007") == 0) {
+        result = set_error(MYERR_08007, "Connection failure during transaction.", 0);
+      } else if (strcmp(error_code, "08S02") == 0) {
+        result = set_error(MYERR_08S02, "The active SQL connection has changed.", 0);
+      } else {
+        result = set_error(MYERR_08S01, "The active SQL connection was lost.", 0);
+      }
+    }
+
+    this->transaction_open = false;
   }
 
   return result;
-
 }
@@ -35,6 +35,7 @@
 #include "connection_handler.h"
 #include "connection_proxy.h"
 #include "driver.h"
+#include "standby_connections.h"
 
 #include <codecvt>
 #include <locale>
@@ -66,6 +67,15 @@ CONNECTION_PROXY* CONNECTION_HANDLER::connect(std::shared_ptr<HOST_INFO> host_in
         return nullptr;
     }
 
+    if (!is_monitor_connection) {
+        if (auto standby = standby_connections.lock()) {
+            if (CONNECTION_PROXY* standby_connection = standby->take(host_info)) {
+                standby_connection->set_dbc(dbc);
+                return standby_connection;
+            }
+        }
+    }
+
     DataSource* ds_to_use = new DataSource();
     ds_to_use->copy(ds ? ds : dbc->ds);
     const auto new_host = to_sqlwchar_string(host_info->get_host());
@@ -107,6 +117,10 @@ void CONNECTION_HANDLER::update_connection(
     }
 }
 
+void CONNECTION_HANDLER::set_standby_connections(std::shared_ptr<STANDBY_CONNECTIONS> standby_connections) {
+    this->standby_connections = standby_connections;
+}
+
 DBC* CONNECTION_HANDLER::clone_dbc(DBC* source_dbc, DataSource* ds) {
 
     DBC* dbc_clone = nullptr;
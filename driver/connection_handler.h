@@ -44,6 +44,7 @@ sqlwchar_string to_sqlwchar_string(const std::string& src);
 struct DBC;
 class DataSource;
 class CONNECTION_PROXY;
+class STANDBY_CONNECTIONS;
 typedef short SQLRETURN;
 
 class CONNECTION_HANDLER {
@@ -54,9 +55,12 @@ class CONNECTION_HANDLER {
         virtual SQLRETURN do_connect(DBC* dbc_ptr, DataSource* ds, bool failover_enabled, bool is_monitor_connection = false);
         virtual CONNECTION_PROXY* connect(std::shared_ptr<HOST_INFO> host_info, DataSource* ds, bool is_monitor_connection = false);
         void update_connection(CONNECTION_PROXY* new_connection, const std::string& new_host_name);
+        // Connections to a host are taken from the standby connections if there is one
+        void set_standby_connections(std::shared_ptr<STANDBY_CONNECTIONS> standby_connections);
 
     private:
         DBC* dbc;
+        std::weak_ptr<STANDBY_CONNECTIONS> standby_connections;
         DBC* clone_dbc(DBC* source_dbc, DataSource* ds);
 };
 
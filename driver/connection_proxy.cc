@@ -143,6 +143,14 @@ MYSQL_RES* CONNECTION_PROXY::store_result() {
     return next_proxy->store_result();
 }
 
+net_async_status CONNECTION_PROXY::real_query_nonblocking(const char* q, unsigned long length) {
+    return next_proxy->real_query_nonblocking(q, length);
+}
+
+net_async_status CONNECTION_PROXY::store_result_nonblocking(MYSQL_RES** result) {
+    return next_proxy->store_result_nonblocking(result);
+}
+
 MYSQL_RES* CONNECTION_PROXY::use_result() {
     return next_proxy->use_result();
 }
@@ -175,6 +183,10 @@ int CONNECTION_PROXY::next_result() {
     return next_proxy->next_result();
 }
 
+net_async_status CONNECTION_PROXY::next_result_nonblocking() {
+    return next_proxy->next_result_nonblocking();
+}
+
 int CONNECTION_PROXY::stmt_next_result(MYSQL_STMT* stmt) {
     return next_proxy->stmt_next_result(stmt);
 }
@@ -411,6 +423,14 @@ void CONNECTION_PROXY::close_socket() {
     next_proxy->close_socket();
 }
 
+bool CONNECTION_PROXY::wait_for_response(int timeout_ms) {
+    return next_proxy->wait_for_response(timeout_ms);
+}
+
+bool CONNECTION_PROXY::release_failed_reader() {
+    return next_proxy != nullptr && next_proxy->release_failed_reader();
+}
+
 void CONNECTION_PROXY::set_next_proxy(CONNECTION_PROXY* next_proxy) {
     if (this->next_proxy) {
         throw std::runtime_error("There is already a next proxy present!");
@@ -75,6 +75,8 @@ public:
     virtual int real_query(const char* q, unsigned long length);
     virtual MYSQL_RES* store_result();
     virtual MYSQL_RES* use_result();
+    virtual net_async_status real_query_nonblocking(const char* q, unsigned long length);
+    virtual net_async_status store_result_nonblocking(MYSQL_RES** result);
     virtual struct CHARSET_INFO* get_character_set() const;
     virtual void get_character_set_info(MY_CHARSET_INFO* charset);
 
@@ -129,6 +131,7 @@ public:
     virtual bool rollback();
     virtual bool autocommit(bool auto_mode);
     virtual int next_result();
+    virtual net_async_status next_result_nonblocking();
     virtual bool more_results();
     virtual int stmt_next_result(MYSQL_STMT* stmt);
     virtual void close();
@@ -171,6 +174,12 @@ public:
 
     virtual void close_socket();
 
+    // Waits at most timeout_ms for data from the server, returns whether it has arrived
+    virtual bool wait_for_response(int timeout_ms);
+
+    // Stops using a lost connection to a reader opened along with the writer, returns whether there was one
+    virtual bool release_failed_reader();
+
     virtual void set_next_proxy(CONNECTION_PROXY* next_proxy);
 
     virtual MYSQL* move_mysql_connection();
@@ -40,6 +40,7 @@
 
 #include "driver.h"
 #include <algorithm>
+#include <atomic>
 
 /* Utility macros for defining descriptor fields */
 #define HDR_FLD(field, perm, type) \
@@ -81,6 +82,16 @@ void desc_free(DESC *desc)
 void DESC::reset()
 {
   records2.clear();
+  touch();
+}
+
+
+void DESC::touch()
+{
+  /* Versions are unique across descriptors, so a copied descriptor can not
+     be mistaken for an unchanged one */
+  static std::atomic<unsigned long long> last_version(0);
+  version= ++last_version;
 }
 
 void DESC::free_paramdata()
@@ -222,8 +233,10 @@ DESCREC *desc_get_rec(DESC *desc, int recnum, my_bool expand)
   {
     assert(recnum >= 0);
     /* expand if needed */
-    if (expand)
+    if (expand && (size_t)recnum >= desc->rcount())
     {
+      desc->touch();
+
       for (size_t i = desc->rcount(); expand && i <= recnum; ++i)
       {
         desc->records2.emplace_back(desc->desc_type, desc->ref_type);
@@ -744,6 +757,7 @@ SQLRETURN DESC::set_field(SQLSMALLINT recnum, SQLSMALLINT fldid,
   void *dest;
 
   error.clear();
+  touch();
 
   /* check for invalid IRD modification */
   if (is_ird())
@@ -949,6 +963,7 @@ SQLRETURN MySQLCopyDesc(SQLHDESC SourceDescHandle, SQLHDESC TargetDescHandle)
 
   /* copy the records, copy constructors should take care of everything */
   *dest = *src;
+  dest->touch();
 
   /* TODO consistency check on target, if needed (apd) */
 
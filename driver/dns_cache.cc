@@ -0,0 +1,227 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "dns_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/types.h>
+#endif
+
+DNS_CACHE& DNS_CACHE::get_instance() {
+    static DNS_CACHE instance;
+    return instance;
+}
+
+DNS_CACHE::DNS_CACHE(LOOKUP lookup, CLOCK clock)
+    : lookup{lookup}, clock{clock}, last_eviction{clock()} {}
+
+DNS_CACHE::~DNS_CACHE() {
+    release_resources();
+}
+
+std::string DNS_CACHE::get(const std::string& host, std::chrono::milliseconds ttl) {
+    if (host.empty()) {
+        return "";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    evict_expired(ttl);
+    auto& entry = entries[host];
+    if (is_fresh(entry, ttl)) {
+        return entry.address;
+    }
+    start_lookup(host, entry);
+    return "";
+}
+
+std::string DNS_CACHE::resolve(const std::string& host, std::chrono::milliseconds ttl,
+                               std::chrono::milliseconds timeout) {
+    if (host.empty()) {
+        return "";
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    evict_expired(ttl);
+    auto& entry = entries[host];
+    if (is_fresh(entry, ttl)) {
+        return entry.address;
+    }
+
+    const auto requested_at = clock();
+    start_lookup(host, entry);
+
+    // Entries may be cleared meanwhile, so they are looked up again
+    const auto is_resolved = [this, &host, requested_at] {
+        const auto it = entries.find(host);
+        return it == entries.end() ||
+               (it->second.resolved && it->second.resolved_at >= requested_at);
+    };
+    if (!cv.wait_for(lock, timeout, is_resolved)) {
+        return "";
+    }
+
+    const auto it = entries.find(host);
+    return it == entries.end() ? "" : it->second.address;
+}
+
+void DNS_CACHE::prefetch(const std::vector<std::string>& hosts, std::chrono::milliseconds ttl) {
+    std::lock_guard<std::mutex> lock(mutex);
+    evict_expired(ttl);
+    for (const auto& host : hosts) {
+        if (host.empty()) {
+            continue;
+        }
+        auto& entry = entries[host];
+        if (!is_fresh(entry, ttl)) {
+            start_lookup(host, entry);
+        }
+    }
+}
+
+void DNS_CACHE::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    cv.notify_all();
+}
+
+size_t DNS_CACHE::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void DNS_CACHE::release_resources() {
+    std::unique_ptr<ctpl::thread_pool> thread_pool;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_pool = std::move(lookup_thread_pool);
+    }
+    // Outside of the mutex, which the running lookups need to complete
+    if (thread_pool) {
+        thread_pool->stop();
+    }
+    clear();
+}
+
+bool DNS_CACHE::is_fresh(const ENTRY& entry, std::chrono::milliseconds ttl) {
+    if (!entry.resolved) {
+        return false;
+    }
+    const auto max_age = entry.address.empty()
+        ? (std::min)(ttl, std::chrono::milliseconds(DNS_NEGATIVE_CACHE_TTL_MS))
+        : ttl;
+    return clock() - entry.resolved_at < max_age;
+}
+
+void DNS_CACHE::start_lookup(const std::string& host, ENTRY& entry) {
+    if (entry.pending) {
+        return;
+    }
+
+    try {
+        if (!lookup_thread_pool) {
+            lookup_thread_pool.reset(new ctpl::thread_pool(DNS_LOOKUP_THREADS));
+        }
+    } catch (const std::system_error&) {
+        // Out of threads, the next request tries again
+        return;
+    }
+    entry.pending = true;
+
+    lookup_thread_pool->push([this, host](int) {
+        const std::string address = lookup(host);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& resolved_entry = entries[host];
+        resolved_entry.address = address;
+        resolved_entry.resolved_at = clock();
+        resolved_entry.resolved = true;
+        resolved_entry.pending = false;
+        cv.notify_all();
+    });
+}
+
+void DNS_CACHE::evict_expired(std::chrono::milliseconds ttl) {
+    // A TTL of 0 only bypasses the cache for the caller
+    const auto now = clock();
+    if (ttl.count() <= 0 || now - last_eviction < ttl) {
+        return;
+    }
+    last_eviction = now;
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (!it->second.pending && !is_fresh(it->second, ttl)) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::string DNS_CACHE::system_lookup(const std::string& host) {
+    struct addrinfo hints;
+    struct addrinfo* servinfo = nullptr;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &servinfo) != 0) {
+        return "";
+    }
+
+    std::string ipv4, ipv6;
+    char ipstr[INET6_ADDRSTRLEN];
+    for (struct addrinfo* p = servinfo; p != nullptr && ipv4.empty(); p = p->ai_next) {
+        if (p->ai_family == AF_INET) {
+            const auto addr = &((struct sockaddr_in*)p->ai_addr)->sin_addr;
+            if (inet_ntop(AF_INET, addr, ipstr, sizeof(ipstr))) {
+                ipv4 = ipstr;
+            }
+        } else if (p->ai_family == AF_INET6 && ipv6.empty()) {
+            const auto addr = &((struct sockaddr_in6*)p->ai_addr)->sin6_addr;
+            if (inet_ntop(AF_INET6, addr, ipstr, sizeof(ipstr))) {
+                ipv6 = ipstr;
+            }
+        }
+    }
+
+    freeaddrinfo(servinfo);
+    return ipv4.empty() ? ipv6 : ipv4;
+}
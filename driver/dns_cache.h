@@ -0,0 +1,112 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __DNS_CACHE_H__
+#define __DNS_CACHE_H__
+
+#include <ctpl_stl.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Failed lookups are retried after this time at the latest
+#define DNS_NEGATIVE_CACHE_TTL_MS 5000
+// Longest time a caller waits for a lookup that is not cached
+#define DNS_RESOLVE_TIMEOUT_MS 500
+// Number of threads running lookups, further lookups are queued
+#define DNS_LOOKUP_THREADS 4
+
+// Process-wide cache of the addresses host names resolve to. Lookups run on
+// a small pool of threads, so a slow or unreachable DNS server delays a
+// caller by at most the time it is willing to wait. Failed lookups are cached
+// as well, for the shorter of the TTL and DNS_NEGATIVE_CACHE_TTL_MS. Expired
+// entries are dropped at most once per TTL.
+class DNS_CACHE {
+public:
+    using LOOKUP = std::function<std::string(const std::string&)>;
+    using CLOCK = std::function<std::chrono::steady_clock::time_point()>;
+
+    static DNS_CACHE& get_instance();
+
+    DNS_CACHE(LOOKUP lookup = system_lookup, CLOCK clock = std::chrono::steady_clock::now);
+    ~DNS_CACHE();
+    DNS_CACHE(const DNS_CACHE&) = delete;
+    DNS_CACHE& operator=(const DNS_CACHE&) = delete;
+
+    // Returns the cached address of the host without waiting. A missing or
+    // expired entry is looked up in the background and "" is returned.
+    std::string get(const std::string& host, std::chrono::milliseconds ttl);
+    // Returns the address of the host, waiting at most the timeout for the
+    // lookup when no fresh entry is cached. "" if the host did not resolve.
+    std::string resolve(const std::string& host, std::chrono::milliseconds ttl,
+                        std::chrono::milliseconds timeout);
+    // Looks up in the background the hosts that have no fresh entry
+    void prefetch(const std::vector<std::string>& hosts, std::chrono::milliseconds ttl);
+    void clear();
+    size_t size();
+    // Waits for the running lookups, drops the queued ones and clears the
+    // cache. The threads are started again by the next lookup.
+    void release_resources();
+
+    // Blocking lookup with getaddrinfo(), IPv4 addresses are preferred.
+    // Returns "" if the host does not resolve.
+    static std::string system_lookup(const std::string& host);
+
+private:
+    struct ENTRY {
+        std::string address;  // "" for a failed lookup
+        std::chrono::steady_clock::time_point resolved_at;
+        bool resolved = false;
+        bool pending = false;
+    };
+
+    LOOKUP lookup;
+    CLOCK clock;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::unordered_map<std::string, ENTRY> entries;
+    std::chrono::steady_clock::time_point last_eviction;
+    std::unique_ptr<ctpl::thread_pool> lookup_thread_pool;
+
+    bool is_fresh(const ENTRY& entry, std::chrono::milliseconds ttl);
+    // The following must be called while holding the mutex
+    // Starts a lookup unless one is running
+    void start_lookup(const std::string& host, ENTRY& entry);
+    // Drops the entries older than the TTL, unless that was done less than
+    // a TTL ago
+    void evict_expired(std::chrono::milliseconds ttl);
+};
+
+#endif /* __DNS_CACHE_H__ */
@@ -47,6 +47,7 @@
 
 #include "connection_handler.h"
 #include "connection_proxy.h"
+#include "ssps_cache.h"
 #include "topology_service.h"
 #include "failover.h"
 
@@ -77,9 +78,15 @@
 
 #include "error.h"
 #include "parse.h"
+#include "parsed_query_cache.h"
+#include "read_ahead.h"
 #include <vector>
 #include <list>
+#include <condition_variable>
+#include <future>
 #include <mutex>
+#include <thread>
+#include <type_traits>
 
 #define LOCK_STMT(S) CHECK_HANDLE(S); \
   std::unique_lock<std::recursive_mutex> slock(((STMT*)S)->lock)
@@ -87,8 +94,8 @@
   std::unique_lock<std::recursive_mutex> slock(((STMT*)S)->lock, std::defer_lock)
 #define DO_LOCK_STMT() slock.lock();
 
-#define LOCK_DBC(D) std::unique_lock<std::recursive_mutex> dlock(((DBC*)D)->lock)
-#define LOCK_DBC_DEFER(D) std::unique_lock<std::recursive_mutex> dlock(((DBC*)D)->lock, std::defer_lock)
+#define LOCK_DBC(D) std::unique_lock<DBC_MUTEX> dlock(((DBC*)D)->lock)
+#define LOCK_DBC_DEFER(D) std::unique_lock<DBC_MUTEX> dlock(((DBC*)D)->lock, std::defer_lock)
 #define DO_LOCK_DBC() dlock.lock();
 
 #define LOCK_ENV(E) std::unique_lock<std::mutex> elock(E->lock)
@@ -480,12 +487,17 @@ struct DESC {
   std::vector<DESCREC> bookmark2;
   std::vector<DESCREC> records2;
 
+  /* Changes with every modification of the descriptor, so data derived
+     from it can tell that it is outdated */
+  unsigned long long version = 0;
+
   MYERROR error;
   STMT *stmt;
   DBC *dbc;
 
   void free_paramdata();
   void reset();
+  void touch();
   SQLRETURN set_field(SQLSMALLINT recnum, SQLSMALLINT fldid,
                       SQLPOINTER val, SQLINTEGER buflen);
 
@@ -557,11 +569,16 @@ struct STMT_OPTIONS
   SQLUINTEGER     bookmarks = 0;
   void            *bookmark_ptr = nullptr;
   bool            bookmark_insert = false;
+  bool            async_enable = false;
 };
 
 
 /* Environment handler */
 
+/* Maximum number of connections of an environment established at a time
+   for SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE */
+#define MAX_CONNECT_THREADS 64
+
 struct	ENV
 {
   SQLINTEGER   odbc_ver;
@@ -570,6 +587,7 @@ struct	ENV
   std::mutex lock;
   ctpl::thread_pool failover_thread_pool;
   ctpl::thread_pool custom_endpoint_thread_pool;
+  ctpl::thread_pool connect_thread_pool;
 
   ENV(SQLINTEGER ver) : odbc_ver(ver)
   {}
@@ -577,6 +595,7 @@ struct	ENV
   void add_dbc(DBC* dbc);
   void remove_dbc(DBC* dbc);
   bool has_connections();
+  std::future<SQLRETURN> start_connect(std::function<SQLRETURN()> connect);
 
   ~ENV()
   {}
@@ -584,6 +603,33 @@ struct	ENV
 
 static std::atomic_ulong last_dbc_id{ 1 };
 
+/*
+  Recursive mutex of a connection. Unlike std::recursive_mutex, a thread
+  waiting for it can be told to give up, and a thread can check whether it
+  holds it. Used by the READ_AHEAD worker, which must not keep waiting when
+  the application holds the lock while it stops the worker.
+*/
+class DBC_MUTEX
+{
+public:
+  void lock();
+  bool try_lock();
+  void unlock();
+
+  /* Waits for the mutex until cancel is set, returns whether it was locked */
+  bool lock_unless(const std::atomic<bool> &cancel);
+  /* Wakes up the threads waiting in lock_unless() to check cancel */
+  void notify_waiters();
+  /* Whether the calling thread holds the mutex */
+  bool owned_by_this_thread();
+
+private:
+  std::mutex mutex;
+  std::condition_variable released;
+  std::thread::id owner;
+  unsigned int count = 0;
+};
+
 /* Connection handler */
 struct DBC
 {
@@ -606,7 +652,7 @@ struct DBC
   bool             has_query_attrs = false;
   ulong            id;
 
-  std::recursive_mutex lock;
+  DBC_MUTEX        lock;
 
   // Whether SQL*ConnectW was used
   bool          unicode = false;
@@ -620,12 +666,25 @@ struct DBC
   // value of the sql_select_limit currently set for a session
   //   (SQLULEN)(-1) if wasn't set
   SQLULEN       sql_select_limit = -1;
+  // Size of the largest query to send, read on first use, 0 if not read yet
+  unsigned long max_allowed_packet = 0;
   // Connection have been put to the pool
   int           need_to_wakeup = 0;
   bool               transaction_open = false;     // Flag to indicate whether we have a transaction open
+  // Set by SQL_ATTR_ACCESS_MODE
+  bool          read_only = false;
+  // Statement whose asynchronous call has not completed yet
+  STMT          *async_stmt = nullptr;
+  // Set by SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE
+  bool          async_dbc_functions = false;
+  // Connection being established on a worker thread and its data source
+  std::future<SQLRETURN> pending_connect;
+  DataSource    *pending_connect_ds = nullptr;
   fido_callback_func fido_callback = nullptr;
 
   telemetry::Telemetry<DBC> telemetry;
+  // Prepared statement handles released by statements of this connection
+  SSPS_CACHE    ssps_cache;
 
   FAILOVER_HANDLER *fh = nullptr; /* Failover handler */
   std::shared_ptr<CONNECTION_HANDLER> connection_handler = nullptr;
@@ -642,6 +701,8 @@ struct DBC
   void execute_prep_stmt(MYSQL_STMT *pstmt, std::string &query,
     std::vector<MYSQL_BIND> &param_bind, MYSQL_BIND *result_bind);
   void init_proxy_chain(DataSource *dsrc);
+  CONNECTION_PROXY* create_proxy_chain(DataSource *dsrc);
+  SQLRETURN init_connection(DataSource *dsrc, bool allow_async);
   std::shared_ptr<TOPOLOGY_SERVICE> get_topology_service() {
     return this->topology_service ? this->topology_service
                                   : std::make_shared<TOPOLOGY_SERVICE>(this->id, ds ? ds->opt_LOG_QUERY : false);
@@ -655,6 +716,11 @@ struct DBC
     return connection_proxy->get_server_status() & SERVER_STATUS_AUTOCOMMIT;
   }
 
+  // The server reports an open transaction in the status of every OK and EOF packet
+  inline void update_transaction_state() {
+    transaction_open = connection_proxy->get_server_status() & SERVER_STATUS_IN_TRANS;
+  }
+
   void close();
   ~DBC();
 
@@ -664,6 +730,9 @@ struct DBC
     SQLINTEGER errcode);
   SQLRETURN execute_query(const char *query,
     SQLULEN query_length, my_bool req_lock);
+  SQLRETURN execute_query_nonblocking(const char *query,
+    SQLULEN query_length, bool first_call);
+  SQLRETURN handle_query_error(bool server_alive);
 };
 
 
@@ -846,21 +915,96 @@ struct xstring : public std::string
 
 };
 
+/*
+  Storage of rows buffered on the client. Values of all cells are kept
+  back to back in a single arena, each of them terminated with a zero byte,
+  and cells only keep the offset, the length and the NULL flag. Overwritten
+  values are reclaimed by compacting the arena once they take up more than
+  half of it. Invalidating the storage keeps the allocated memory for the
+  next result.
+*/
+#define ROW_STORAGE_MIN_GARBAGE 4096
+
 struct ROW_STORAGE
 {
+  struct CELL
+  {
+    size_t offset = 0;   /* Offset 0 always holds an empty string */
+    size_t length = 0;
+    bool   is_null = false;
+  };
+
+  /* Reference to a cell, values are assigned to it the way they would be
+     assigned to an xstring */
+  class cell_ref
+  {
+    ROW_STORAGE &m_storage;
+    size_t       m_idx;
+
+    template <typename T>
+    void assign(T &&val, std::true_type /* C string */)
+    {
+      const char *str = val;
+      m_storage.set_cell(m_idx, str, str ? strlen(str) : 0);
+    }
+
+    template <typename T>
+    void assign(T &&val, std::false_type /* anything else */)
+    {
+      xstring str(std::forward<T>(val));
+      m_storage.set_cell(m_idx, str.is_null() ? nullptr : str.data(),
+                         str.size());
+    }
+
+    public:
+
+    cell_ref(ROW_STORAGE &storage, size_t idx) :
+      m_storage(storage), m_idx(idx)
+    {}
+
+    cell_ref(const cell_ref &other) = default;
+
+    cell_ref &operator=(const cell_ref &other)
+    {
+      m_storage.copy_cell(m_idx, other.m_idx);
+      return *this;
+    }
+
+    cell_ref &operator=(cell_ref &&other)
+    {
+      m_storage.copy_cell(m_idx, other.m_idx);
+      return *this;
+    }
+
+    template <typename T>
+    cell_ref &operator=(T &&val)
+    {
+      typedef typename std::decay<T>::type type;
+      assign(std::forward<T>(val), std::integral_constant<bool,
+               std::is_convertible<T, const char*>::value &&
+               !std::is_integral<type>::value>());
+      return *this;
+    }
+  };
 
-  typedef std::vector<xstring> vstr;
+  typedef std::vector<CELL> vcell;
   typedef std::vector<const char*> pstr;
   size_t m_rnum = 0, m_cnum = 0, m_cur_row = 0, m_cur_col = 0;
   bool m_eof = true;
 
   /*
-    Data and pointers are in separate containers because for the pointers
+    Cells and pointers are in separate containers because for the pointers
     we will need to get the sequence of pointers returned by vector::data()
   */
-  vstr m_data;
+  std::vector<char> m_arena;
+  /* Bytes of overwritten values, shared bytes may be counted more than once */
+  size_t m_garbage = 0;
+  vcell m_data;
   pstr m_pdata;
 
+  /* Moves the values still in use to the start of the arena */
+  void compact();
+
   /*
     Setting zero for rows or columns makes the storage object invalid
   */
@@ -888,14 +1032,16 @@ struct ROW_STORAGE
   /* Set the row counter to the first row */
   void first_row() { m_cur_row = 0; m_eof = m_rnum == 0; }
 
-  xstring& operator[](size_t idx);
+  cell_ref operator[](size_t idx);
+
+  /* Store the value of the cell, NULL data makes it a NULL value */
+  void set_cell(size_t cell_idx, const char *data, size_t size);
+
+  void copy_cell(size_t dest_idx, size_t src_idx);
 
   void set_data(size_t idx, void *data, size_t size)
   {
-    if (data)
-      m_data[m_cur_row * m_cnum + idx].assign((const char*)data, size);
-    else
-      m_data[m_cur_row * m_cnum + idx] = nullptr;
+    set_cell(m_cur_row * m_cnum + idx, (const char*)data, size);
     m_eof = false;
   }
 
@@ -919,13 +1065,14 @@ struct ROW_STORAGE
 
     for(size_t i = 0; i < m_cnum; ++i)
     {
-      auto &data = m_data[m_cur_row * m_cnum + i];
-      *(bind[i].is_null) = data.is_null();
-      *(bind[i].length) = (unsigned long)(data.is_null() ? -1 : data.length());
-      if (!data.is_null())
+      const CELL &cell = m_data[m_cur_row * m_cnum + i];
+      *(bind[i].is_null) = cell.is_null;
+      *(bind[i].length) = (unsigned long)(cell.is_null ? -1 : cell.length);
+      if (!cell.is_null)
       {
         size_t copy_zero = bind[i].buffer_length > *(bind[i].length) ? 1 : 0;
-        memcpy(bind[i].buffer, data.data(), *(bind[i].length) + copy_zero);
+        memcpy(bind[i].buffer, m_arena.data() + cell.offset,
+               *(bind[i].length) + copy_zero);
       }
     }
     // Set EOF if the last row was filled
@@ -934,7 +1081,7 @@ struct ROW_STORAGE
     m_cur_row += m_eof ? 0 : 1;
   }
 
-  const xstring & operator=(const xstring &val);
+  const ROW_STORAGE & operator=(const xstring &val);
 
   ROW_STORAGE()
   { set_size(0, 0); }
@@ -1017,6 +1164,80 @@ class charPtrBuf {
   }
 };
 
+/* Converts a binary SSPS result column straight into an application C type */
+typedef SQLRETURN (*ssps_converter)(STMT *stmt, MYSQL_BIND *col_rbind,
+                                    SQLPOINTER target, SQLLEN *pcbValue);
+
+/* Precompiled filling of a bound column, see fill_fetch_buffers() */
+struct FETCH_COLUMN_PLAN
+{
+  uint           column;
+  DESCREC       *irrec;
+  DESCREC       *arrec;
+  SQLSMALLINT    c_type;
+  SQLPOINTER     data_ptr;
+  SQLLEN         octet_length;
+  SQLLEN        *octet_length_ptr;
+  /* Distances between rows in the data and length/indicator buffers */
+  SQLLEN         data_stride;
+  SQLLEN         length_stride;
+  bool           pad_space;  /* Value has to go through fix_padding() */
+  ssps_converter convert;    /* Direct conversion of not NULL SSPS values */
+};
+
+/*
+  Plan of filling bound columns on fetch. It is compiled from the ARD and
+  the IRD, and is recompiled when either of them, the result or
+  SQL_ATTR_RETRIEVE_DATA changes.
+*/
+struct FETCH_PLAN
+{
+  DESC              *ard = nullptr;
+  unsigned long long ard_version = 0;
+  unsigned long long ird_version = 0;
+  bool               retrieve_data = false;
+  std::vector<FETCH_COLUMN_PLAN> columns;
+  std::string        padded;  /* Reused by fix_padding() */
+
+  void reset()
+  {
+    ard = nullptr;
+    columns.clear();
+  }
+};
+
+/* Longest wait for the server before a pending asynchronous call is
+   continued by finish_async_call() */
+#define ASYNC_WAIT_TIMEOUT_MS 100
+
+/* Steps of a statement function executed with SQL_ATTR_ASYNC_ENABLE */
+enum ASYNC_STEP { ASYNC_NONE = 0, ASYNC_QUERY, ASYNC_NEXT_RESULT,
+                  ASYNC_STORE_RESULT };
+
+/*
+  Function of the statement that returned SQL_STILL_EXECUTING. The
+  application calls it again until it returns something else, every call
+  continues the pending step without waiting for the server.
+*/
+struct ASYNC_CALL
+{
+  SQLUSMALLINT      function = 0;  /* SQL_API_* of the pending function */
+  ASYNC_STEP        step = ASYNC_NONE;
+  const char        *query = nullptr; /* Kept in send_buf or query */
+  unsigned long     query_length = 0;
+  MYSQL_RES         *result = nullptr; /* Stored result of the last step */
+
+  bool pending() { return step != ASYNC_NONE; }
+
+  void reset()
+  {
+    function = 0;
+    step = ASYNC_NONE;
+    query = nullptr;
+    query_length = 0;
+  }
+};
+
 struct STMT
 {
   DBC               *dbc;
@@ -1029,6 +1250,7 @@ struct STMT
   MYSQL_FIELD	      *fields;
   MYSQL_ROW_OFFSET  end_of_set;
   tempBuf           tempbuf;
+  tempBuf           send_buf;   /* Query being executed, taken from tempbuf */
   ROW_STORAGE       m_row_storage;
 
   MYCURSOR          cursor;
@@ -1066,7 +1288,17 @@ struct STMT
   SQLUSMALLINT setpos_op;
 
   MYSQL_STMT *ssps;
+  /* Key and epoch to return ssps to the connection's cache with, empty key
+     if the handle can't be reused */
+  std::string ssps_cache_key;
+  unsigned long long ssps_cache_epoch = 0;
   MYSQL_BIND *result_bind;
+  /* Converters of result_bind columns and C types they were chosen for */
+  std::vector<std::pair<SQLSMALLINT, ssps_converter>> result_converters;
+  FETCH_PLAN        fetch_plan;
+  ASYNC_CALL        async;
+  /* Reads the rows of a forward-only unbuffered result in the background */
+  std::unique_ptr<READ_AHEAD> read_ahead;
 
   MY_LIMIT_SCROLLER scroller;
 
@@ -1105,6 +1337,7 @@ struct STMT
   void buf_set_pos(size_t pos) { tempbuf.cur_pos = pos; }
   void buf_add_pos(size_t pos) { tempbuf.cur_pos += pos; }
   void buf_remove_trail_zeroes() { tempbuf.remove_trail_zeroes(); }
+  const char* detach_buf(SQLULEN &length);
   void alloc_lengths(size_t num);
   void free_lengths();
   void reset_getdata_position();
@@ -1141,7 +1374,7 @@ struct STMT
 
   STMT(DBC *d) : dbc(d), result(NULL), fake_result(false), array(), result_array(),
     current_values(NULL), fields(NULL), end_of_set(NULL),
-    tempbuf(),
+    tempbuf(), send_buf(0),
     stmt_options(dbc->stmt_options), lengths(nullptr), affected_rows(0),
     current_row(0), cursor_row(0), dae_type(0),
     param_count(0), current_param(0),
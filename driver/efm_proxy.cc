@@ -47,9 +47,19 @@ EFM_PROXY::EFM_PROXY(DBC* dbc, DataSource* ds, CONNECTION_PROXY* next_proxy,
     this->next_proxy = next_proxy;
 }
 
-std::shared_ptr<MONITOR_CONNECTION_CONTEXT> EFM_PROXY::start_monitoring() {
+EFM_PROXY::~EFM_PROXY() {
+    release_monitoring();
+}
+
+void EFM_PROXY::start_monitoring() {
     if (!ds || !ds->opt_ENABLE_FAILURE_DETECTION) {
-        return nullptr;
+        return;
+    }
+
+    // Reuse the context registered by an earlier call unless its monitor has dropped it.
+    if (context != nullptr && context->is_active_context()) {
+        context->arm(std::chrono::steady_clock::now());
+        return;
     }
 
     auto failure_detection_timeout = ds->opt_FAILURE_DETECTION_TIMEOUT;
@@ -58,7 +68,7 @@ std::shared_ptr<MONITOR_CONNECTION_CONTEXT> EFM_PROXY::start_monitoring() {
         failure_detection_timeout = ds->opt_NETWORK_TIMEOUT == 0 ? failure_detection_timeout_default : ds->opt_NETWORK_TIMEOUT;
     }
 
-    return monitor_service->start_monitoring(
+    context = monitor_service->start_monitoring(
         dbc,
         ds,
         node_keys,
@@ -70,17 +80,42 @@ std::shared_ptr<MONITOR_CONNECTION_CONTEXT> EFM_PROXY::start_monitoring() {
         std::chrono::milliseconds{ds->opt_MONITOR_DISPOSAL_TIME});
 }
 
-void EFM_PROXY::stop_monitoring(std::shared_ptr<MONITOR_CONNECTION_CONTEXT> context) {
+void EFM_PROXY::stop_monitoring() {
     if (!ds || !ds->opt_ENABLE_FAILURE_DETECTION || context == nullptr) {
         return;
     }
-    monitor_service->stop_monitoring(context);
+    context->disarm();
     if (context->is_node_unhealthy() && is_connected()) {
         close_socket();
     }
 }
 
+void EFM_PROXY::release_monitoring() {
+    if (context == nullptr) {
+        return;
+    }
+    if (monitor_service != nullptr) {
+        monitor_service->stop_monitoring(context);
+    }
+    context.reset();
+}
+
+// The monitoring of a non-blocking call lasts until the call completes.
+net_async_status EFM_PROXY::monitor_nonblocking(net_async_status status) {
+    nonblocking_pending = status == NET_ASYNC_NOT_READY;
+    if (!nonblocking_pending) {
+        stop_monitoring();
+    }
+    return status;
+}
+
+bool EFM_PROXY::is_unbuffered(MYSQL_RES* result) {
+    return result && result->data == nullptr;
+}
+
 void EFM_PROXY::generate_node_keys() {
+    // The registered context belongs to the previous node keys.
+    release_monitoring();
     node_keys.clear();
     node_keys.insert(std::string(get_host()) + ":" + std::to_string(get_port()));
 
@@ -119,16 +154,16 @@ void EFM_PROXY::set_connection(CONNECTION_PROXY* connection_proxy) {
 }
 
 int EFM_PROXY::set_character_set(const char* csname) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->set_character_set(csname);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 bool EFM_PROXY::change_user(const char* user, const char* passwd, const char* db) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const bool ret = next_proxy->change_user(user, passwd, db);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
@@ -145,58 +180,76 @@ bool EFM_PROXY::real_connect(
 }
 
 int EFM_PROXY::select_db(const char* db) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->select_db(db);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 int EFM_PROXY::query(const char* q) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->query(q);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 int EFM_PROXY::real_query(const char* q, unsigned long length) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->real_query(q, length);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 MYSQL_RES* EFM_PROXY::store_result() {
-    const auto context = start_monitoring();
+    start_monitoring();
     MYSQL_RES* ret = next_proxy->store_result();
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
+net_async_status EFM_PROXY::real_query_nonblocking(const char* q, unsigned long length) {
+    if (!nonblocking_pending) {
+        start_monitoring();
+    }
+    return monitor_nonblocking(next_proxy->real_query_nonblocking(q, length));
+}
+
+net_async_status EFM_PROXY::store_result_nonblocking(MYSQL_RES** result) {
+    if (!nonblocking_pending) {
+        start_monitoring();
+    }
+    return monitor_nonblocking(next_proxy->store_result_nonblocking(result));
+}
+
 MYSQL_RES* EFM_PROXY::use_result() {
-    const auto context = start_monitoring();
+    start_monitoring();
     MYSQL_RES* ret = next_proxy->use_result();
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 int EFM_PROXY::next_result() {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->next_result();
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
+net_async_status EFM_PROXY::next_result_nonblocking() {
+    if (!nonblocking_pending) {
+        start_monitoring();
+    }
+    return monitor_nonblocking(next_proxy->next_result_nonblocking());
+}
+
 bool EFM_PROXY::more_results() {
-    const auto context = start_monitoring();
-    const bool ret = next_proxy->more_results();
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->more_results();
 }
 
 int EFM_PROXY::stmt_next_result(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->stmt_next_result(stmt);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
@@ -212,129 +265,120 @@ bool EFM_PROXY::real_connect_dns_srv(
 }
 
 void EFM_PROXY::free_result(MYSQL_RES* result) {
-    const auto context = start_monitoring();
+    // Freeing an unbuffered result reads its remaining rows from the server.
+    if (!is_unbuffered(result)) {
+        next_proxy->free_result(result);
+        return;
+    }
+
+    start_monitoring();
     next_proxy->free_result(result);
-    stop_monitoring(context);
+    stop_monitoring();
 }
 
 MYSQL_ROW EFM_PROXY::fetch_row(MYSQL_RES* result) {
-    const auto context = start_monitoring();
+    // Rows of a stored result are already in client memory.
+    if (!is_unbuffered(result)) {
+        return next_proxy->fetch_row(result);
+    }
+
+    start_monitoring();
     const MYSQL_ROW ret = next_proxy->fetch_row(result);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 unsigned long EFM_PROXY::real_escape_string(char* to, const char* from, unsigned long length) {
-    const auto context = start_monitoring();
-    const unsigned long ret = next_proxy->real_escape_string(to, from, length);
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->real_escape_string(to, from, length);
 }
 
 bool EFM_PROXY::bind_param(unsigned n_params, MYSQL_BIND* binds, const char** names) {
-    const auto context = start_monitoring();
-    const bool ret = next_proxy->bind_param(n_params, binds, names);
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->bind_param(n_params, binds, names);
 }
 
 MYSQL_STMT* EFM_PROXY::stmt_init() {
-    const auto context = start_monitoring();
-    MYSQL_STMT* ret = next_proxy->stmt_init();
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->stmt_init();
 }
 
 int EFM_PROXY::stmt_prepare(MYSQL_STMT* stmt, const char* query, unsigned long length) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->stmt_prepare(stmt, query, length);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 int EFM_PROXY::stmt_execute(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->stmt_execute(stmt);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 int EFM_PROXY::stmt_fetch(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
+    // Rows of a stored result are already in client memory.
+    if (stmt && stmt->result.data) {
+        return next_proxy->stmt_fetch(stmt);
+    }
+
+    start_monitoring();
     const int ret = next_proxy->stmt_fetch(stmt);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 int EFM_PROXY::stmt_fetch_column(MYSQL_STMT* stmt, MYSQL_BIND* bind_arg, unsigned int column, unsigned long offset) {
-    const auto context = start_monitoring();
-    const int ret = next_proxy->stmt_fetch_column(stmt, bind_arg, column, offset);
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->stmt_fetch_column(stmt, bind_arg, column, offset);
 }
 
 int EFM_PROXY::stmt_store_result(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const int ret = next_proxy->stmt_store_result(stmt);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 bool EFM_PROXY::stmt_bind_named_param(MYSQL_STMT *stmt, MYSQL_BIND *binds,
                                       unsigned n_params, const char **names) {
-  const auto context = start_monitoring();
-  const bool ret =
-      next_proxy->stmt_bind_named_param(stmt, binds, n_params, names);
-  stop_monitoring(context);
-  return ret;
+  return next_proxy->stmt_bind_named_param(stmt, binds, n_params, names);
 }
 
 bool EFM_PROXY::stmt_bind_param(MYSQL_STMT* stmt, MYSQL_BIND* bnd) {
-    const auto context = start_monitoring();
-    const bool ret = next_proxy->stmt_bind_param(stmt, bnd);
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->stmt_bind_param(stmt, bnd);
 }
 
 bool EFM_PROXY::stmt_bind_result(MYSQL_STMT* stmt, MYSQL_BIND* bnd) {
-    const auto context = start_monitoring();
-    const bool ret = next_proxy->stmt_bind_result(stmt, bnd);
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->stmt_bind_result(stmt, bnd);
 }
 
 bool EFM_PROXY::stmt_close(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const bool ret = next_proxy->stmt_close(stmt);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 bool EFM_PROXY::stmt_reset(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const bool ret = next_proxy->stmt_reset(stmt);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 bool EFM_PROXY::stmt_free_result(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const bool ret = next_proxy->stmt_free_result(stmt);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 bool EFM_PROXY::stmt_send_long_data(MYSQL_STMT* stmt, unsigned int param_number, const char* data,
                                     unsigned long length) {
-    const auto context = start_monitoring();
+    start_monitoring();
     const bool ret = next_proxy->stmt_send_long_data(stmt, param_number, data, length);
-    stop_monitoring(context);
+    stop_monitoring();
     return ret;
 }
 
 MYSQL_RES* EFM_PROXY::stmt_result_metadata(MYSQL_STMT* stmt) {
-    const auto context = start_monitoring();
-    MYSQL_RES* ret = next_proxy->stmt_result_metadata(stmt);
-    stop_monitoring(context);
-    return ret;
+    return next_proxy->stmt_result_metadata(stmt);
 }
@@ -39,6 +39,7 @@ public:
     EFM_PROXY(DBC* dbc, DataSource* ds);
     EFM_PROXY(DBC* dbc, DataSource* ds, CONNECTION_PROXY* next_proxy);
     EFM_PROXY(DBC* dbc, DataSource* ds, CONNECTION_PROXY* next_proxy, std::shared_ptr<MONITOR_SERVICE> monitor_service);
+    ~EFM_PROXY() override;
 
     int set_character_set(const char* csname) override;
     bool change_user(const char* user, const char* passwd,
@@ -50,6 +51,8 @@ public:
     int query(const char* q) override;
     int real_query(const char* q, unsigned long length) override;
     MYSQL_RES* store_result() override;
+    net_async_status real_query_nonblocking(const char* q, unsigned long length) override;
+    net_async_status store_result_nonblocking(MYSQL_RES** result) override;
     MYSQL_RES* use_result() override;
     void free_result(MYSQL_RES* result) override;
     MYSQL_ROW fetch_row(MYSQL_RES* result) override;
@@ -77,6 +80,7 @@ public:
                              const char* data, unsigned long length) override;
     MYSQL_RES* stmt_result_metadata(MYSQL_STMT* stmt) override;
     int next_result() override;
+    net_async_status next_result_nonblocking() override;
     bool more_results() override;
     int stmt_next_result(MYSQL_STMT* stmt) override;
     bool real_connect_dns_srv(const char* dns_srv_name,
@@ -89,9 +93,16 @@ public:
 private:
     std::shared_ptr<MONITOR_SERVICE> monitor_service = nullptr;
     std::set<std::string> node_keys;
+    // Registered on the first monitored call and re-armed by later calls.
+    std::shared_ptr<MONITOR_CONNECTION_CONTEXT> context;
+    // Set while a non-blocking call is in progress, so polling does not re-arm the context.
+    bool nonblocking_pending = false;
 
-    std::shared_ptr<MONITOR_CONNECTION_CONTEXT> start_monitoring();
-    void stop_monitoring(std::shared_ptr<MONITOR_CONNECTION_CONTEXT> context);
+    void start_monitoring();
+    void stop_monitoring();
+    void release_monitoring();
+    net_async_status monitor_nonblocking(net_async_status status);
+    static bool is_unbuffered(MYSQL_RES* result);
     void generate_node_keys();
 };
 
@@ -487,6 +487,8 @@ MySQLGetDiagField(SQLSMALLINT handle_type, SQLHANDLE handle, SQLSMALLINT record,
       return SQL_ERROR;
     if (!stmt->result)
       *(SQLLEN *)num_value= 0;
+    else if (stmt->read_ahead)
+      *(SQLLEN *)num_value= (SQLLEN) stmt->read_ahead->num_rows();
     else
       *(SQLLEN *)num_value= (SQLLEN) stmt->dbc->connection_proxy->num_rows(stmt->result);
     return SQL_SUCCESS;
@@ -34,16 +34,251 @@
 */
 
 #include "driver.h"
-#include "driver/query_parsing.h"
 
 #include <locale.h>
 
+/*
+  Adds the max_rows of the statement to a SELECT as a SET_VAR hint, so that
+  the limit does not need a separate SET @@sql_select_limit round trip.
+  The new query is built in the statement buffer.
+  Returns true if the hint was added, false if the limit has to be set for
+  the session instead.
+*/
+bool add_select_limit_hint(STMT *stmt, const char **query,
+                           SQLULEN *query_length)
+{
+  DBC *dbc= stmt->dbc;
+  SQLULEN max_rows= stmt->stmt_options.max_rows;
+
+  /* A limit set for the session would apply together with the hint */
+  if (max_rows == 0 || max_rows == sql_select_unlimited ||
+      (dbc->sql_select_limit != 0 &&
+       dbc->sql_select_limit != sql_select_unlimited))
+  {
+    return false;
+  }
+
+  /* The hint only applies to the first statement of a batch, the scroller
+     adds its own LIMIT and prepared statements are already on the server */
+  if (dbc->ds->opt_MULTI_STATEMENTS || dbc->ds->opt_PREFETCH > 0 ||
+      ssps_used(stmt) || !stmt->query.is_select_statement() ||
+      !is_minimum_version(dbc->connection_proxy->get_server_version(), "8.0.3"))
+  {
+    return false;
+  }
+
+  /* The query starts as the parsed one up to the first parameter */
+  const char *select= stmt->query.get_token(0);
+  if (select == NULL)
+  {
+    return false;
+  }
+
+  size_t select_end= (size_t)(select - GET_QUERY(&stmt->query)) + 6;
+  const char *end= *query + *query_length;
+  if (select_end >= *query_length ||
+      myodbc_casecmp(*query + select_end - 6, "SELECT", 6) != 0)
+  {
+    return false;
+  }
+
+  /* Only one hint comment is allowed after SELECT */
+  const char *pos= *query + select_end;
+  while (pos < end && isspace((unsigned char)*pos))
+  {
+    ++pos;
+  }
+  if (end - pos >= 3 && memcmp(pos, "/*+", 3) == 0)
+  {
+    return false;
+  }
+
+  char hint[64];
+  int hint_length= myodbc_snprintf(hint, sizeof(hint),
+                                   " /*+ SET_VAR(sql_select_limit=%llu) */",
+                                   (unsigned long long)max_rows);
+
+  stmt->buf_set_pos(0);
+  stmt->add_to_buffer(*query, select_end);
+  stmt->add_to_buffer(hint, hint_length);
+  stmt->add_to_buffer(*query + select_end, *query_length - select_end);
+  *query= stmt->detach_buf(*query_length);
+
+  return true;
+}
+
+
+/*
+  Takes the result of the executed query into the statement.
+*/
+static SQLRETURN query_executed(STMT *stmt, int native_error)
+{
+    MYLOG_STMT_TRACE(stmt, "query has been executed");
+
+    if (!native_error)
+    {
+      stmt->dbc->update_transaction_state();
+    }
+
+    if (native_error)
+    {
+      const auto error_code = stmt->dbc->connection_proxy->error_code();
+      if (error_code)
+      {
+          MYLOG_STMT_TRACE(stmt, stmt->dbc->connection_proxy->error());
+          stmt->set_error("HY000");
+
+          // For some errors - translating to more appropriate status
+          translate_error((char*)stmt->error.sqlstate.c_str(), MYERR_S1000, error_code);
+      }
+      else
+      {
+          MYLOG_STMT_TRACE(stmt, stmt->dbc->error.message.c_str());
+          stmt->set_error(stmt->dbc->error.sqlstate.c_str(),
+              stmt->dbc->error.message.c_str(),
+              stmt->dbc->error.native_error);
+      }
+
+      return SQL_ERROR;
+    }
+
+    if (!get_result_metadata(stmt, FALSE))
+    {
+      /* Query was supposed to return result, but result is NULL*/
+      if (returned_result(stmt))
+      {
+        return stmt->set_error(MYERR_S1000);
+      }
+      else /* Query was not supposed to return a result */
+      {
+        stmt->state= ST_EXECUTED;
+        update_affected_rows(stmt);
+
+        /* Cached prepared statements are bound to the previous database,
+           which is also part of their cache keys */
+        if (stmt->query.query_type == myqtUse)
+        {
+          stmt->dbc->ssps_cache.clear(stmt->dbc->connection_proxy);
+          reget_current_catalog(stmt->dbc);
+        }
+
+        // The query without results can end spans here.
+        stmt->telemetry.span_end(stmt);
+        return SQL_SUCCESS;     /* no result set */
+      }
+    }
+
+    if (bind_result(stmt) || get_result(stmt))
+    {
+        return stmt->set_error(MYERR_S1000);
+    }
+    /* Caching row counts for queries returning resultset as well */
+    //update_affected_rows(stmt);
+    fix_result_types(stmt);
+
+    /* If the only resultset is OUT params, then we can only detect
+       corresponding server_status right after execution.
+       If the RS is OUT params - we do not need to do store_result obviously */
+    if (IS_PS_OUT_PARAMS(stmt))
+    {
+      /* This status(SERVER_PS_OUT_PARAMS) can be only if we used PS */
+      ssps_get_out_params(stmt);
+
+      if (stmt->out_params_state == OPS_STREAMS_PENDING)
+      {
+        return SQL_PARAM_DATA_AVAILABLE;
+      }
+    }
+
+    return SQL_SUCCESS;
+}
+
+
+/*
+  Ends the execution of a query with its result code, the failover is
+  triggered if the connection was lost.
+*/
+static SQLRETURN end_query(STMT *stmt, SQLRETURN error,
+                           bool trigger_failover_upon_error)
+{
+    if (!SQL_SUCCEEDED(error)) {
+      stmt->telemetry.set_error(stmt, stmt->error.message);
+    }
+
+    if (trigger_failover_upon_error && error == SQL_ERROR) {
+      const char *error_code, *error_msg;
+      if (stmt->dbc->fh->trigger_failover_if_needed(stmt->error.sqlstate.c_str(), error_code, error_msg))
+        stmt->set_error(error_code, error_msg, 0);
+    }
+
+    /*
+      If the original query was modified, we reset stmt->query so that the
+      next execution re-starts with the original query.
+    */
+    if (GET_QUERY(&stmt->orig_query))
+    {
+      stmt->query = stmt->orig_query;
+      stmt->orig_query.reset(NULL, NULL, NULL);
+    }
+
+    return error;
+}
+
+
+/*
+  Continues the query started by do_query() for SQL_ATTR_ASYNC_ENABLE.
+  Returns SQL_STILL_EXECUTING until the server has sent the whole result,
+  then ends the query as do_query() does.
+*/
+static SQLRETURN continue_async_query(STMT *stmt, bool first_call)
+{
+    int native_error = 0;
+    bool trigger_failover_upon_error = true;
+
+    if (stmt->async.step == ASYNC_QUERY)
+    {
+      SQLRETURN rc = stmt->dbc->execute_query_nonblocking(stmt->async.query,
+                       stmt->async.query_length, first_call);
+      if (rc == SQL_STILL_EXECUTING)
+      {
+        return rc;
+      }
+
+      if (!SQL_SUCCEEDED(rc))
+      {
+          native_error = stmt->dbc->error.native_error;
+          trigger_failover_upon_error = false; // possible failover was already handled in execute_query_nonblocking()
+      }
+    }
+
+    if (!native_error)
+    {
+      net_async_status status = store_result_nonblocking(stmt);
+      if (status == NET_ASYNC_NOT_READY)
+      {
+        return SQL_STILL_EXECUTING;
+      }
+
+      if (status == NET_ASYNC_ERROR)
+      {
+        native_error = stmt->dbc->connection_proxy->error_code();
+      }
+    }
+
+    stmt->async.reset();
+    stmt->dbc->async_stmt = nullptr;
+
+    return end_query(stmt, query_executed(stmt, native_error),
+                     trigger_failover_upon_error);
+}
+
+
 /*
   @type    : myodbc3 internal
   @purpose : internal function to execute query and return result
   frees query if query != stmt->query
 */
-SQLRETURN do_query(STMT *stmt, std::string query)
+SQLRETURN do_query(STMT *stmt, const char *query, SQLULEN query_length)
 {
     if (stmt && stmt->dbc && stmt->dbc->fh) {
       stmt->dbc->fh->invoke_start_time();
@@ -53,19 +288,25 @@ SQLRETURN do_query(STMT *stmt, std::string query)
 
     SQLRETURN error = SQL_ERROR;
     int native_error = 0;
-    SQLULEN query_length = query.length();
     bool trigger_failover_upon_error = true;
 
     LOCK_STMT_DEFER(stmt);
 
-    if (query.empty())
+    if (query == NULL || *query == '\0')
     {
       /* Probably error from insert_param */
       goto exit;
     }
 
-    if(!SQL_SUCCEEDED(set_sql_select_limit(stmt->dbc,
-                      stmt->stmt_options.max_rows, TRUE)))
+    if (query_length == 0)
+    {
+      query_length= strlen(query);
+    }
+
+    /* A SELECT carries its row limit, other statements need it set for the session */
+    if (!add_select_limit_hint(stmt, &query, &query_length) &&
+        !SQL_SUCCEEDED(set_sql_select_limit(stmt->dbc,
+                       stmt->stmt_options.max_rows, TRUE)))
     {
       /* The error is set for DBC, copy it into STMT */
       stmt->set_error(stmt->dbc->error.sqlstate.c_str(),
@@ -76,14 +317,17 @@ SQLRETURN do_query(STMT *stmt, std::string query)
       goto exit;
     }
 
-    if (query_length == 0)
+    MYLOG_STMT_TRACE(stmt, query);
+    DO_LOCK_STMT();
+
+    /* The connection still reads the response to another statement */
+    if (stmt->dbc->async_stmt && stmt->dbc->async_stmt != stmt)
     {
-      query_length= strlen(query.c_str());
+      stmt->set_error(MYERR_S1010, "Another statement of the connection "
+                      "is still executing asynchronously", 0);
+      goto exit;
     }
 
-    MYLOG_STMT_TRACE(stmt, query.c_str());
-    DO_LOCK_STMT();
-
     if ( !is_server_alive( stmt->dbc ) )
     {
       stmt->set_error("08S01" /* "HYT00" */,
@@ -102,7 +346,7 @@ SQLRETURN do_query(STMT *stmt, std::string query)
     if (stmt->dbc->ds->opt_PREFETCH > 0
         && !stmt->dbc->ds->opt_MULTI_STATEMENTS
         && stmt->stmt_options.cursor_type == SQL_CURSOR_FORWARD_ONLY
-        && scrollable(stmt, query.c_str(), query.c_str() + query_length)
+        && scrollable(stmt, query, query + query_length)
         && !ssps_used(stmt))
     {
       /* we might want to read primary key info at this point, but then we have to
@@ -116,7 +360,7 @@ SQLRETURN do_query(STMT *stmt, std::string query)
                                       stmt->ard->array_size,
                                       stmt->stmt_options.max_rows);
 
-      scroller_create(stmt, query.c_str(), query_length);
+      scroller_create(stmt, query, query_length);
       scroller_move(stmt);
       MYLOG_STMT_TRACE(stmt, stmt->scroller.query);
 
@@ -195,126 +439,29 @@ SQLRETURN do_query(STMT *stmt, std::string query)
         goto exit;
       }
 
-      SQLRETURN rc = stmt->dbc->execute_query(query.c_str(), query_length, false);
-      if (SQL_SUCCEEDED(rc))
+      if (stmt->async.function)
       {
-          const std::vector<std::string> statements = parse_query_into_statements(query.c_str());
-          for (int i = statements.size() - 1; i >= 0; i--)
-          {
-              std::string statement = statements[i];
-              for (auto& c : statement) c = toupper(c);
+        /* The query stays in send_buf or stmt->query until it completes */
+        stmt->async.query = query;
+        stmt->async.query_length = (unsigned long)query_length;
+        stmt->async.step = ASYNC_QUERY;
+        stmt->dbc->async_stmt = stmt;
 
-              if (statement == "START TRANSACTION" || statement == "BEGIN")
-              {
-                  stmt->dbc->transaction_open = true;
-                  break;
-              }
-              else if (statement == "COMMIT" || statement == "ROLLBACK")
-              {
-                  stmt->dbc->transaction_open = false;
-                  break;
-              }
-          }
+        return continue_async_query(stmt, true);
       }
-      else
+
+      SQLRETURN rc = stmt->dbc->execute_query(query, query_length, false);
+      if (!SQL_SUCCEEDED(rc))
       {
           native_error = stmt->dbc->error.native_error;
           trigger_failover_upon_error = false; // possible failover was already handled in execute_query()
       }
     }
 
-    MYLOG_STMT_TRACE(stmt, "query has been executed");
-
-    if (native_error)
-    {
-      const auto error_code = stmt->dbc->connection_proxy->error_code();
-      if (error_code)
-      {
-          MYLOG_STMT_TRACE(stmt, stmt->dbc->connection_proxy->error());
-          stmt->set_error("HY000");
-
-          // For some errors - translating to more appropriate status
-          translate_error((char*)stmt->error.sqlstate.c_str(), MYERR_S1000, error_code);
-      }
-      else
-      {
-          MYLOG_STMT_TRACE(stmt, stmt->dbc->error.message.c_str());
-          stmt->set_error(stmt->dbc->error.sqlstate.c_str(),
-              stmt->dbc->error.message.c_str(),
-              stmt->dbc->error.native_error);
-      }
-
-      goto exit;
-    }
-
-    if (!get_result_metadata(stmt, FALSE))
-    {
-      /* Query was supposed to return result, but result is NULL*/
-      if (returned_result(stmt))
-      {
-        error = stmt->set_error(MYERR_S1000);
-        goto exit;
-      }
-      else /* Query was not supposed to return a result */
-      {
-        error= SQL_SUCCESS;     /* no result set */
-        stmt->state= ST_EXECUTED;
-        update_affected_rows(stmt);
-        // The query without results can end spans here.
-        stmt->telemetry.span_end(stmt);
-        goto exit;
-      }
-    }
-
-    if (bind_result(stmt) || get_result(stmt))
-    {
-        error = stmt->set_error(MYERR_S1000);
-        goto exit;
-    }
-    /* Caching row counts for queries returning resultset as well */
-    //update_affected_rows(stmt);
-    fix_result_types(stmt);
-
-    /* If the only resultset is OUT params, then we can only detect
-       corresponding server_status right after execution.
-       If the RS is OUT params - we do not need to do store_result obviously */
-    if (IS_PS_OUT_PARAMS(stmt))
-    {
-      /* This status(SERVER_PS_OUT_PARAMS) can be only if we used PS */
-      ssps_get_out_params(stmt);
-
-      if (stmt->out_params_state == OPS_STREAMS_PENDING)
-      {
-        error= SQL_PARAM_DATA_AVAILABLE;
-        goto exit;
-      }
-    }
-
-
-    error= SQL_SUCCESS;
+    error = query_executed(stmt, native_error);
 
 exit:
-    if (!SQL_SUCCEEDED(error)) {
-      stmt->telemetry.set_error(stmt, stmt->error.message);
-    }
-
-    if (trigger_failover_upon_error && error == SQL_ERROR) {
-      const char *error_code, *error_msg;
-      if (stmt->dbc->fh->trigger_failover_if_needed(stmt->error.sqlstate.c_str(), error_code, error_msg))
-        stmt->set_error(error_code, error_msg, 0);
-    }
-
-    /*
-      If the original query was modified, we reset stmt->query so that the
-      next execution re-starts with the original query.
-    */
-    if (GET_QUERY(&stmt->orig_query))
-    {
-      stmt->query = stmt->orig_query;
-      stmt->orig_query.reset(NULL, NULL, NULL);
-    }
-
-    return error;
+    return end_query(stmt, error, trigger_failover_upon_error);
 }
 
 /*
@@ -322,17 +469,20 @@ exit:
   @purpose : insert sql params at parameter positions
   @param[in]      stmt        Statement
   @param[in]      row         Parameters row
-  @param[in,out]  finalquery  if NULL, final query is not copied
-  @param[in,out]  length      Length of the query. Pointed value is used as initial offset
-  @comment : it allocates and modifies finalquery (when finalquery!=NULL),
-             so passing stmt->query->query can lead to memory leak.
+  @param[out]     finalquery  if NULL, the query stays in the statement buffer
+                              to be continued
+  @param[out]     length      Length of the final query
+  @comment : the final query is not copied, it points to stmt->send_buf and
+             stays valid until the next query is detached from the buffer.
 */
 
-SQLRETURN insert_params(STMT *stmt, SQLULEN row, std::string &finalquery)
+SQLRETURN insert_params(STMT *stmt, SQLULEN row, const char **finalquery,
+                        SQLULEN *length)
 {
   assert(stmt);
   const char *query= GET_QUERY(&stmt->query);
-  uint i,length, had_info= 0;
+  uint i, had_info= 0;
+  size_t fragment_length;
   SQLRETURN rc= SQL_SUCCESS;
 
   LOCK_DBC(stmt->dbc);
@@ -366,9 +516,9 @@ SQLRETURN insert_params(STMT *stmt, SQLULEN row, std::string &finalquery)
     else
     {
       pos = stmt->query.get_param_pos(i);
-      length= (uint) (pos-query);
+      fragment_length= (size_t) (pos-query);
 
-      if (stmt->add_to_buffer(query, length) == NULL)
+      if (stmt->add_to_buffer(query, fragment_length) == NULL)
       {
         goto memerror;
       }
@@ -401,14 +551,17 @@ SQLRETURN insert_params(STMT *stmt, SQLULEN row, std::string &finalquery)
 
   if (!ssps_used(stmt))
   {
-    length= (uint) (GET_QUERY_END(&stmt->query) - query);
+    fragment_length= (size_t) (GET_QUERY_END(&stmt->query) - query);
 
-    if (stmt->add_to_buffer(query, length) == NULL)
+    if (stmt->add_to_buffer(query, fragment_length) == NULL)
     {
       goto memerror;
     }
 
-    finalquery = std::string(stmt->buf(), stmt->buf_pos());
+    if (finalquery != NULL)
+    {
+      *finalquery= stmt->detach_buf(*length);
+    }
   }
 
   return rc;
@@ -1378,7 +1531,116 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt)
 {
   LOCK_STMT(hstmt);
 
-  return my_SQLExecute((STMT *)hstmt);
+  return my_SQLExecuteAsync((STMT *)hstmt, SQL_API_SQLEXECUTE);
+}
+
+
+/*
+  Executes the statement for SQLExecute() or SQLExecDirect(), or continues
+  the execution that returned SQL_STILL_EXECUTING. With SQL_ATTR_ASYNC_ENABLE
+  a single set of parameters executed directly does not wait for the server,
+  other executions complete within the call.
+*/
+SQLRETURN my_SQLExecuteAsync(STMT *stmt, SQLUSMALLINT function)
+{
+  if (stmt->async.pending())
+  {
+    if (stmt->async.function != function)
+    {
+      return stmt->set_error(MYERR_S1010, NULL, 0);
+    }
+
+    LOCK_DBC(stmt->dbc);
+    SQLRETURN rc = continue_async_query(stmt, false);
+    if (rc == SQL_STILL_EXECUTING)
+    {
+      return rc;
+    }
+
+    /* What my_SQLExecute() does after executing a single set of parameters */
+    if (is_connection_lost(stmt->error.native_error))
+    {
+      handle_connection_error(stmt);
+    }
+
+    if (map_error_to_param_status(stmt->ipd->array_status_ptr, rc))
+    {
+      *stmt->ipd->array_status_ptr= SQL_PARAM_ERROR;
+    }
+
+    if (stmt->dummy_state == ST_DUMMY_PREPARED)
+      stmt->dummy_state= ST_DUMMY_EXECUTED;
+
+    return rc;
+  }
+
+  if (stmt->stmt_options.async_enable && stmt->apd->array_size <= 1)
+  {
+    stmt->async.function = function;
+  }
+
+  SQLRETURN rc = my_SQLExecute(stmt);
+
+  if (!stmt->async.pending())
+  {
+    stmt->async.function = 0;
+  }
+
+  return rc;
+}
+
+
+/*
+  Completes the pending asynchronous call of the statement, so that the
+  connection can be used again, and discards its result.
+*/
+void finish_async_call(STMT *stmt)
+{
+  LOCK_DBC(stmt->dbc);
+  CONNECTION_PROXY *proxy = stmt->dbc->connection_proxy;
+  net_async_status status;
+
+  while (stmt->async.pending())
+  {
+    switch (stmt->async.step)
+    {
+      case ASYNC_QUERY:
+        status = proxy->real_query_nonblocking(stmt->async.query,
+                                               stmt->async.query_length);
+        break;
+      case ASYNC_NEXT_RESULT:
+        status = proxy->next_result_nonblocking();
+        break;
+      default:
+        status = proxy->store_result_nonblocking(&stmt->async.result);
+        break;
+    }
+
+    if (status == NET_ASYNC_NOT_READY)
+    {
+      proxy->wait_for_response(ASYNC_WAIT_TIMEOUT_MS);
+      continue;
+    }
+
+    /* The rows of the result still have to be read */
+    if (status == NET_ASYNC_COMPLETE && stmt->async.step != ASYNC_STORE_RESULT &&
+        proxy->field_count())
+    {
+      stmt->async.step = ASYNC_STORE_RESULT;
+      continue;
+    }
+
+    break;
+  }
+
+  proxy->free_result(stmt->async.result);
+  stmt->async.result = nullptr;
+  stmt->async.reset();
+
+  if (stmt->dbc->async_stmt == stmt)
+  {
+    stmt->dbc->async_stmt = nullptr;
+  }
 }
 
 
@@ -1407,6 +1669,340 @@ BOOL map_error_to_param_status( SQLUSMALLINT *param_status_ptr, SQLRETURN rc)
 }
 
 
+/*
+  @type    : myodbc3 internal
+  @purpose : locates the row constructor of an "INSERT ... VALUES (...)"
+             statement, i.e. the parenthesized list following VALUES
+  @return  : TRUE if found and all parameter markers are inside of it, so
+             the constructor can be repeated once per set of parameters
+*/
+
+static BOOL find_insert_values_row(STMT *stmt, const char **begin,
+                                   const char **end)
+{
+  static const MY_STRING values_= {"VALUES", 6, 6};
+  static const MY_STRING value_=  {"VALUE" , 5, 5};
+  MY_PARSED_QUERY *pq= &stmt->query;
+  MY_PARSER        parser;
+  uint             i, depth= 0;
+
+  *begin= *end= NULL;
+
+  if (pq->query_type != myqtInsert || IS_BATCH(pq) || !stmt->param_count
+   || PARAM_COUNT(*pq) != stmt->param_count)
+  {
+    return FALSE;
+  }
+
+  for (i= 1; i < pq->token_count() && *begin == NULL; ++i)
+  {
+    const char *pos= pq->get_token(i);
+
+    if (case_compare(pq, pos, &values_))
+      pos+= values_.bytes;
+    else if (case_compare(pq, pos, &value_))
+      pos+= value_.bytes;
+    else
+      continue;
+
+    /* Column named "value" or alike - looking further */
+    while (pos < GET_QUERY_END(pq) && isspace(*pos))
+      ++pos;
+
+    if (pos < GET_QUERY_END(pq) && *pos == '(')
+      *begin= pos;
+  }
+
+  if (*begin == NULL)
+  {
+    return FALSE;
+  }
+
+  init_parser(&parser, pq);
+  parser.pos= *begin;
+  get_ctype(&parser);
+
+  while (END_NOT_REACHED(&parser))
+  {
+    if (open_quote(&parser, is_quote(&parser)))
+    {
+      step_char(&parser);
+      find_closing_quote(&parser);
+      CLOSE_QUOTE(&parser);
+      /* find_closing_quote puts cursor after the closing quote */
+      continue;
+    }
+
+    /* Not worth the trouble */
+    if (is_comment(&parser))
+    {
+      return FALSE;
+    }
+
+    if (parser.bytes_at_pos == 1)
+    {
+      if (*parser.pos == '(')
+      {
+        ++depth;
+      }
+      else if (*parser.pos == ')' && --depth == 0)
+      {
+        *end= parser.pos + 1;
+        break;
+      }
+    }
+
+    step_char(&parser);
+  }
+
+  if (*end == NULL)
+  {
+    return FALSE;
+  }
+
+  for (i= 0; i < stmt->param_count; ++i)
+  {
+    const char *pos= pq->get_param_pos(i);
+
+    if (pos < *begin || pos >= *end)
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+
+/*
+  @type    : myodbc3 internal
+  @purpose : appends the part of the query between begin and end to the
+             statement buffer, inserting values of the parameters found there
+  @comment : non-ssps counterpart of insert_params() for a query fragment
+*/
+
+static SQLRETURN insert_params_fragment(STMT *stmt, SQLULEN row,
+                                        const char *begin, const char *end)
+{
+  const char *query= begin;
+  uint        i, had_info= 0;
+  SQLRETURN   rc= SQL_SUCCESS;
+
+  for (i= 0; i < stmt->param_count; ++i)
+  {
+    DESCREC    *aprec= desc_get_rec(stmt->apd, i, FALSE);
+    DESCREC    *iprec= desc_get_rec(stmt->ipd, i, FALSE);
+    const char *pos= stmt->query.get_param_pos(i);
+
+    if (stmt->dummy_state != ST_DUMMY_PREPARED &&
+        (!aprec || !aprec->par.real_param_done))
+    {
+      return stmt->set_error(MYERR_07001,
+          "The number of parameter markers is not equal "
+          "to the number of parameters provided", 0);
+    }
+
+    assert(iprec);
+
+    if (stmt->add_to_buffer(query, (uint)(pos - query)) == NULL)
+    {
+      return stmt->set_error(MYERR_S1001, NULL, 4001);
+    }
+
+    query= pos + 1;  /* Skip '?' */
+
+    rc= insert_param(stmt, NULL, stmt->apd, aprec, iprec, row);
+
+    if (!SQL_SUCCEEDED(rc))
+    {
+      return rc;
+    }
+    else if (rc == SQL_SUCCESS_WITH_INFO)
+    {
+      had_info= 1;
+    }
+  }
+
+  if (stmt->add_to_buffer(query, (uint)(end - query)) == NULL)
+  {
+    return stmt->set_error(MYERR_S1001, NULL, 4001);
+  }
+
+  return had_info ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+}
+
+
+/*
+  @type    : myodbc3 internal
+  @purpose : executes an array of paramsets of an INSERT statement as a few
+             multi-row "INSERT ... VALUES (...),(...)" queries, each of them
+             fitting into max_allowed_packet of the server
+  @comment : a query is executed as a whole, thus if it fails, all paramsets
+             it was built of get the error status
+*/
+
+static SQLRETURN execute_insert_batches(STMT *stmt,
+                                        const char *values_begin,
+                                        const char *values_end,
+                                        SQLUSMALLINT **last_error,
+                                        int *one_of_params_not_succeded,
+                                        int *all_parameters_failed)
+{
+  const char   *query= GET_QUERY(&stmt->query);
+  const char   *query_end= GET_QUERY_END(&stmt->query);
+  const size_t  prefix_length= values_begin - query;
+  const size_t  suffix_length= query_end - values_end;
+  /* The command byte is sent in the same packet as the query */
+  const size_t  max_packet= get_max_allowed_packet(stmt) - 1;
+  /* Paramsets in the query being built and results of their conversion */
+  std::vector<std::pair<SQLULEN, SQLRETURN>> batch;
+  SQLUSMALLINT *param_operation_ptr, *param_status_ptr;
+  SQLRETURN     rc= SQL_SUCCESS;
+  char         *separator;
+  bool          connection_failure= false;
+  SQLULEN       row= 0;
+
+  /* Values are interpolated into the query text */
+  ssps_close(stmt);
+
+  while (row < stmt->apd->array_size || !batch.empty())
+  {
+    if (row < stmt->apd->array_size)
+    {
+      size_t row_start;
+
+      param_operation_ptr= (SQLUSMALLINT*)ptr_offset_adjust(stmt->apd->array_status_ptr,
+                                            NULL,
+                                            0/*SQL_BIND_BY_COLUMN*/,
+                                            sizeof(SQLUSMALLINT), row);
+      param_status_ptr= (SQLUSMALLINT*)ptr_offset_adjust(stmt->ipd->array_status_ptr,
+                                            NULL,
+                                            0/*SQL_BIND_BY_COLUMN*/,
+                                            sizeof(SQLUSMALLINT), row);
+
+      if (param_operation_ptr
+        && *param_operation_ptr == SQL_PARAM_IGNORE)
+      {
+        if (param_status_ptr)
+          *param_status_ptr= SQL_PARAM_UNUSED;
+
+        if (stmt->ipd->rows_processed_ptr)
+          *stmt->ipd->rows_processed_ptr+= 1;
+
+        ++row;
+        continue;
+      }
+
+      if (batch.empty())
+      {
+        stmt->buf_set_pos(0);
+        row_start= 0;
+        separator= stmt->add_to_buffer(query, prefix_length);
+      }
+      else
+      {
+        row_start= stmt->buf_pos();
+        separator= stmt->add_to_buffer(",", 1);
+      }
+
+      if (separator == NULL)
+      {
+        rc= stmt->set_error(MYERR_S1001, NULL, 4001);
+      }
+      else
+      {
+        rc= insert_params_fragment(stmt, row, values_begin, values_end);
+      }
+
+      if (!SQL_SUCCEEDED(rc))
+      {
+        /* Only this paramset failed, dropping it from the query */
+        stmt->buf_set_pos(row_start);
+
+        if (map_error_to_param_status(param_status_ptr, rc))
+        {
+          *last_error= param_status_ptr;
+        }
+        *one_of_params_not_succeded= 1;
+
+        if (stmt->ipd->rows_processed_ptr)
+          *stmt->ipd->rows_processed_ptr+= 1;
+
+        ++row;
+        continue;
+      }
+
+      /* A single paramset is sent even if it does not fit */
+      if (batch.empty() || stmt->buf_pos() + suffix_length <= max_packet)
+      {
+        batch.push_back(std::make_pair(row, rc));
+
+        if (stmt->ipd->rows_processed_ptr)
+          *stmt->ipd->rows_processed_ptr+= 1;
+
+        ++row;
+        continue;
+      }
+
+      /* Does not fit - it goes to the next query */
+      stmt->buf_set_pos(row_start);
+    }
+
+    if (stmt->add_to_buffer(values_end, suffix_length) == NULL)
+    {
+      rc= stmt->set_error(MYERR_S1001, NULL, 4001);
+    }
+    else if (!connection_failure)
+    {
+      SQLULEN batch_length;
+      const char *batch_query= stmt->detach_buf(batch_length);
+      rc= do_query(stmt, batch_query, batch_length);
+    }
+    else
+    {
+      /* with broken connection we always return error for all next queries */
+      rc= SQL_ERROR;
+    }
+    stmt->buf_set_pos(0);
+
+    if (is_connection_lost(stmt->error.native_error)
+      && handle_connection_error(stmt))
+    {
+      connection_failure= true;
+    }
+
+    for (auto &paramset : batch)
+    {
+      SQLRETURN paramset_rc= rc == SQL_SUCCESS ? paramset.second : rc;
+
+      param_status_ptr= (SQLUSMALLINT*)ptr_offset_adjust(stmt->ipd->array_status_ptr,
+                                            NULL,
+                                            0/*SQL_BIND_BY_COLUMN*/,
+                                            sizeof(SQLUSMALLINT), paramset.first);
+
+      if (map_error_to_param_status(param_status_ptr, paramset_rc))
+      {
+        *last_error= param_status_ptr;
+      }
+
+      if (paramset_rc != SQL_SUCCESS)
+      {
+        *one_of_params_not_succeded= 1;
+      }
+    }
+
+    if (SQL_SUCCEEDED(rc))
+    {
+      *all_parameters_failed= 0;
+    }
+
+    batch.clear();
+  }
+
+  return rc;
+}
+
+
 /*
   @type    : myodbc3 internal
   @purpose : executes a prepared statement, using the current values
@@ -1416,7 +2012,8 @@ BOOL map_error_to_param_status( SQLUSMALLINT *param_status_ptr, SQLRETURN rc)
 
 SQLRETURN my_SQLExecute( STMT *pStmt )
 {
-  std::string query;
+  const char *query;
+  SQLULEN     query_length;
   char *cursor_pos;
   int         dae_rec, one_of_params_not_succeded= 0;
   bool is_select_stmt;
@@ -1424,6 +2021,7 @@ SQLRETURN my_SQLExecute( STMT *pStmt )
   STMT       *pStmtCursor = pStmt;
   SQLRETURN   rc = 0;
   SQLULEN     row, length= 0;
+  const char *values_begin, *values_end;
 
   SQLUSMALLINT *param_operation_ptr= NULL, *param_status_ptr= NULL, *lastError= NULL;
 
@@ -1496,6 +2094,7 @@ SQLRETURN my_SQLExecute( STMT *pStmt )
     my_SQLFreeStmt((SQLHSTMT)pStmt,FREE_STMT_RESET_BUFFERS);
 
     query= GET_QUERY(&pStmt->query);
+    query_length= GET_QUERY_LENGTH(&pStmt->query);
 
     is_select_stmt = pStmt->query.is_select_statement();
 
@@ -1514,7 +2113,21 @@ SQLRETURN my_SQLExecute( STMT *pStmt )
 
     LOCK_DBC(pStmt->dbc);
 
-    for (row= 0; row < pStmt->apd->array_size; ++row)
+    row= 0;
+
+    if (!is_select_stmt && pStmt->apd->array_size > 1
+      && pStmt->dbc->ds->opt_ENABLE_BATCH_INSERTS
+      && desc_find_dae_rec(pStmt->apd) < 0
+      && find_insert_values_row(pStmt, &values_begin, &values_end))
+    {
+      rc= execute_insert_batches(pStmt, values_begin, values_end, &lastError,
+                                 &one_of_params_not_succeded,
+                                 &all_parameters_failed);
+      /* All paramsets have been processed */
+      row= pStmt->apd->array_size;
+    }
+
+    for (; row < pStmt->apd->array_size; ++row)
     {
       if ( pStmt->param_count )
       {
@@ -1577,17 +2190,16 @@ SQLRETURN my_SQLExecute( STMT *pStmt )
           return SQL_NEED_DATA;
         }
 
-        /* Making copy of the built query if that is not last paramset for select
-          query. */
+        /* For a SELECT only the last paramset completes the query, which is
+          then taken from the statement buffer. */
         if (is_select_stmt && row < pStmt->apd->array_size - 1)
         {
-          // Just ignore the dummy query
-          std::string dummy;
-          rc= insert_params(pStmt, row, dummy);
+          // The query is continued with the next paramset
+          rc= insert_params(pStmt, row, NULL, NULL);
         }
         else
         {
-          rc= insert_params(pStmt, row, query);
+          rc= insert_params(pStmt, row, &query, &query_length);
         }
 
         /* Setting status for this paramset*/
@@ -1625,7 +2237,13 @@ SQLRETURN my_SQLExecute( STMT *pStmt )
       {
         if (!connection_failure)
         {
-          rc = do_query(pStmt, query);
+          rc = do_query(pStmt, query, query_length);
+
+          /* Continued by my_SQLExecuteAsync() */
+          if (rc == SQL_STILL_EXECUTING)
+          {
+            return rc;
+          }
         }
         else
         {
@@ -1787,15 +2405,15 @@ static SQLRETURN find_next_dae_param(STMT *stmt,  SQLPOINTER *token)
 static SQLRETURN execute_dae(STMT *stmt)
 {
   SQLRETURN rc;
-  std::string query;
+  const char *query;
+  SQLULEN query_length;
 
   switch (stmt->dae_type)
   {
   case DAE_NORMAL:
-    query = GET_QUERY(&stmt->query);
-    if (!SQL_SUCCEEDED(rc= insert_params(stmt, 0, query)))
+    if (!SQL_SUCCEEDED(rc= insert_params(stmt, 0, &query, &query_length)))
       break;
-    rc= do_query(stmt, query);
+    rc= do_query(stmt, query, query_length);
     break;
   case DAE_SETPOS_INSERT:
     stmt->dae_type= DAE_SETPOS_DONE;
@@ -32,11 +32,17 @@
 
 #include "connection_handler.h"
 #include "connection_proxy.h"
+#include "standby_connections.h"
+#include "topology_monitor.h"
 #include "topology_service.h"
 #include "mylog.h"
 
+#include <chrono>
 #include <condition_variable>
 
+// First wait between polls of a writer failover task, right after the failure
+#define FAILOVER_INITIAL_POLL_INTERVAL_MS 100
+
 struct READER_FAILOVER_RESULT {
     bool connected = false;
     std::shared_ptr<HOST_INFO> new_host;
@@ -59,6 +65,8 @@ class FAILOVER_SYNC {
     void increment_task();
     void mark_as_complete(bool cancel_other_tasks);
     void wait_and_complete(int milliseconds);
+    // Returns true if completed before the time elapsed
+    bool wait_for_completion(int milliseconds);
     virtual bool is_completed();
 
    private:
@@ -67,6 +75,25 @@ class FAILOVER_SYNC {
     std::condition_variable cv;
 };
 
+// FAILOVER_POLL_SCHEDULE paces the polls of a writer failover task. Polling starts
+// tight right after the failure and backs off exponentially up to the configured
+// interval, never waiting past the failover deadline.
+class FAILOVER_POLL_SCHEDULE {
+   public:
+    FAILOVER_POLL_SCHEDULE(int max_interval_ms,
+                           std::chrono::steady_clock::time_point deadline,
+                           int initial_interval_ms = FAILOVER_INITIAL_POLL_INTERVAL_MS);
+    // Returns the time to wait before the next poll, 0 once the deadline has passed
+    int next_interval_ms();
+    std::vector<int> get_intervals();
+
+   private:
+    int interval_ms;
+    int max_interval_ms;
+    std::chrono::steady_clock::time_point deadline;
+    std::vector<int> intervals;
+};
+
 class FAILOVER_READER_HANDLER {
    public:
     FAILOVER_READER_HANDLER(
@@ -75,7 +102,9 @@ class FAILOVER_READER_HANDLER {
         ctpl::thread_pool& thread_pool,
         int failover_timeout_ms, int failover_reader_connect_timeout,
         bool enable_strict_reader_failover,
-        unsigned long dbc_id, bool enable_logging = false);
+        unsigned long dbc_id, bool enable_logging = false,
+        int reader_fanout = DEFAULT_FAILOVER_READER_FANOUT,
+        int reader_connect_stagger_ms = 0);
     
         ~FAILOVER_READER_HANDLER();
     
@@ -97,6 +126,8 @@ class FAILOVER_READER_HANDLER {
     protected:
         int reader_connect_timeout_ms = 30000;   // 30 sec
         int max_failover_timeout_ms = 60000;  // 60 sec
+        int reader_fanout = DEFAULT_FAILOVER_READER_FANOUT;  // 0 for all hosts at once
+        int reader_connect_stagger_ms = 0;
 
     private:
         std::shared_ptr<TOPOLOGY_SERVICE> topology_service;
@@ -115,6 +146,7 @@ struct WRITER_FAILOVER_RESULT {
                                // process re-connected to the same host
     std::shared_ptr<CLUSTER_TOPOLOGY_INFO> new_topology;
     CONNECTION_PROXY* new_connection;
+    std::vector<int> poll_intervals_ms;  // Waits between polls of the task that connected
 
     WRITER_FAILOVER_RESULT()
         : connected{false},
@@ -145,8 +177,8 @@ class FAILOVER_WRITER_HANDLER {
         std::shared_ptr<CLUSTER_TOPOLOGY_INFO> current_topology);
 
    protected:
-    int read_topology_interval_ms = 5000;     // 5 sec
-    int reconnect_writer_interval_ms = 5000;  // 5 sec
+    int read_topology_interval_ms = 5000;     // 5 sec, upper bound of the adaptive schedule
+    int reconnect_writer_interval_ms = 5000;  // 5 sec, upper bound of the adaptive schedule
     int writer_failover_timeout_ms = 60000;   // 60 sec
 
    private:
@@ -174,6 +206,8 @@ class FAILOVER_HANDLER {
     bool is_rds_proxy();
     bool is_cluster_topology_available();
     void invoke_start_time();
+    void stop_topology_monitoring();
+    void stop_standby_connections();
     std::string cluster_id = DEFAULT_CLUSTER_ID;
 
    private:
@@ -185,6 +219,8 @@ class FAILOVER_HANDLER {
     std::shared_ptr<CLUSTER_TOPOLOGY_INFO> current_topology;
     std::shared_ptr<HOST_INFO> current_host = nullptr;
     std::shared_ptr<CONNECTION_HANDLER> connection_handler = nullptr;
+    std::shared_ptr<TOPOLOGY_MONITOR> topology_monitor = nullptr;
+    std::shared_ptr<STANDBY_CONNECTIONS> standby_connections = nullptr;
     bool m_is_cluster_topology_available = false;
     bool m_is_multi_writer_cluster = false;
     bool m_is_rds_proxy = false;
@@ -195,6 +231,8 @@ class FAILOVER_HANDLER {
     void init_cluster_info();
     bool should_connect_to_new_writer();
     void initialize_topology();
+    void start_topology_monitoring();
+    void start_standby_connections();
     bool is_read_only();
     virtual std::string host_to_IP(std::string host);
     SQLRETURN reconnect(bool failover_enabled);
@@ -229,7 +267,6 @@ class FAILOVER {
 
    protected:
     bool connect(std::shared_ptr<HOST_INFO> host_info);
-    void sleep(int miliseconds);
     void release_new_connection();
     std::shared_ptr<CONNECTION_HANDLER> connection_handler;
     std::shared_ptr<TOPOLOGY_SERVICE> topology_service;
@@ -243,7 +280,8 @@ public:
     CONNECT_TO_READER_HANDLER(
         std::shared_ptr<CONNECTION_HANDLER> connection_handler,
      std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
-     unsigned long dbc_id, bool enable_logging = false);
+     unsigned long dbc_id, bool enable_logging = false,
+     int start_delay_ms = 0);
     ~CONNECT_TO_READER_HANDLER();
 
     void operator()(
@@ -251,6 +289,10 @@ public:
         std::shared_ptr<HOST_INFO> reader,
         std::shared_ptr<FAILOVER_SYNC> f_sync,
         std::shared_ptr<READER_FAILOVER_RESULT> result);
+
+private:
+    // Time to wait before connecting, the attempt is cancelled if another one succeeds meanwhile
+    int start_delay_ms = 0;
 };
 
 class RECONNECT_TO_WRITER_HANDLER : public FAILOVER {
@@ -258,7 +300,7 @@ class RECONNECT_TO_WRITER_HANDLER : public FAILOVER {
     RECONNECT_TO_WRITER_HANDLER(
         std::shared_ptr<CONNECTION_HANDLER> connection_handler,
         std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
-        int connection_interval, unsigned long dbc_id, bool enable_logging = false);
+        FAILOVER_POLL_SCHEDULE poll_schedule, unsigned long dbc_id, bool enable_logging = false);
     ~RECONNECT_TO_WRITER_HANDLER();
 
     void operator()(
@@ -268,7 +310,7 @@ class RECONNECT_TO_WRITER_HANDLER : public FAILOVER {
         std::shared_ptr<WRITER_FAILOVER_RESULT> result);
 
    private:
-    int reconnect_interval_ms;
+    FAILOVER_POLL_SCHEDULE poll_schedule;
 
     bool is_current_host_writer(
         std::shared_ptr<HOST_INFO> original_writer,
@@ -282,7 +324,7 @@ class WAIT_NEW_WRITER_HANDLER : public FAILOVER {
         std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
         std::shared_ptr<CLUSTER_TOPOLOGY_INFO> current_topology,
         std::shared_ptr<FAILOVER_READER_HANDLER> reader_handler,
-        int connection_interval, unsigned long dbc_id, bool enable_logging = false);
+        FAILOVER_POLL_SCHEDULE poll_schedule, unsigned long dbc_id, bool enable_logging = false);
     ~WAIT_NEW_WRITER_HANDLER();
 
     void operator()(
@@ -292,8 +334,7 @@ class WAIT_NEW_WRITER_HANDLER : public FAILOVER {
         std::shared_ptr<WRITER_FAILOVER_RESULT> result);
 
    private:
-    // TODO - initialize in constructor and define constant for default value
-    int read_topology_interval_ms = 5000;
+    FAILOVER_POLL_SCHEDULE poll_schedule;
     std::shared_ptr<FAILOVER_READER_HANDLER> reader_handler;
     std::shared_ptr<CLUSTER_TOPOLOGY_INFO> current_topology;
     CONNECTION_PROXY* reader_connection = nullptr;  // To retrieve latest topology
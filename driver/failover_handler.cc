@@ -34,18 +34,11 @@
 
 #include <sstream>
 
+#include "dns_cache.h"
 #include "driver.h"
 #include "mylog.h"
 #include "rds_utils.h"
 
-#if defined(__APPLE__) || defined(__linux__)
-    #include <arpa/inet.h>    
-    #include <netdb.h>
-    #include <netinet/in.h>
-    #include <sys/socket.h>
-    #include <sys/types.h>
-#endif
-
 namespace {
 const char* MYSQL_READONLY_QUERY = "SELECT @@innodb_read_only AS is_reader";
 }  // namespace
@@ -72,6 +65,7 @@ FAILOVER_HANDLER::FAILOVER_HANDLER(DBC* dbc, DataSource* ds,
     this->topology_service = topology_service;
     this->topology_service->set_refresh_rate(ds->opt_TOPOLOGY_REFRESH_RATE);
     this->topology_service->set_gather_metric(ds->opt_GATHER_PERF_METRICS);
+    this->topology_service->set_dns_cache_ttl(ds->opt_DNS_CACHE_TTL);
     this->connection_handler = connection_handler;
 
     this->failover_reader_handler = std::make_shared<FAILOVER_READER_HANDLER>(
@@ -79,7 +73,8 @@ FAILOVER_HANDLER::FAILOVER_HANDLER(DBC* dbc, DataSource* ds,
         dbc->env->failover_thread_pool, ds->opt_FAILOVER_TIMEOUT,
         ds->opt_FAILOVER_READER_CONNECT_TIMEOUT,
         is_failover_mode(FAILOVER_MODE_STRICT_READER, ds), dbc->id,
-        ds->opt_LOG_QUERY);
+        ds->opt_LOG_QUERY, ds->opt_FAILOVER_READER_FANOUT,
+        ds->opt_FAILOVER_READER_CONNECT_STAGGER);
     this->failover_writer_handler = std::make_shared<FAILOVER_WRITER_HANDLER>(
         this->topology_service, this->failover_reader_handler,
         this->connection_handler, dbc->env->failover_thread_pool,
@@ -88,7 +83,10 @@ FAILOVER_HANDLER::FAILOVER_HANDLER(DBC* dbc, DataSource* ds,
     this->metrics_container = metrics_container;
 }
 
-FAILOVER_HANDLER::~FAILOVER_HANDLER() {}
+FAILOVER_HANDLER::~FAILOVER_HANDLER() {
+    stop_standby_connections();
+    stop_topology_monitoring();
+}
 
 SQLRETURN FAILOVER_HANDLER::init_connection() {
     SQLRETURN rc = connection_handler->do_connect(dbc, ds, false);
@@ -150,6 +148,8 @@ void FAILOVER_HANDLER::init_cluster_info() {
     const char* clid = (const char*)ds->opt_CLUSTER_ID;
     std::string clid_str(clid ? clid : "");
 
+    const RDS_ENDPOINT main_endpoint = RDS_UTILS::parse_endpoint(main_host);
+
     if (!hp_str.empty()) {
         unsigned int port = !ds->opt_PORT.is_default() ? ds->opt_PORT : MYSQL_PORT;
         std::vector<Srv_host_detail> host_patterns;
@@ -183,11 +183,12 @@ void FAILOVER_HANDLER::init_cluster_info() {
         auto host_template = std::make_shared<HOST_INFO>(host_pattern, host_pattern_port);
         topology_service->set_cluster_instance_template(host_template);
 
-        m_is_rds = RDS_UTILS::is_rds_dns(host_pattern);
+        const RDS_ENDPOINT pattern_endpoint = RDS_UTILS::parse_endpoint(host_pattern);
+        m_is_rds = pattern_endpoint.is_rds;
         MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] m_is_rds=%s", m_is_rds ? "true" : "false");
-        m_is_rds_proxy = RDS_UTILS::is_rds_proxy_dns(host_pattern);
+        m_is_rds_proxy = pattern_endpoint.is_proxy;
         MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] m_is_rds_proxy=%s", m_is_rds_proxy ? "true" : "false");
-        m_is_rds_custom_cluster = RDS_UTILS::is_rds_custom_cluster_dns(host_pattern);
+        m_is_rds_custom_cluster = pattern_endpoint.is_custom_cluster;
 
         if (m_is_rds_proxy) {
             err << "RDS Proxy url can't be used as an instance pattern.";
@@ -207,15 +208,14 @@ void FAILOVER_HANDLER::init_cluster_info() {
         } else if (m_is_rds) {
             // If it's a cluster endpoint, or a reader cluster endpoint, then
             // let's use as cluster identification
-            std::string cluster_rds_host =
-                RDS_UTILS::get_rds_cluster_host_url(host_pattern);
+            const std::string& cluster_rds_host = pattern_endpoint.cluster_host_url;
             if (!cluster_rds_host.empty()) {
                 set_cluster_id(cluster_rds_host, host_pattern_port);
             }
         }
 
         initialize_topology();
-    } else if (RDS_UTILS::is_ipv4(main_host) || RDS_UTILS::is_ipv6(main_host)) {
+    } else if (main_endpoint.is_ipv4 || main_endpoint.is_ipv6) {
         // TODO: do we need to setup host template in this case?
         // HOST_INFO* host_template = new HOST_INFO();
         // host_template->host.assign(main_host);
@@ -242,9 +242,9 @@ void FAILOVER_HANDLER::init_cluster_info() {
         m_is_rds_proxy = false;  // actually we don't know
 
     } else {
-        m_is_rds = RDS_UTILS::is_rds_dns(main_host);
+        m_is_rds = main_endpoint.is_rds;
         MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] m_is_rds=%s", m_is_rds ? "true" : "false");
-        m_is_rds_proxy = RDS_UTILS::is_rds_proxy_dns(main_host);
+        m_is_rds_proxy = main_endpoint.is_proxy;
         MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] m_is_rds_proxy=%s", m_is_rds_proxy ? "true" : "false");
 
         if (!m_is_rds) {
@@ -271,7 +271,7 @@ void FAILOVER_HANDLER::init_cluster_info() {
         } else {
             // It's RDS
 
-            std::string rds_instance_host = RDS_UTILS::get_rds_instance_host_pattern(main_host);
+            const std::string& rds_instance_host = main_endpoint.instance_host_pattern;
             if (!rds_instance_host.empty()) {
                 topology_service->set_cluster_instance_template(
                     std::make_shared<HOST_INFO>(rds_instance_host, main_port));
@@ -294,7 +294,7 @@ void FAILOVER_HANDLER::init_cluster_info() {
                 // If it's cluster endpoint or reader cluster endpoint,
                 // then let's use as cluster identification
 
-                std::string cluster_rds_host = RDS_UTILS::get_rds_cluster_host_url(main_host);
+                const std::string& cluster_rds_host = main_endpoint.cluster_host_url;
                 if (!cluster_rds_host.empty()) {
                     set_cluster_id(cluster_rds_host, main_port);
                 } else {
@@ -380,31 +380,13 @@ bool FAILOVER_HANDLER::is_read_only() {
     return read_only;
 }
 
+// Resolved through the process-wide cache so a slow DNS server cannot hold up the connection.
+// The writer cluster endpoint is always looked up again, as its address changes on failover.
 std::string FAILOVER_HANDLER::host_to_IP(std::string host) {
-    int status;
-    struct addrinfo hints;
-    struct addrinfo* servinfo;
-    struct addrinfo* p;
-    char ipstr[INET_ADDRSTRLEN];
-
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_INET; //IPv4
-    hints.ai_socktype = SOCK_STREAM;
-
-    if ((status = getaddrinfo(host.c_str(), NULL, &hints, &servinfo)) != 0) {
-        return "";
-    }
-
-    for (p = servinfo; p != NULL; p = p->ai_next) {
-        void* addr;
-
-        struct sockaddr_in* ipv4 = (struct sockaddr_in*)p->ai_addr;
-        addr = &(ipv4->sin_addr);
-        inet_ntop(p->ai_family, addr, ipstr, sizeof(ipstr));
-    }
-
-    freeaddrinfo(servinfo);
-    return std::string(ipstr);
+    const int ttl = RDS_UTILS::is_rds_writer_cluster_dns(host) ? 0 : ds->opt_DNS_CACHE_TTL;
+    return DNS_CACHE::get_instance().resolve(
+        host, std::chrono::milliseconds(ttl),
+        std::chrono::milliseconds(DNS_RESOLVE_TIMEOUT_MS));
 }
 
 bool FAILOVER_HANDLER::is_failover_enabled() {
@@ -433,10 +415,61 @@ void FAILOVER_HANDLER::initialize_topology() {
         MYLOG_DBC_TRACE(dbc, topology_service->log_topology(current_topology).c_str());
         if (is_failover_enabled()) {
             this->dbc->env->failover_thread_pool.resize(current_topology->total_hosts());
+            start_topology_monitoring();
+            start_standby_connections();
         }
     }
 }
 
+void FAILOVER_HANDLER::start_topology_monitoring() {
+    if (topology_monitor || !ds->opt_ENABLE_TOPOLOGY_MONITORING) {
+        return;
+    }
+
+    topology_monitor = TOPOLOGY_MONITOR::get_or_create(
+        cluster_id, topology_service->get_cluster_instance_template(), current_host, ds, dbc->id, ds->opt_LOG_QUERY);
+    topology_monitor->add_connection_handler(connection_handler);
+    topology_service->set_background_refresh(true);
+    MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] Topology of cluster %s is refreshed in the background", cluster_id.c_str());
+}
+
+void FAILOVER_HANDLER::stop_topology_monitoring() {
+    if (!topology_monitor) {
+        return;
+    }
+
+    topology_monitor->remove_connection_handler(connection_handler);
+    topology_monitor.reset();
+    topology_service->set_background_refresh(false);
+}
+
+void FAILOVER_HANDLER::start_standby_connections() {
+    if (standby_connections || ds->opt_STANDBY_CONNECTIONS <= 0) {
+        return;
+    }
+
+    standby_connections = STANDBY_CONNECTIONS::get_or_create(
+        cluster_id, topology_service, ds, static_cast<size_t>(ds->opt_STANDBY_CONNECTIONS),
+        std::chrono::milliseconds(ds->opt_STANDBY_CONNECTION_REFRESH_INTERVAL), dbc->id, ds->opt_LOG_QUERY);
+    standby_connections->add_connection_handler(connection_handler);
+    standby_connections->set_current_host(connection_handler, current_host);
+    connection_handler->set_standby_connections(standby_connections);
+    standby_connections->start();
+    MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] Sharing %d standby connections to cluster %s",
+                    (int)ds->opt_STANDBY_CONNECTIONS, cluster_id.c_str());
+}
+
+void FAILOVER_HANDLER::stop_standby_connections() {
+    if (!standby_connections) {
+        return;
+    }
+
+    connection_handler->set_standby_connections(nullptr);
+    // The standby connections stop along with the last connection to the cluster using them
+    standby_connections->remove_connection_handler(connection_handler);
+    standby_connections.reset();
+}
+
 SQLRETURN FAILOVER_HANDLER::reconnect(bool failover_enabled) {
     if (dbc->connection_proxy != nullptr && dbc->connection_proxy->is_connected()) {
         dbc->close();
@@ -460,12 +493,27 @@ bool FAILOVER_HANDLER::trigger_failover_if_needed(const char* error_code,
 
     if (ec.rfind("08", 0) == 0) {  // start with "08"
 
+        if (dbc->connection_proxy && dbc->connection_proxy->release_failed_reader()) {
+            // Only the reader connection was lost, statements run on the writer connection from now on
+            new_error_code = in_transaction ? "08007" : "08S02";
+            error_msg = in_transaction ? "Connection failure during transaction." : "The active SQL connection has changed.";
+            return true;
+        }
+
         // disable failure detection during failover
         auto failure_detection_old_state = ds->opt_ENABLE_FAILURE_DETECTION;
         ds->opt_ENABLE_FAILURE_DETECTION = false;
 
         // invalidate current connection
         current_host = nullptr;
+
+        if (topology_monitor) {
+            // Start from the latest topology known to the process
+            topology_monitor->request_fast_refresh();
+            if (auto latest_topology = topology_service->get_cached_topology()) {
+                current_topology = latest_topology;
+            }
+        }
         // close transaction if needed
         
         long long elasped_time_ms =
@@ -511,6 +559,9 @@ bool FAILOVER_HANDLER::failover_to_reader(const char*& new_error_code, const cha
     if (result->connected) {
         current_host = result->new_host;
         connection_handler->update_connection(result->new_connection, current_host->get_host());
+        if (standby_connections) {
+            standby_connections->set_current_host(connection_handler, current_host);
+        }
         new_error_code = "08S02"; // Failover succeeded error code.
         error_msg = "The active SQL connection has changed.";
         MYLOG_DBC_TRACE(dbc,
@@ -530,6 +581,9 @@ bool FAILOVER_HANDLER::failover_to_reader(const char*& new_error_code, const cha
 bool FAILOVER_HANDLER::failover_to_writer(const char*& new_error_code, const char*& error_msg) {
     MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] Starting writer failover procedure.");
     auto result = failover_writer_handler->failover(current_topology);
+    for (const auto interval_ms : result->poll_intervals_ms) {
+        metrics_container->register_writer_failover_poll_interval(interval_ms);
+    }
 
     if (!result->connected) {
         MYLOG_DBC_TRACE(dbc, "[FAILOVER_HANDLER] Unable to establish SQL connection to writer node.");
@@ -561,7 +615,10 @@ bool FAILOVER_HANDLER::failover_to_writer(const char*& new_error_code, const cha
     }
 
     connection_handler->update_connection(result->new_connection, new_host->get_host());
-    
+    if (standby_connections) {
+        standby_connections->set_current_host(connection_handler, new_host);
+    }
+
     new_error_code = "08S02"; // Failover succeeded error code.
     error_msg = "The active SQL connection has changed.";
     MYLOG_DBC_TRACE(
@@ -42,12 +42,15 @@ FAILOVER_READER_HANDLER::FAILOVER_READER_HANDLER(
     ctpl::thread_pool& thread_pool,
     int failover_timeout_ms, int failover_reader_connect_timeout,
     bool enable_strict_reader_failover,
-    unsigned long dbc_id, bool enable_logging)
+    unsigned long dbc_id, bool enable_logging,
+    int reader_fanout, int reader_connect_stagger_ms)
     : topology_service{topology_service},
       connection_handler{connection_handler},
       thread_pool{thread_pool},
       max_failover_timeout_ms{failover_timeout_ms},
       reader_connect_timeout_ms{failover_reader_connect_timeout},
+      reader_fanout{reader_fanout},
+      reader_connect_stagger_ms{reader_connect_stagger_ms},
       enable_strict_reader_failover{enable_strict_reader_failover},
       dbc_id{dbc_id} {
 
@@ -157,6 +160,18 @@ std::vector<std::shared_ptr<HOST_INFO>> FAILOVER_READER_HANDLER::build_hosts_lis
     std::shuffle(std::begin(readers_up), std::end(readers_up), rng);
     std::shuffle(std::begin(readers_down), std::end(readers_down), rng);
 
+    // Readers that are up and replicate with the least lag are tried first. Readers
+    // with the same lag stay in random order, those without a reported lag go last.
+    std::stable_sort(std::begin(readers_up), std::end(readers_up),
+        [](const std::shared_ptr<HOST_INFO>& a, const std::shared_ptr<HOST_INFO>& b) {
+            const double lag_a = a->get_replica_lag();
+            const double lag_b = b->get_replica_lag();
+            if (lag_b < 0) {
+                return lag_a >= 0;
+            }
+            return lag_a >= 0 && lag_a < lag_b;
+        });
+
     // Readers that are marked up go first, readers marked down go after.
     hosts_list.insert(hosts_list.end(), readers_up.begin(), readers_up.end());
     hosts_list.insert(hosts_list.end(), readers_down.begin(), readers_down.end());
@@ -176,40 +191,38 @@ std::shared_ptr<READER_FAILOVER_RESULT> FAILOVER_READER_HANDLER::get_connection_
     size_t total_hosts = hosts_list.size();
     size_t i = 0;
 
+    // Number of hosts raced against each other, all of them when the fan-out is not set.
+    const size_t fanout = reader_fanout > 0 ? static_cast<size_t>(reader_fanout) : std::max<size_t>(total_hosts, 1);
+
     // This loop should end once it reaches the end of the list without a successful connection.
     // The function calling it already has a neverending loop looking for a connection.
     // Ending this loop will allow the calling function to update the list or change strategy if this failed.
     while (!global_sync->is_completed() && i < total_hosts) {
         const auto start = std::chrono::steady_clock::now();
 
-        // This boolean verifies if the next host in the list is also the last, meaning there's no host for the second thread.
-        const bool odd_hosts_number = (i + 1 == total_hosts);
-
-        auto local_sync = std::make_shared<FAILOVER_SYNC>(1);
-        if (!odd_hosts_number) {
-            local_sync->increment_task();
-        }
-
-        CONNECT_TO_READER_HANDLER first_connection_handler(connection_handler, topology_service, dbc_id, logger != nullptr);
-        auto first_connection_result = std::make_shared<READER_FAILOVER_RESULT>(false, nullptr, nullptr);
+        // The last group may hold fewer hosts.
+        const size_t num_tasks = std::min(fanout, total_hosts - i);
 
-        CONNECT_TO_READER_HANDLER second_connection_handler(connection_handler, topology_service, dbc_id, logger != nullptr);
-        auto second_connection_result = std::make_shared<READER_FAILOVER_RESULT>(false, nullptr, nullptr);
-        
-        std::shared_ptr<HOST_INFO> first_reader_host = hosts_list.at(i);
+        // The first task to connect completes the sync, the others then release their connections.
+        auto local_sync = std::make_shared<FAILOVER_SYNC>(static_cast<int>(num_tasks));
 
-        if (thread_pool.n_idle() <= 1) {
-            int size = thread_pool.size() + 2 - thread_pool.n_idle();
+        if (thread_pool.n_idle() < static_cast<int>(num_tasks)) {
+            int size = thread_pool.size() + static_cast<int>(num_tasks) - thread_pool.n_idle();
             MYLOG_TRACE(logger, dbc_id,
                         "[FAILOVER_READER_HANDLER] Resizing thread pool to %d", size);
             thread_pool.resize(size);
-    }
+        }
 
-        auto first_result = thread_pool.push(std::move(first_connection_handler), first_reader_host, local_sync, first_connection_result);
-        std::future<void> second_future;
-        if (!odd_hosts_number) {
-            auto second_reader_host = hosts_list.at(i + 1);
-            second_future = thread_pool.push(std::move(second_connection_handler), second_reader_host, local_sync, second_connection_result);
+        std::vector<std::future<void>> futures;
+        std::vector<std::shared_ptr<READER_FAILOVER_RESULT>> connection_results;
+        for (size_t task = 0; task < num_tasks; task++) {
+            // Each attempt starts a little after the previous one, unless that one has connected already.
+            CONNECT_TO_READER_HANDLER connection_handler_task(connection_handler, topology_service, dbc_id,
+                                                              logger != nullptr,
+                                                              static_cast<int>(task) * reader_connect_stagger_ms);
+            connection_results.push_back(std::make_shared<READER_FAILOVER_RESULT>(false, nullptr, nullptr));
+            futures.push_back(thread_pool.push(std::move(connection_handler_task), hosts_list.at(i + task),
+                                               local_sync, connection_results.back()));
         }
 
         // Wait for task complete signal with specified timeout
@@ -217,33 +230,29 @@ std::shared_ptr<READER_FAILOVER_RESULT> FAILOVER_READER_HANDLER::get_connection_
 
         // Constantly polling for results until timeout
         while (true) {
-            // Check if first reader task result is ready
-            if (first_result.valid() && first_result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-                first_result.get();
-                if (first_connection_result->connected) {
-                    MYLOG_TRACE(logger, dbc_id,
-                        "[FAILOVER_READER_HANDLER] Connected to reader: %s",
-                        first_connection_result->new_host->get_host_port_pair().c_str());
+            bool pending = false;
+            for (size_t task = 0; task < num_tasks; task++) {
+                if (!futures[task].valid()) {
+                    continue;
+                }
 
-                    return first_connection_result;
+                if (futures[task].wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    pending = true;
+                    continue;
                 }
-            }
 
-            // Check if second reader task result is ready if there is one
-            if (!odd_hosts_number && second_future.valid() &&
-                second_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-                second_future.get();
-                if (second_connection_result->connected) {
+                futures[task].get();
+                if (connection_results[task]->connected) {
                     MYLOG_TRACE(logger, dbc_id,
                         "[FAILOVER_READER_HANDLER] Connected to reader: %s",
-                        second_connection_result->new_host->get_host_port_pair().c_str());
+                        connection_results[task]->new_host->get_host_port_pair().c_str());
 
-                    return second_connection_result;
+                    return connection_results[task];
                 }
             }
 
             // Results are ready but non has valid connection
-            if (!first_result.valid() && (odd_hosts_number || !second_future.valid())) {
+            if (!pending) {
                 break;
             }
 
@@ -256,7 +265,7 @@ std::shared_ptr<READER_FAILOVER_RESULT> FAILOVER_READER_HANDLER::get_connection_
                 break;
             }
         }
-        i += 2;
+        i += num_tasks;
     }
 
     // The operation was either cancelled either reached the end of the list without connecting.
@@ -268,8 +277,9 @@ std::shared_ptr<READER_FAILOVER_RESULT> FAILOVER_READER_HANDLER::get_connection_
 CONNECT_TO_READER_HANDLER::CONNECT_TO_READER_HANDLER(
     std::shared_ptr<CONNECTION_HANDLER> connection_handler,
     std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
-    unsigned long dbc_id, bool enable_logging)
-    : FAILOVER{connection_handler, topology_service, dbc_id, enable_logging} {}
+    unsigned long dbc_id, bool enable_logging, int start_delay_ms)
+    : FAILOVER{connection_handler, topology_service, dbc_id, enable_logging},
+      start_delay_ms{start_delay_ms} {}
 
 CONNECT_TO_READER_HANDLER::~CONNECT_TO_READER_HANDLER() {}
 
@@ -278,7 +288,12 @@ void CONNECT_TO_READER_HANDLER::operator()(
     std::shared_ptr<HOST_INFO> reader,
     std::shared_ptr<FAILOVER_SYNC> f_sync,
     std::shared_ptr<READER_FAILOVER_RESULT> result) {
-    
+
+    if (start_delay_ms > 0 && f_sync->wait_for_completion(start_delay_ms)) {
+        // Another reader connected or the attempts timed out before this one started
+        return;
+    }
+
     if (reader && !f_sync->is_completed()) {
 
         MYLOG_TRACE(logger, dbc_id,
@@ -29,6 +29,7 @@
 
 #include "driver.h"
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <thread>
@@ -53,13 +54,20 @@ void FAILOVER_SYNC::mark_as_complete(bool cancel_other_tasks) {
         num_tasks--;
     }
 
-    cv.notify_one();
+    // Tasks waiting to start are woken up as well
+    cv.notify_all();
 }
 
 void FAILOVER_SYNC::wait_and_complete(int milliseconds) {
     std::unique_lock<std::mutex> lock(mutex_);
     cv.wait_for(lock, std::chrono::milliseconds(milliseconds), [this] { return num_tasks <= 0; });
     num_tasks = 0;
+    cv.notify_all();
+}
+
+bool FAILOVER_SYNC::wait_for_completion(int milliseconds) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv.wait_for(lock, std::chrono::milliseconds(milliseconds), [this] { return num_tasks <= 0; });
 }
 
 bool FAILOVER_SYNC::is_completed() {
@@ -67,6 +75,30 @@ bool FAILOVER_SYNC::is_completed() {
     return num_tasks <= 0; 
 }
 
+// **** FAILOVER_POLL_SCHEDULE ******************************
+// adaptive pacing of the polls made by the writer failover tasks
+FAILOVER_POLL_SCHEDULE::FAILOVER_POLL_SCHEDULE(
+    int max_interval_ms, std::chrono::steady_clock::time_point deadline,
+    int initial_interval_ms)
+    : interval_ms{(std::max)(1, (std::min)(initial_interval_ms, max_interval_ms))},
+      max_interval_ms{(std::max)(1, max_interval_ms)},
+      deadline{deadline} {}
+
+int FAILOVER_POLL_SCHEDULE::next_interval_ms() {
+    const long long remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+    const int next = remaining_ms <= 0 ? 0 : static_cast<int>((std::min)(static_cast<long long>(interval_ms), remaining_ms));
+
+    // Back off for the following poll
+    interval_ms = interval_ms > max_interval_ms / 2 ? max_interval_ms : interval_ms * 2;
+    intervals.push_back(next);
+    return next;
+}
+
+std::vector<int> FAILOVER_POLL_SCHEDULE::get_intervals() {
+    return intervals;
+}
+
 // ************* FAILOVER ***********************************
 // Base class of two writer failover task handlers
 FAILOVER::FAILOVER(
@@ -91,10 +123,6 @@ bool FAILOVER::connect(std::shared_ptr<HOST_INFO> host_info) {
     return is_writer_connected();
 }
 
-void FAILOVER::sleep(int miliseconds) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(miliseconds));
-}
-
 // Close new connection if not needed (other task finishes and returns first)
 void FAILOVER::release_new_connection() {
     if (new_connection) {
@@ -109,9 +137,9 @@ void FAILOVER::release_new_connection() {
 RECONNECT_TO_WRITER_HANDLER::RECONNECT_TO_WRITER_HANDLER(
     std::shared_ptr<CONNECTION_HANDLER> connection_handler,
     std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
-    int connection_interval, unsigned long dbc_id, bool enable_logging)
+    FAILOVER_POLL_SCHEDULE poll_schedule, unsigned long dbc_id, bool enable_logging)
     : FAILOVER{connection_handler, topology_service, dbc_id, enable_logging},
-      reconnect_interval_ms{connection_interval} {}
+      poll_schedule{poll_schedule} {}
 
 RECONNECT_TO_WRITER_HANDLER::~RECONNECT_TO_WRITER_HANDLER() {}
 
@@ -142,13 +170,15 @@ void RECONNECT_TO_WRITER_HANDLER::operator()(
                     result->is_new_host = false;
                     result->new_topology = latest_topology;
                     result->new_connection = std::move(new_connection);
+                    result->poll_intervals_ms = poll_schedule.get_intervals();
                     f_sync->mark_as_complete(true);
                     MYLOG_TRACE(logger, dbc_id, "Thread ID %d - [RECONNECT_TO_WRITER_HANDLER] [TaskA] Finished", id);
                     return;
                 }
                 release_new_connection();
             }
-            sleep(reconnect_interval_ms);
+            // Returns early if the other task connects meanwhile
+            f_sync->wait_for_completion(poll_schedule.next_interval_ms());
         }
         MYLOG_TRACE(logger, dbc_id, "Thread ID %d - [RECONNECT_TO_WRITER_HANDLER] [TaskA] Cancelled", id);
     }
@@ -175,11 +205,11 @@ WAIT_NEW_WRITER_HANDLER::WAIT_NEW_WRITER_HANDLER(
     std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
     std::shared_ptr<CLUSTER_TOPOLOGY_INFO> current_topology,
     std::shared_ptr<FAILOVER_READER_HANDLER> reader_handler,
-    int connection_interval, unsigned long dbc_id, bool enable_logging)
+    FAILOVER_POLL_SCHEDULE poll_schedule, unsigned long dbc_id, bool enable_logging)
     : FAILOVER{connection_handler, topology_service, dbc_id, enable_logging},
       current_topology{current_topology},
       reader_handler{reader_handler},
-      read_topology_interval_ms{connection_interval} {}
+      poll_schedule{poll_schedule} {}
 
 WAIT_NEW_WRITER_HANDLER::~WAIT_NEW_WRITER_HANDLER() {}
 
@@ -201,6 +231,7 @@ void WAIT_NEW_WRITER_HANDLER::operator()(
             result->is_new_host = true;
             result->new_topology = current_topology;
             result->new_connection = std::move(new_connection);
+            result->poll_intervals_ms = poll_schedule.get_intervals();
             f_sync->mark_as_complete(true);
             MYLOG_TRACE(logger, dbc_id, "Thread ID %d - [WAIT_NEW_WRITER_HANDLER] [TaskB] Finished", id);
             return;
@@ -244,7 +275,8 @@ void WAIT_NEW_WRITER_HANDLER::refresh_topology_and_connect_to_new_writer(
                 if (connect_to_writer(writer_candidate)) return;
             }
         }
-        sleep(read_topology_interval_ms);
+        // Returns early if the other task connects meanwhile
+        f_sync->wait_for_completion(poll_schedule.next_interval_ms());
     }
 }
 
@@ -310,15 +342,17 @@ std::shared_ptr<WRITER_FAILOVER_RESULT> FAILOVER_WRITER_HANDLER::failover(
     }
 
     const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::milliseconds(writer_failover_timeout_ms);
 
     auto failover_sync = std::make_shared<FAILOVER_SYNC>(2);
 
-    // Constructing the function objects
+    // Constructing the function objects, both poll on the same adaptive schedule
     RECONNECT_TO_WRITER_HANDLER reconnect_handler(
-        connection_handler, topology_service, reconnect_writer_interval_ms, dbc_id, logger != nullptr);
+        connection_handler, topology_service,
+        FAILOVER_POLL_SCHEDULE(reconnect_writer_interval_ms, deadline), dbc_id, logger != nullptr);
     WAIT_NEW_WRITER_HANDLER new_writer_handler(
         connection_handler, topology_service, current_topology, reader_handler,
-        read_topology_interval_ms, dbc_id, logger != nullptr);
+        FAILOVER_POLL_SCHEDULE(read_topology_interval_ms, deadline), dbc_id, logger != nullptr);
 
     auto original_writer = current_topology->get_writer();
     topology_service->mark_host_down(original_writer);
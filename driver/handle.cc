@@ -49,10 +49,12 @@
 
 #include "adfs_proxy.h"
 #include "driver.h"
+#include "dns_cache.h"
 #include "efm_proxy.h"
 #include "iam_proxy.h"
 #include "mysql_proxy.h"
 #include "okta_proxy.h"
+#include "read_write_splitting_proxy.h"
 #include "secrets_manager_proxy.h"
 
 #include <mutex>
@@ -80,6 +82,85 @@ bool ENV::has_connections()
   return conn_list.size() > 0;
 }
 
+/*
+  Establishes a connection on a worker thread. The pool grows while all of
+  its workers are busy, so that connections started together are
+  established in parallel.
+*/
+std::future<SQLRETURN> ENV::start_connect(std::function<SQLRETURN()> connect)
+{
+  LOCK_ENV(this);
+
+  if (connect_thread_pool.n_idle() == 0 &&
+      connect_thread_pool.size() < MAX_CONNECT_THREADS)
+  {
+    connect_thread_pool.resize(connect_thread_pool.size() + 1);
+  }
+
+  return connect_thread_pool.push([connect](int) { return connect(); });
+}
+
+void DBC_MUTEX::lock()
+{
+  const std::thread::id self = std::this_thread::get_id();
+  std::unique_lock<std::mutex> guard(mutex);
+  if (!count || owner != self)
+    released.wait(guard, [this] { return count == 0; });
+  owner = self;
+  ++count;
+}
+
+bool DBC_MUTEX::try_lock()
+{
+  const std::thread::id self = std::this_thread::get_id();
+  std::lock_guard<std::mutex> guard(mutex);
+  if (count && owner != self)
+    return false;
+  owner = self;
+  ++count;
+  return true;
+}
+
+void DBC_MUTEX::unlock()
+{
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (--count)
+      return;
+    owner = std::thread::id();
+  }
+  released.notify_all();
+}
+
+bool DBC_MUTEX::lock_unless(const std::atomic<bool> &cancel)
+{
+  const std::thread::id self = std::this_thread::get_id();
+  std::unique_lock<std::mutex> guard(mutex);
+  if (!count || owner != self)
+  {
+    released.wait(guard, [this, &cancel] { return count == 0 || cancel; });
+    if (count)
+      return false;
+  }
+  owner = self;
+  ++count;
+  return true;
+}
+
+void DBC_MUTEX::notify_waiters()
+{
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+  }
+  released.notify_all();
+}
+
+bool DBC_MUTEX::owned_by_this_thread()
+{
+  std::lock_guard<std::mutex> guard(mutex);
+  return count && owner == std::this_thread::get_id();
+}
+
 DBC::DBC(ENV *p_env)
     : id{last_dbc_id++},
       env(p_env),
@@ -117,6 +198,16 @@ void DBC::free_explicit_descriptors()
 void DBC::close()
 {
   connection_proxy->close();
+  // Cached prepared statements belonged to the closed session
+  ssps_cache.clear(connection_proxy);
+  // The next session may be with a server configured differently
+  max_allowed_packet = 0;
+
+  if (ds && ds->opt_LOG_QUERY && ds->opt_PARSED_QUERY_CACHE_SIZE > 0) {
+    const auto& cache = PARSED_QUERY_CACHE::get_instance();
+    MYLOG_DBC_TRACE(this, "[PARSED_QUERY_CACHE] hits: %llu, misses: %llu",
+                    cache.get_hits(), cache.get_misses());
+  }
 }
 
 // construct a proxy chain, example: iam->efm->mysql
@@ -124,6 +215,20 @@ void DBC::init_proxy_chain(DataSource* dsrc)
 {
     this->topology_service = std::make_shared<TOPOLOGY_SERVICE>(this->id, ds ? ds->opt_LOG_QUERY : false);
 
+    CONNECTION_PROXY* head = create_proxy_chain(dsrc);
+
+    if (dsrc->opt_ENABLE_READ_WRITE_SPLITTING) {
+        CONNECTION_PROXY* read_write_splitting_proxy = new READ_WRITE_SPLITTING_PROXY(this, dsrc);
+        read_write_splitting_proxy->set_next_proxy(head);
+        head = read_write_splitting_proxy;
+    }
+
+    this->connection_proxy = head;
+}
+
+// construct the proxies of a single server connection
+CONNECTION_PROXY* DBC::create_proxy_chain(DataSource* dsrc)
+{
     CONNECTION_PROXY* head = new MYSQL_PROXY(this, dsrc);
 
     if (dsrc->opt_ENABLE_FAILURE_DETECTION) {
@@ -166,22 +271,36 @@ void DBC::init_proxy_chain(DataSource* dsrc)
         head = custom_endpoint_proxy;
     }
 
-    this->connection_proxy = head;
+    return head;
 }
 
 DBC::~DBC()
 {
+  // The worker uses the connection until it is established
+  if (pending_connect.valid())
+    pending_connect.wait();
+
   if (env)
     env->remove_dbc(this);
 
   this->topology_service.reset();
-  if (connection_proxy) 
+  if (connection_proxy) {
+    ssps_cache.clear(connection_proxy);
     delete connection_proxy;
+  }
 
   if (fh)
     delete fh;
 
   free_explicit_descriptors();
+
+  // The application did not call the connect function again to complete it
+  if (pending_connect_ds)
+  {
+    if (ds == pending_connect_ds)
+      ds = nullptr;
+    delete pending_connect_ds;
+  }
 }
 
 
@@ -256,6 +375,7 @@ SQLRETURN SQL_API my_SQLFreeEnv(SQLHENV henv)
 {
     MONITOR_THREAD_CONTAINER::release_instance();
     CUSTOM_ENDPOINT_PROXY::release_resources();
+    DNS_CACHE::get_instance().release_resources();
 
     ENV *env= (ENV *) henv;
     delete env;
@@ -370,6 +490,8 @@ int reset_connection(DBC *dbc)
 {
   dbc->free_connection_stmts();
   dbc->free_explicit_descriptors();
+  /* The pooled connection is reused by whoever asks for it next */
+  dbc->ssps_cache.clear(dbc->connection_proxy);
 
   return 0;
 }
@@ -566,6 +688,13 @@ SQLRETURN SQL_API my_SQLFreeStmtExtended(SQLHSTMT hstmt, SQLUSMALLINT f_option,
       DO_LOCK_STMT();
     }
 
+    /* Closing or cancelling the statement ends its asynchronous call */
+    if (stmt->async.pending() && f_option != SQL_UNBIND &&
+        f_option != SQL_RESET_PARAMS)
+    {
+      finish_async_call(stmt);
+    }
+
     stmt->reset();
 
     if (f_option == SQL_UNBIND)
@@ -585,6 +714,7 @@ SQLRETURN SQL_API my_SQLFreeStmtExtended(SQLHSTMT hstmt, SQLUSMALLINT f_option,
     stmt->free_fake_result((bool)(f_extra & FREE_STMT_CLEAR_RESULT));
 
     x_free(stmt->fields);   // TODO: Looks like STMT::fields is not used anywhere
+    stmt->read_ahead.reset();
     stmt->result= 0;
     stmt->fake_result= 0;
     stmt->fields= 0;
@@ -31,6 +31,8 @@
 
 #include "rds_utils.h"
 
+#include <cstdlib>
+
 // TODO
 // the entire HOST_INFO needs to be reviewed based on needed interfaces and other objects like CLUSTER_TOPOLOGY_INFO
 // most/all of the HOST_INFO potentially could be internal to CLUSTER_TOPOLOGY_INFO and specfic information may be accessed
@@ -109,6 +111,15 @@ void HOST_INFO::mark_as_writer(bool writer) {
     is_writer = writer;
 }
 
+double HOST_INFO::get_replica_lag() {
+    if (replica_lag.empty()) {
+        return -1;
+    }
+    char* end = nullptr;
+    const double lag = std::strtod(replica_lag.c_str(), &end);
+    return end == replica_lag.c_str() || lag < 0 ? -1 : lag;
+}
+
 // Check if two host info have same instance name
 bool HOST_INFO::is_host_same(std::shared_ptr<HOST_INFO> h1, std::shared_ptr<HOST_INFO> h2) {
     return h1->instance_name == h2->instance_name;
@@ -59,6 +59,8 @@ public:
     bool is_host_down();
     bool is_host_writer();
     void mark_as_writer(bool writer);
+    // Replication lag in milliseconds, or -1 if the topology did not report it
+    double get_replica_lag();
     static bool is_host_same(std::shared_ptr<HOST_INFO> h1, std::shared_ptr<HOST_INFO> h2);
     static constexpr int NO_PORT = -1;
 
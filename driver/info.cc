@@ -99,11 +99,11 @@ MySQLGetInfo(SQLHDBC hdbc, SQLUSMALLINT fInfoType,
 
 #ifndef USE_IODBC
   case SQL_ASYNC_DBC_FUNCTIONS:
-    MYINFO_SET_ULONG(SQL_ASYNC_DBC_NOT_CAPABLE);
+    MYINFO_SET_ULONG(SQL_ASYNC_DBC_CAPABLE);
 #endif
 
   case SQL_ASYNC_MODE:
-    MYINFO_SET_ULONG(SQL_AM_NONE);
+    MYINFO_SET_ULONG(SQL_AM_STATEMENT);
 
   case SQL_BATCH_ROW_COUNT:
     MYINFO_SET_ULONG(SQL_BRC_EXPLICIT);
@@ -558,7 +558,7 @@ MySQLGetInfo(SQLHDBC hdbc, SQLUSMALLINT fInfoType,
     MYINFO_SET_STR("Y");
 
   case SQL_MAX_ASYNC_CONCURRENT_STATEMENTS:
-    MYINFO_SET_ULONG(0);
+    MYINFO_SET_ULONG(1);
 
   case SQL_MAX_BINARY_LITERAL_LEN:
     MYINFO_SET_ULONG(0);
@@ -130,56 +130,84 @@ void MONITOR::stop() {
 void MONITOR::clear_contexts() {
     {
         std::unique_lock<std::mutex> lock(mutex_);
+        for (const auto& context : this->contexts) {
+            context->invalidate();
+        }
         this->contexts.clear();
     }
 
     this->connection_check_interval = (std::chrono::milliseconds::max)();
 }
 
+void MONITOR::start() {
+    this->stopped.store(false);
+}
+
 // Periodically ping the server and update the contexts' connection status.
 void MONITOR::run(std::shared_ptr<MONITOR_SERVICE> service) {
-    this->stopped = false;
-    while (!this->stopped) {
-        bool have_contexts;
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
-            have_contexts = !this->contexts.empty();
+    this->start();
+    std::chrono::milliseconds next_check;
+    while (!this->stopped && this->run_once(next_check)) {
+        if (next_check > std::chrono::milliseconds(0)) {
+            std::this_thread::sleep_for(next_check);
         }
-        if (have_contexts) {
-            auto status_check_start_time = this->get_current_time();
-            this->last_context_timestamp = status_check_start_time;
-
-            CONNECTION_STATUS status = this->check_connection_status();
-
-            {
-                std::unique_lock<std::mutex> lock(mutex_);
-                for (auto it = this->contexts.begin(); it != this->contexts.end(); ++it) {
-                    std::shared_ptr<MONITOR_CONNECTION_CONTEXT> context = *it;
-                    context->update_connection_status(
-                        status_check_start_time,
-                        status_check_start_time + status.elapsed_time,
-                        status.is_valid);
-                }
-            }
+    }
 
-            std::chrono::milliseconds check_interval = this->get_connection_check_interval();
-            auto sleep_time = check_interval - status.elapsed_time;
-            if (sleep_time > std::chrono::milliseconds(0)) {
-                std::this_thread::sleep_for(sleep_time);
-            }
-        }
-        else {
-            auto time_inactive = std::chrono::duration_cast<std::chrono::milliseconds>(this->get_current_time() - this->last_context_timestamp);
-            if (time_inactive >= this->disposal_time) {
+    service->notify_unused(shared_from_this());
+
+    this->stopped = true;
+}
+
+// Performs a single connection check. Returns false once the monitor has been
+// inactive for longer than the disposal time, otherwise sets next_check to the
+// delay until the monitor should run again.
+bool MONITOR::run_once(std::chrono::milliseconds& next_check) {
+    bool have_contexts;
+    bool have_armed_contexts = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        have_contexts = !this->contexts.empty();
+        for (const auto& context : this->contexts) {
+            if (context->is_armed()) {
+                have_armed_contexts = true;
                 break;
             }
-            std::this_thread::sleep_for(thread_sleep_when_inactive);
         }
     }
 
-    service->notify_unused(shared_from_this());
+    // Connections keep their context registered while idle. Only ping while one of them
+    // is inside a network call, but do not dispose of the monitor they are registered with.
+    if (have_contexts && !have_armed_contexts) {
+        this->last_context_timestamp = this->get_current_time();
+        next_check = thread_sleep_when_inactive;
+        return true;
+    }
 
-    this->stopped = true;
+    if (!have_contexts) {
+        auto time_inactive = std::chrono::duration_cast<std::chrono::milliseconds>(this->get_current_time() - this->last_context_timestamp);
+        next_check = thread_sleep_when_inactive;
+        return time_inactive < this->disposal_time;
+    }
+
+    auto status_check_start_time = this->get_current_time();
+    this->last_context_timestamp = status_check_start_time;
+
+    CONNECTION_STATUS status = this->check_connection_status();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto it = this->contexts.begin(); it != this->contexts.end(); ++it) {
+            std::shared_ptr<MONITOR_CONNECTION_CONTEXT> context = *it;
+            context->update_connection_status(
+                status_check_start_time,
+                status_check_start_time + status.elapsed_time,
+                status.is_valid);
+        }
+    }
+
+    std::chrono::milliseconds check_interval = this->get_connection_check_interval();
+    next_check = (std::max)(check_interval - status.elapsed_time, std::chrono::milliseconds(0));
+    return true;
 }
 
 std::chrono::milliseconds MONITOR::get_connection_check_interval() {
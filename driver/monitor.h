@@ -75,6 +75,8 @@ public:
     virtual bool is_stopped();
     virtual void clear_contexts();
     virtual void run(std::shared_ptr<MONITOR_SERVICE> service);
+    bool run_once(std::chrono::milliseconds& next_check);
+    void start();
     void stop();
 
 private:
@@ -52,11 +52,11 @@ MONITOR_CONNECTION_CONTEXT::MONITOR_CONNECTION_CONTEXT(DBC* connection_to_abort,
 MONITOR_CONNECTION_CONTEXT::~MONITOR_CONNECTION_CONTEXT() {}
 
 std::chrono::steady_clock::time_point MONITOR_CONNECTION_CONTEXT::get_start_monitor_time() {
-    return start_monitor_time;
+    return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(start_monitor_time.load()));
 }
 
 void MONITOR_CONNECTION_CONTEXT::set_start_monitor_time(std::chrono::steady_clock::time_point time) {
-    start_monitor_time = time;
+    start_monitor_time.store(time.time_since_epoch().count());
 }
 
 std::set<std::string> MONITOR_CONNECTION_CONTEXT::get_node_keys() {
@@ -121,6 +121,23 @@ void MONITOR_CONNECTION_CONTEXT::invalidate() {
     active_context.store(false);
 }
 
+// Re-arms a context that stays registered with its monitor between calls,
+// so the connection does not need to register a new context for every call.
+void MONITOR_CONNECTION_CONTEXT::arm(std::chrono::steady_clock::time_point time) {
+    set_start_monitor_time(time);
+    node_unhealthy.store(false);
+    arm_count++;
+    armed.store(true);
+}
+
+void MONITOR_CONNECTION_CONTEXT::disarm() {
+    armed.store(false);
+}
+
+bool MONITOR_CONNECTION_CONTEXT::is_armed() {
+    return armed.load();
+}
+
 DBC* MONITOR_CONNECTION_CONTEXT::get_connection_to_abort() {
     return connection_to_abort;
 }
@@ -135,10 +152,17 @@ void MONITOR_CONNECTION_CONTEXT::update_connection_status(
     std::chrono::steady_clock::time_point current_time,
     bool is_valid) {
     
-    if (!is_active_context()) {
+    if (!is_active_context() || !is_armed()) {
       return;
     }
 
+    const unsigned int current_arm_count = arm_count.load();
+    if (current_arm_count != observed_arm_count) {
+      observed_arm_count = current_arm_count;
+      set_failure_count(0);
+      reset_invalid_node_start_time();
+    }
+
     auto total_elapsed_time = current_time - get_start_monitor_time();
 
     if (total_elapsed_time > get_failure_detection_time()) {
@@ -185,7 +209,7 @@ void MONITOR_CONNECTION_CONTEXT::set_connection_valid(
 
 void MONITOR_CONNECTION_CONTEXT::abort_connection() {
     std::lock_guard<std::mutex> lock(mutex_);
-    if ((!get_connection_to_abort()) || (!is_active_context())) {
+    if ((!get_connection_to_abort()) || (!is_active_context()) || (!is_armed())) {
         return;
     }
     connection_to_abort->connection_proxy->close_socket();
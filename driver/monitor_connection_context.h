@@ -68,6 +68,9 @@ public:
     void set_node_unhealthy(bool node);
     bool is_active_context();
     void invalidate();
+    void arm(std::chrono::steady_clock::time_point time);
+    void disarm();
+    bool is_armed();
     DBC* get_connection_to_abort();
     unsigned long get_dbc_id();
 
@@ -91,11 +94,16 @@ private:
     std::set<std::string> node_keys;
     DBC* connection_to_abort;
 
-    std::chrono::steady_clock::time_point start_monitor_time;
+    // Written by the connection's thread when the context is armed and read by the monitor.
+    std::atomic<std::chrono::steady_clock::rep> start_monitor_time{ 0 };
     std::chrono::steady_clock::time_point invalid_node_start_time;
     int failure_count;
-    bool node_unhealthy;
+    std::atomic_bool node_unhealthy;
     std::atomic_bool active_context{ true };
+    std::atomic_bool armed{ true };
+    std::atomic<unsigned int> arm_count{ 0 };
+    // Only accessed by the monitor. Tells it to drop failures counted while the context was previously armed.
+    unsigned int observed_arm_count = 0;
     std::shared_ptr<FILE> logger;
 
     std::string build_node_keys_str();
@@ -0,0 +1,124 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "monitor_scheduler.h"
+
+#include "monitor_service.h"
+
+namespace {
+    // Guards against overflowing the due time when a monitor has no real interval.
+    const std::chrono::milliseconds max_schedule_delay = std::chrono::hours(1);
+}
+
+MONITOR_SCHEDULER::MONITOR_SCHEDULER(int num_workers) : workers((std::max)(num_workers, 1)) {
+    this->timer_thread = std::thread(&MONITOR_SCHEDULER::run_timer, this);
+}
+
+MONITOR_SCHEDULER::~MONITOR_SCHEDULER() {
+    this->stop();
+}
+
+void MONITOR_SCHEDULER::schedule(
+    std::shared_ptr<MONITOR> monitor,
+    std::shared_ptr<MONITOR_SERVICE> service,
+    std::chrono::milliseconds delay) {
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (this->stopped) {
+            return;
+        }
+
+        delay = (std::min)(delay, max_schedule_delay);
+        this->timers.push(TASK{std::chrono::steady_clock::now() + delay, std::move(monitor), std::move(service)});
+    }
+    this->cv.notify_one();
+}
+
+void MONITOR_SCHEDULER::stop() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (this->stopped) {
+            return;
+        }
+        this->stopped = true;
+    }
+    this->cv.notify_all();
+
+    if (this->timer_thread.joinable()) {
+        this->timer_thread.join();
+    }
+
+    // Let in-flight checks finish. Their monitors are not rescheduled.
+    this->workers.stop(true);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::priority_queue<TASK, std::vector<TASK>, std::greater<TASK>> empty;
+    std::swap(this->timers, empty);
+}
+
+int MONITOR_SCHEDULER::get_num_workers() {
+    return this->workers.size();
+}
+
+size_t MONITOR_SCHEDULER::get_num_scheduled() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return this->timers.size();
+}
+
+void MONITOR_SCHEDULER::run_timer() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!this->stopped) {
+        if (this->timers.empty()) {
+            this->cv.wait(lock);
+            continue;
+        }
+
+        const auto due = this->timers.top().due;
+        if (std::chrono::steady_clock::now() < due) {
+            this->cv.wait_until(lock, due);
+            continue;
+        }
+
+        TASK task = this->timers.top();
+        this->timers.pop();
+        this->workers.push([this, task](int id) { this->run_task(task); });
+    }
+}
+
+void MONITOR_SCHEDULER::run_task(const TASK& task) {
+    std::chrono::milliseconds next_check{0};
+    if (!task.monitor->is_stopped() && task.monitor->run_once(next_check)) {
+        this->schedule(task.monitor, task.service, next_check);
+        return;
+    }
+
+    task.service->notify_unused(task.monitor);
+    task.monitor->stop();
+}
@@ -0,0 +1,78 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __MONITORSCHEDULER_H__
+#define __MONITORSCHEDULER_H__
+
+#include "monitor.h"
+
+#include <condition_variable>
+#include <ctpl_stl.h>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Multiplexes all EFM monitors onto a single timer thread and a fixed set of
+// workers. Each monitor is due at most once at any time: it is put back on the
+// timer queue only after its previous connection check has completed.
+class MONITOR_SCHEDULER {
+public:
+    explicit MONITOR_SCHEDULER(int num_workers);
+    virtual ~MONITOR_SCHEDULER();
+
+    void schedule(
+        std::shared_ptr<MONITOR> monitor,
+        std::shared_ptr<MONITOR_SERVICE> service,
+        std::chrono::milliseconds delay);
+    void stop();
+    int get_num_workers();
+    size_t get_num_scheduled();
+
+private:
+    struct TASK {
+        std::chrono::steady_clock::time_point due;
+        std::shared_ptr<MONITOR> monitor;
+        std::shared_ptr<MONITOR_SERVICE> service;
+
+        bool operator>(const TASK& other) const { return due > other.due; }
+    };
+
+    void run_timer();
+    void run_task(const TASK& task);
+
+    std::priority_queue<TASK, std::vector<TASK>, std::greater<TASK>> timers;
+    std::mutex mutex_;
+    std::condition_variable cv;
+    bool stopped = false;
+    ctpl::thread_pool workers;
+    std::thread timer_thread;
+};
+
+#endif /* __MONITORSCHEDULER_H__ */
@@ -27,6 +27,7 @@
 // along with this program. If not, see
 // http://www.gnu.org/licenses/gpl-2.0.html.
 
+#include "driver.h"
 #include "monitor_thread_container.h"
 
 std::shared_ptr<MONITOR_THREAD_CONTAINER> MONITOR_THREAD_CONTAINER::get_instance() {
@@ -98,6 +99,10 @@ std::shared_ptr<MONITOR> MONITOR_THREAD_CONTAINER::get_or_create_monitor(
 
     this->populate_monitor_map(node_keys, monitor);
 
+    if (ds) {
+        this->set_scheduler_threads(ds->opt_MONITOR_THREAD_POOL_SIZE);
+    }
+
     return monitor;
 }
 
@@ -106,14 +111,40 @@ void MONITOR_THREAD_CONTAINER::add_task(const std::shared_ptr<MONITOR>& monitor,
         throw std::invalid_argument("Invalid parameters passed into MONITOR_THREAD_CONTAINER::add_task()");
     }
 
+    std::shared_ptr<MONITOR_SCHEDULER> current_scheduler;
+    {
+        std::unique_lock<std::mutex> lock(scheduler_mutex);
+        current_scheduler = this->scheduler;
+    }
+
     std::unique_lock<std::mutex> lock(task_map_mutex);
-    if (this->task_map.count(monitor) == 0) {
+    if (this->task_map.count(monitor) == 0 && this->scheduled_monitors.count(monitor) == 0) {
+        if (current_scheduler) {
+            monitor->start();
+            this->scheduled_monitors.insert(monitor);
+            current_scheduler->schedule(monitor, service, std::chrono::milliseconds(0));
+            return;
+        }
+
         this->thread_pool.resize(this->thread_pool.size() + 1);
         auto run_monitor = [monitor, service](int id) { monitor->run(service); };
         this->task_map[monitor] = this->thread_pool.push(run_monitor);
     }
 }
 
+// Switches newly added monitors to a shared scheduler with a fixed number of workers.
+// The first non-zero size wins; monitors already running on the pool are left in place.
+void MONITOR_THREAD_CONTAINER::set_scheduler_threads(int num_threads) {
+    if (num_threads <= 0) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(scheduler_mutex);
+    if (!this->scheduler) {
+        this->scheduler = std::make_shared<MONITOR_SCHEDULER>(num_threads);
+    }
+}
+
 void MONITOR_THREAD_CONTAINER::reset_resource(const std::shared_ptr<MONITOR>& monitor) {
     if (monitor == nullptr) {
         return;
@@ -132,14 +163,15 @@ void MONITOR_THREAD_CONTAINER::release_resource(std::shared_ptr<MONITOR> monitor
 
     this->remove_monitor_mapping(monitor);
 
+    bool ran_on_pool;
     {
         std::unique_lock<std::mutex> lock(task_map_mutex);
-        if (this->task_map.count(monitor) > 0) {
-            this->task_map.erase(monitor);
-        }
+        ran_on_pool = this->task_map.erase(monitor) > 0;
+        this->scheduled_monitors.erase(monitor);
     }
 
-    if (this->thread_pool.n_idle() > 0) {
+    // Scheduled monitors never had a thread of the pool
+    if (ran_on_pool && this->thread_pool.n_idle() > 0) {
         this->thread_pool.resize(this->thread_pool.size() - 1);
     }
 }
@@ -177,9 +209,10 @@ std::shared_ptr<MONITOR> MONITOR_THREAD_CONTAINER::get_available_monitor() {
         }
 
         std::unique_lock<std::mutex> lock(task_map_mutex);
-        if (this->task_map.count(available_monitor) > 0) {
+        if (this->task_map.count(available_monitor) > 0 || this->scheduled_monitors.count(available_monitor) > 0) {
             available_monitor->stop();
             this->task_map.erase(available_monitor);
+            this->scheduled_monitors.erase(available_monitor);
         }
     }
 
@@ -209,11 +242,22 @@ void MONITOR_THREAD_CONTAINER::release_resources() {
             auto monitor = task_pair.first;
             monitor->stop();
         }
+        for (auto const& monitor : scheduled_monitors) {
+            monitor->stop();
+        }
     }
 
     // Wait for monitor threads to finish
     this->thread_pool.stop(true);
 
+    {
+        std::unique_lock<std::mutex> lock(scheduler_mutex);
+        if (this->scheduler) {
+            this->scheduler->stop();
+            this->scheduler.reset();
+        }
+    }
+
     {
         std::unique_lock<std::mutex> lock(monitor_map_mutex);
         this->monitor_map.clear();
@@ -222,6 +266,7 @@ void MONITOR_THREAD_CONTAINER::release_resources() {
     {
         std::unique_lock<std::mutex> lock(task_map_mutex);
         this->task_map.clear();
+        this->scheduled_monitors.clear();
     }
 
     {
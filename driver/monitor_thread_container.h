@@ -32,11 +32,13 @@
 
 #include "connection_handler.h"
 #include "monitor.h"
+#include "monitor_scheduler.h"
 
 #include <ctpl_stl.h>
 #include <future>
 #include <map>
 #include <queue>
+#include <set>
 
 class MONITOR_THREAD_CONTAINER {
 public:
@@ -54,6 +56,7 @@ public:
         std::shared_ptr<CONNECTION_HANDLER> connection_handler,
         bool enable_logging = false);
     virtual void add_task(const std::shared_ptr<MONITOR>& monitor, const std::shared_ptr<MONITOR_SERVICE>& service);
+    void set_scheduler_threads(int num_threads);
     void reset_resource(const std::shared_ptr<MONITOR>& monitor);
     void release_resource(std::shared_ptr<MONITOR> monitor);
 
@@ -75,13 +78,19 @@ protected:
     void release_resources();
 
     std::map<std::string, std::shared_ptr<MONITOR>> monitor_map;
+    // Monitors running on a thread of thread_pool
     std::map<std::shared_ptr<MONITOR>, std::future<void>> task_map;
+    // Monitors checked by the scheduler's workers, guarded by task_map_mutex as well
+    std::set<std::shared_ptr<MONITOR>> scheduled_monitors;
     std::queue<std::shared_ptr<MONITOR>> available_monitors;
     std::mutex monitor_map_mutex;
     std::mutex task_map_mutex;
     std::mutex available_monitors_mutex;
     ctpl::thread_pool thread_pool;
     std::mutex mutex_;
+    // When set, monitors share the scheduler's workers instead of each occupying a pool thread.
+    std::shared_ptr<MONITOR_SCHEDULER> scheduler;
+    std::mutex scheduler_mutex;
 
 #ifdef UNIT_TEST_BUILD
     // Allows for testing private methods
@@ -321,6 +321,7 @@ void free_result_bind(STMT *stmt)
     x_free(stmt->result_bind);
     stmt->result_bind= 0;
     stmt->array.reset();
+    stmt->result_converters.clear();
   }
 }
 
@@ -331,13 +332,32 @@ void ssps_close(STMT *stmt)
   {
     free_result_bind(stmt);
 
+    DBC *dbc= stmt->dbc;
     /*
-      No need to check the result of this operation.
-      It can fail because the connection to the server is lost, which
-      is still ok because the memory is freed anyway.
+      Pending rows have to be discarded before the handle can be executed
+      again. Resetting it also discards data sent with SQLPutData() and
+      closes its cursor, so nothing of this statement is left for the next
+      one. A handle that cannot be reset is not reused.
     */
-    stmt->dbc->connection_proxy->stmt_close(stmt->ssps);
+    if (!stmt->ssps_cache_key.empty() && dbc->ds && dbc->ds->opt_SSPS_CACHE_SIZE > 0 &&
+        stmt->ssps_cache_epoch == dbc->ssps_cache.get_epoch() &&
+        !dbc->connection_proxy->stmt_free_result(stmt->ssps) &&
+        !dbc->connection_proxy->stmt_reset(stmt->ssps))
+    {
+      dbc->ssps_cache.put(stmt->ssps_cache_key, stmt->ssps, stmt->ssps_cache_epoch,
+                          (size_t)dbc->ds->opt_SSPS_CACHE_SIZE, dbc->connection_proxy);
+    }
+    else
+    {
+      /*
+        No need to check the result of this operation.
+        It can fail because the connection to the server is lost, which
+        is still ok because the memory is freed anyway.
+      */
+      dbc->connection_proxy->stmt_close(stmt->ssps);
+    }
     stmt->ssps= NULL;
+    stmt->ssps_cache_key.clear();
     stmt->telemetry.span_end(stmt);
   }
   stmt->buf_set_pos(0);
@@ -621,6 +641,21 @@ char *STMT::add_to_buffer(const char *from, size_t len)
   return tempbuf.add_to_buffer(from, len);
 }
 
+/*
+  Moves the query built in the buffer to send_buf, so that building the
+  next query or query attributes cannot overwrite it while it is executed.
+  The storage is swapped, not copied. The returned query is null-terminated,
+  the terminator is not counted in length.
+*/
+const char *STMT::detach_buf(SQLULEN &length)
+{
+  length = tempbuf.cur_pos;
+  tempbuf.add_to_buffer("", 1);
+  send_buf.swap(tempbuf);
+  tempbuf.reset();
+  return send_buf.buf;
+}
+
 void STMT::free_lengths()
 {
   lengths.reset();
@@ -1435,6 +1470,200 @@ T ssps_get_int64(STMT *stmt, ulong column_number, char *value, ulong length)
 }
 
 
+/* {{{ ssps_get_converter() -I- */
+/*
+  Direct conversions of binary result columns, so integer and date/time
+  values do not need to be formatted into a string and parsed back. They
+  are only used for not NULL values and must give the same results as
+  sql_get_data() does for the same column and C type.
+*/
+template <typename SRC, typename DST>
+static SQLRETURN ssps_convert_integer(STMT *stmt, MYSQL_BIND *col_rbind,
+                                      SQLPOINTER target, SQLLEN *pcbValue)
+{
+  *(DST *)target= (DST)*(SRC *)col_rbind->buffer;
+  *pcbValue= sizeof(DST);
+  return SQL_SUCCESS;
+}
+
+
+template <typename SRC, typename DST>
+static SQLRETURN ssps_convert_real(STMT *stmt, MYSQL_BIND *col_rbind,
+                                   SQLPOINTER target, SQLLEN *pcbValue)
+{
+  /* get_double() result is narrowed the same way */
+  *(DST *)target= (DST)(double)*(SRC *)col_rbind->buffer;
+  *pcbValue= sizeof(DST);
+  return SQL_SUCCESS;
+}
+
+
+static SQLRETURN ssps_convert_timestamp(STMT *stmt, MYSQL_BIND *col_rbind,
+                                        SQLPOINTER target, SQLLEN *pcbValue)
+{
+  MYSQL_TIME           *t= (MYSQL_TIME *)col_rbind->buffer;
+  SQL_TIMESTAMP_STRUCT *ts= (SQL_TIMESTAMP_STRUCT *)target;
+
+  if ((!t->month || !t->day) && !stmt->dbc->ds->opt_ZERO_DATE_TO_MIN)
+  {
+    *pcbValue= SQL_NULL_DATA;  /* ODBC can't handle 0000-00-00 dates */
+    return SQL_SUCCESS;
+  }
+
+  ts->year=     (SQLSMALLINT)t->year;
+  ts->month=    (SQLUSMALLINT)(t->month ? t->month : 1);
+  ts->day=      (SQLUSMALLINT)(t->day ? t->day : 1);
+  ts->hour=     (SQLUSMALLINT)t->hour;
+  ts->minute=   (SQLUSMALLINT)t->minute;
+  ts->second=   (SQLUSMALLINT)t->second;
+  /* Microseconds to nanoseconds */
+  ts->fraction= (SQLUINTEGER)(t->second_part * 1000);
+
+  *pcbValue= sizeof(SQL_TIMESTAMP_STRUCT);
+  return SQL_SUCCESS;
+}
+
+
+static SQLRETURN ssps_convert_date(STMT *stmt, MYSQL_BIND *col_rbind,
+                                   SQLPOINTER target, SQLLEN *pcbValue)
+{
+  MYSQL_TIME      *t= (MYSQL_TIME *)col_rbind->buffer;
+  SQL_DATE_STRUCT *date= (SQL_DATE_STRUCT *)target;
+
+  if ((!t->month || !t->day) && !stmt->dbc->ds->opt_ZERO_DATE_TO_MIN)
+  {
+    *pcbValue= SQL_NULL_DATA;  /* ODBC can't handle 0000-00-00 dates */
+    return SQL_SUCCESS;
+  }
+
+  date->year=  (SQLSMALLINT)t->year;
+  date->month= (SQLUSMALLINT)(t->month ? t->month : 1);
+  date->day=   (SQLUSMALLINT)(t->day ? t->day : 1);
+
+  *pcbValue= sizeof(SQL_DATE_STRUCT);
+  return SQL_SUCCESS;
+}
+
+
+template <typename SRC>
+static ssps_converter integer_converter(SQLSMALLINT c_type)
+{
+  switch (c_type)
+  {
+    case SQL_C_TINYINT:
+    case SQL_C_STINYINT:
+      return ssps_convert_integer<SRC, SQLSCHAR>;
+    case SQL_C_UTINYINT:
+      return ssps_convert_integer<SRC, SQLCHAR>;
+    case SQL_C_SHORT:
+    case SQL_C_SSHORT:
+      return ssps_convert_integer<SRC, SQLSMALLINT>;
+    case SQL_C_USHORT:
+      return ssps_convert_integer<SRC, SQLUSMALLINT>;
+    case SQL_C_LONG:
+    case SQL_C_SLONG:
+      return ssps_convert_integer<SRC, SQLINTEGER>;
+    case SQL_C_ULONG:
+      return ssps_convert_integer<SRC, SQLUINTEGER>;
+    case SQL_C_SBIGINT:
+      return ssps_convert_integer<SRC, longlong>;
+    case SQL_C_UBIGINT:
+      return ssps_convert_integer<SRC, ulonglong>;
+    case SQL_C_FLOAT:
+      return ssps_convert_real<SRC, float>;
+    case SQL_C_DOUBLE:
+      return ssps_convert_real<SRC, double>;
+  }
+
+  return NULL;
+}
+
+
+static ssps_converter select_converter(STMT *stmt, uint column_number,
+                                       SQLSMALLINT c_type)
+{
+  MYSQL_BIND *col_rbind= &stmt->result_bind[column_number];
+  BOOL        is_it_unsigned= col_rbind->is_unsigned != 0;
+
+  if (c_type == SQL_C_DEFAULT)
+  {
+    c_type= unireg_to_c_datatype(
+      stmt->dbc->connection_proxy->fetch_field_direct(stmt->result, column_number));
+  }
+
+  switch (col_rbind->buffer_type)
+  {
+    case MYSQL_TYPE_TINY:
+      return is_it_unsigned ? integer_converter<unsigned char>(c_type)
+                            : integer_converter<signed char>(c_type);
+
+    case MYSQL_TYPE_YEAR:  // fetched as a SMALLINT
+    case MYSQL_TYPE_SHORT:
+      return is_it_unsigned ? integer_converter<unsigned short>(c_type)
+                            : integer_converter<short>(c_type);
+
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+      return is_it_unsigned ? integer_converter<unsigned int>(c_type)
+                            : integer_converter<int>(c_type);
+
+    case MYSQL_TYPE_LONGLONG:
+      return is_it_unsigned ? integer_converter<unsigned long long>(c_type)
+                            : integer_converter<long long>(c_type);
+
+    case MYSQL_TYPE_TIMESTAMP:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_DATE:
+      switch (c_type)
+      {
+        case SQL_C_TIMESTAMP:
+        case SQL_C_TYPE_TIMESTAMP:
+          return ssps_convert_timestamp;
+        case SQL_C_DATE:
+        case SQL_C_TYPE_DATE:
+          return ssps_convert_date;
+      }
+      break;
+
+    /* FLOAT and DOUBLE are fetched as strings, BIT and TIME need the
+       generic conversion */
+    default:
+      break;
+  }
+
+  return NULL;
+}
+
+
+/*
+  Returns the direct converter of the result column to the C type, or NULL
+  if the value has to go through sql_get_data(). The choice is made once
+  per column and C type, and is reset when the result is re-bound.
+*/
+ssps_converter ssps_get_converter(STMT *stmt, uint column_number,
+                                  SQLSMALLINT c_type)
+{
+  auto &converters= stmt->result_converters;
+
+  if (converters.size() != stmt->field_count())
+  {
+    converters.assign(stmt->field_count(),
+                      std::make_pair((SQLSMALLINT)0, (ssps_converter)NULL));
+  }
+
+  auto &entry= converters[column_number];
+
+  if (entry.first != c_type)
+  {
+    entry.first=  c_type;
+    entry.second= select_converter(stmt, column_number, c_type);
+  }
+
+  return entry.second;
+}
+/* }}} */
+
+
 /* {{{ ssps_send_long_data () -I- */
 SQLRETURN ssps_send_long_data(STMT *stmt, unsigned int param_number, const char *chunk,
                             unsigned long length)
@@ -91,10 +91,27 @@ my_bool free_current_result(STMT *stmt)
  */
 static MYSQL_RES* stmt_get_result(STMT *stmt, BOOL force_use)
 {
+  /* Rows already read by an asynchronous call */
+  if (stmt->async.result)
+  {
+    MYSQL_RES *result = stmt->async.result;
+    stmt->async.result = nullptr;
+    return result;
+  }
+
   /* We can't use USE_RESULT because SQLRowCount will fail in this case! */
   if (if_forward_cache(stmt) || force_use)
   {
-    return stmt->dbc->connection_proxy->use_result();
+    MYSQL_RES *result = stmt->dbc->connection_proxy->use_result();
+
+    /* Not when the remaining results are only skipped */
+    if (result && !force_use && stmt->dbc->ds->opt_READ_AHEAD_ROWS > 0)
+    {
+      stmt->read_ahead.reset(new READ_AHEAD(stmt->dbc, result,
+        stmt->dbc->connection_proxy->num_fields(result),
+        (size_t)stmt->dbc->ds->opt_READ_AHEAD_ROWS));
+    }
+    return result;
   }
   else
   {
@@ -108,6 +125,7 @@ static MYSQL_RES* stmt_get_result(STMT *stmt, BOOL force_use)
 MYSQL_RES * get_result_metadata(STMT *stmt, BOOL force_use)
 {
   /* just a precaution, mysql_free_result checks for NULL anywat */
+  stmt->read_ahead.reset();
   stmt->dbc->connection_proxy->free_result(stmt->result);
 
   if (ssps_used(stmt))
@@ -194,6 +212,10 @@ my_ulonglong num_rows(STMT *stmt)
   {
     return offset + stmt->dbc->connection_proxy->stmt_num_rows(stmt->ssps);
   }
+  else if (stmt->read_ahead)
+  {
+    return offset + stmt->read_ahead->num_rows();
+  }
   else
   {
     return offset + stmt->dbc->connection_proxy->num_rows(stmt->result);
@@ -237,6 +259,10 @@ MYSQL_ROW STMT::fetch_row(bool read_unbuffered)
 
     return array;
   }
+  else if (read_ahead)
+  {
+    return read_ahead->fetch_row();
+  }
   else
   {
     return dbc->connection_proxy->fetch_row(result);
@@ -250,6 +276,10 @@ unsigned long* fetch_lengths(STMT *stmt)
   {
     return stmt->result_bind[0].length;
   }
+  else if (stmt->read_ahead)
+  {
+    return stmt->read_ahead->fetch_lengths();
+  }
   else
   {
     return stmt->dbc->connection_proxy->fetch_lengths(stmt->result);
@@ -298,16 +328,89 @@ MYSQL_ROW_OFFSET row_tell(STMT *stmt)
 
 int next_result(STMT *stmt)
 {
+  int rc;
   free_current_result(stmt);
 
   if (ssps_used(stmt))
   {
-    return stmt->dbc->connection_proxy->stmt_next_result(stmt->ssps);
+    rc= stmt->dbc->connection_proxy->stmt_next_result(stmt->ssps);
   }
   else
   {
-    return stmt->dbc->connection_proxy->next_result();
+    rc= stmt->dbc->connection_proxy->next_result();
+  }
+
+  /* Later statements of a batch may start or end a transaction */
+  if (rc == 0)
+  {
+    stmt->dbc->update_transaction_state();
+  }
+
+  return rc;
+}
+
+
+/*
+  next_result() of a directly executed statement that does not wait for the
+  server. Returns NET_ASYNC_NOT_READY until the next result has been read,
+  rc is then set as next_result() returns it.
+*/
+net_async_status next_result_nonblocking(STMT *stmt, int *rc)
+{
+  net_async_status status = NET_ASYNC_COMPLETE;
+
+  if (!stmt->async.pending())
+  {
+    free_current_result(stmt);
+    stmt->async.step = ASYNC_NEXT_RESULT;
+    stmt->dbc->async_stmt = stmt;
+  }
+
+  if (stmt->async.step == ASYNC_NEXT_RESULT)
+  {
+    status = stmt->dbc->connection_proxy->next_result_nonblocking();
+    if (status == NET_ASYNC_COMPLETE)
+    {
+      stmt->dbc->update_transaction_state();
+    }
+  }
+
+  if (status == NET_ASYNC_COMPLETE)
+  {
+    status = store_result_nonblocking(stmt);
+  }
+
+  if (status == NET_ASYNC_NOT_READY)
+  {
+    return status;
+  }
+
+  stmt->async.reset();
+  stmt->dbc->async_stmt = nullptr;
+
+  *rc = status == NET_ASYNC_ERROR ? 1 :
+        status == NET_ASYNC_COMPLETE_NO_MORE_RESULTS ? -1 : 0;
+  return status;
+}
+
+
+/*
+  Reads the rows of the current result without waiting for the server, if
+  the result is to be stored. The result is taken by get_result_metadata()
+  afterwards. Returns NET_ASYNC_NOT_READY until all rows have been read.
+*/
+net_async_status store_result_nonblocking(STMT *stmt)
+{
+  if (stmt->async.step != ASYNC_STORE_RESULT)
+  {
+    if (!stmt->dbc->connection_proxy->field_count() || if_forward_cache(stmt))
+    {
+      return NET_ASYNC_COMPLETE;
+    }
+    stmt->async.step = ASYNC_STORE_RESULT;
   }
+
+  return stmt->dbc->connection_proxy->store_result_nonblocking(&stmt->async.result);
 }
 
 
@@ -422,11 +525,29 @@ SQLRETURN prepare(STMT *stmt, char * query, SQLINTEGER query_length,
   /* Tokenising string, detecting and storing parameters placeholders, removing {}
      So far the only possible error is memory allocation. Thus setting it here.
      If that changes we will need to make "parse" to set error and return rc */
-  if (parse(&stmt->query))
+  bool parse_error;
+  if (stmt->dbc->ds->opt_PARSED_QUERY_CACHE_SIZE > 0)
+  {
+    parse_error= PARSED_QUERY_CACHE::get_instance().parse(
+      &stmt->query, (size_t)stmt->dbc->ds->opt_PARSED_QUERY_CACHE_SIZE);
+  }
+  else
+  {
+    parse_error= parse(&stmt->query);
+  }
+
+  if (parse_error)
   {
     return stmt->set_error( MYERR_S1001, NULL, 4001);
   }
 
+  /* The connection still reads the response to another statement */
+  if (stmt->dbc->async_stmt && stmt->dbc->async_stmt != stmt)
+  {
+    return stmt->set_error(MYERR_S1010, "Another statement of the connection "
+                           "is still executing asynchronously", 0);
+  }
+
   ssps_close(stmt);
   stmt->param_count = (uint)PARAM_COUNT(stmt->query);
   /* Trusting our parsing we are not using prepared statments unsless there are
@@ -436,7 +557,23 @@ SQLRETURN prepare(STMT *stmt, char * query, SQLINTEGER query_length,
       stmt->query.preparable_on_server(stmt->dbc->connection_proxy->get_server_version()))
   {
     MYLOG_STMT_TRACE(stmt, "Using prepared statement");
-    ssps_init(stmt);
+    DBC *dbc= stmt->dbc;
+    bool cached= false;
+
+    /* Reusing a handle the connection has already prepared for the same query */
+    if (dbc->ds->opt_SSPS_CACHE_SIZE > 0 && !stmt->query.get_cursor_name())
+    {
+      stmt->ssps_cache_key= SSPS_CACHE::make_key(query, query_length,
+                                                 dbc->cxn_charset_info->number,
+                                                 dbc->database);
+      stmt->ssps_cache_epoch= dbc->ssps_cache.get_epoch();
+      stmt->ssps= dbc->ssps_cache.take(stmt->ssps_cache_key);
+      stmt->result_bind= 0;
+      cached= stmt->ssps != NULL;
+    }
+
+    if (!cached)
+      ssps_init(stmt);
 
     /* If the query is in the form of "WHERE CURRENT OF" - we do not need to prepare
        it at the moment */
@@ -447,10 +584,13 @@ SQLRETURN prepare(STMT *stmt, char * query, SQLINTEGER query_length,
      if (reset_sql_limit)
         set_sql_select_limit(stmt->dbc, 0, false);
 
-     int prep_res = stmt->dbc->connection_proxy->stmt_prepare(stmt->ssps, query, query_length);
+     int prep_res = cached ? 0 :
+       stmt->dbc->connection_proxy->stmt_prepare(stmt->ssps, query, query_length);
 
      if (prep_res)
       {
+        /* The handle is not prepared, it must not be reused */
+        stmt->ssps_cache_key.clear();
         MYLOG_STMT_TRACE(stmt, stmt->dbc->connection_proxy->error());
 
         stmt->set_error("HY000");
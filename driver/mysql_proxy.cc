@@ -27,11 +27,19 @@
 // along with this program. If not, see
 // http://www.gnu.org/licenses/gpl-2.0.html.
 
+#include "dns_cache.h"
+#include "errmsg.h"
 #include "mysql_proxy.h"
 
 #include <sstream>
 #include <thread>
 
+#ifdef _WIN32
+    #define poll WSAPoll
+#else
+    #include <poll.h>
+#endif
+
 namespace {
     const auto SOCKET_CLOSE_DELAY = std::chrono::milliseconds(100);
 }
@@ -103,6 +111,26 @@ bool MYSQL_PROXY::real_connect(
     const char* db, unsigned int port, const char* unix_socket,
     unsigned long clientflag) {
 
+    // Connect to the cached address of the host so libmysqlclient does not resolve
+    // it again. The proxies above have already seen the host name, and it is kept
+    // when the server certificate has to match it.
+    const bool verify_identity = ds->opt_SSL_MODE &&
+        !myodbc_strcasecmp(ODBC_SSL_MODE_VERIFY_IDENTITY, ds->opt_SSL_MODE);
+    if (ds->opt_CONNECT_BY_CACHED_IP && host && !unix_socket && !verify_identity) {
+        const std::string address = DNS_CACHE::get_instance().get(
+            host, std::chrono::milliseconds(ds->opt_DNS_CACHE_TTL));
+        if (!address.empty()) {
+            if (mysql_real_connect(mysql, address.c_str(), user, passwd, db, port, unix_socket, clientflag)) {
+                return true;
+            }
+            // Errors returned by the server would repeat with the host name
+            if (mysql_errno(mysql) < CR_MIN_ERROR) {
+                return false;
+            }
+            // Otherwise the address may be outdated, fall back to the host name
+        }
+    }
+
     const MYSQL* new_mysql = mysql_real_connect(mysql, host, user, passwd, db, port, unix_socket, clientflag);
     return new_mysql != nullptr;
 }
@@ -123,6 +151,14 @@ MYSQL_RES* MYSQL_PROXY::store_result() {
     return mysql_store_result(mysql);
 }
 
+net_async_status MYSQL_PROXY::real_query_nonblocking(const char* q, unsigned long length) {
+    return mysql_real_query_nonblocking(mysql, q, length);
+}
+
+net_async_status MYSQL_PROXY::store_result_nonblocking(MYSQL_RES** result) {
+    return mysql_store_result_nonblocking(mysql, result);
+}
+
 MYSQL_RES* MYSQL_PROXY::use_result() {
     return mysql_use_result(mysql);
 }
@@ -155,6 +191,10 @@ int MYSQL_PROXY::next_result() {
     return mysql_next_result(mysql);
 }
 
+net_async_status MYSQL_PROXY::next_result_nonblocking() {
+    return mysql_next_result_nonblocking(mysql);
+}
+
 int MYSQL_PROXY::stmt_next_result(MYSQL_STMT* stmt) {
     return mysql_stmt_next_result(stmt);
 }
@@ -411,3 +451,15 @@ void MYSQL_PROXY::close_socket() {
         MYLOG_DBC_TRACE(dbc, "closesocket() with return code: %d, error message: %s,", ret, strerror(socket_errno));
     }
 }
+
+bool MYSQL_PROXY::wait_for_response(int timeout_ms) {
+    const my_socket fd = mysql_get_socket_descriptor(mysql);
+    if (fd == INVALID_SOCKET) {
+        return false;
+    }
+
+    struct pollfd socket_poll{};
+    socket_poll.fd = fd;
+    socket_poll.events = POLLIN;
+    return poll(&socket_poll, 1, timeout_ms) > 0;
+}
@@ -62,6 +62,8 @@ public:
     int query(const char* q) override;
     int real_query(const char* q, unsigned long length) override;
     MYSQL_RES* store_result() override;
+    net_async_status real_query_nonblocking(const char* q, unsigned long length) override;
+    net_async_status store_result_nonblocking(MYSQL_RES** result) override;
     MYSQL_RES* use_result() override;
     struct CHARSET_INFO* get_character_set() const;
     void get_character_set_info(MY_CHARSET_INFO* charset) override;
@@ -117,6 +119,7 @@ public:
     bool autocommit(bool auto_mode) override;
     bool more_results() override;
     int next_result() override;
+    net_async_status next_result_nonblocking() override;
     int stmt_next_result(MYSQL_STMT* stmt) override;
     void close() override;
 
@@ -162,6 +165,8 @@ public:
 
     void close_socket() override;
 
+    bool wait_for_response(int timeout_ms) override;
+
 private:
     MYSQL* mysql = nullptr;
     std::shared_ptr<HOST_INFO> host = nullptr;
@@ -130,15 +130,23 @@ SQLRETURN         my_SQLPrepare (SQLHSTMT hstmt, SQLCHAR *szSqlStr,
                                  bool reset_select_limit,
                                  bool force_prepare);
 SQLRETURN         my_SQLExecute         (STMT * stmt);
+SQLRETURN         my_SQLExecuteAsync    (STMT *stmt, SQLUSMALLINT function);
+void              finish_async_call     (STMT *stmt);
 SQLRETURN SQL_API my_SQLFreeStmt        (SQLHSTMT hstmt,SQLUSMALLINT fOption);
 SQLRETURN SQL_API my_SQLFreeStmtExtended(SQLHSTMT hstmt, SQLUSMALLINT fOption,
                                          SQLUSMALLINT fExtra);
 SQLRETURN SQL_API my_SQLAllocStmt       (SQLHDBC hdbc,SQLHSTMT *phstmt);
-SQLRETURN         do_query              (STMT *stmt, std::string query);
-SQLRETURN         insert_params         (STMT *stmt, SQLULEN row, std::string &finalquery);
+SQLRETURN         do_query              (STMT *stmt, const char *query,
+                                         SQLULEN query_length);
+bool              add_select_limit_hint (STMT *stmt, const char **query,
+                                         SQLULEN *query_length);
+SQLRETURN         insert_params         (STMT *stmt, SQLULEN row,
+                                         const char **finalquery,
+                                         SQLULEN *length);
 void      myodbc_link_fields (STMT *stmt,MYSQL_FIELD *fields,uint field_count);
 void      fix_row_lengths   (STMT *stmt, const long* fix_rules, uint row, uint field_count);
 void      fix_result_types  (STMT *stmt);
+SQLRETURN fill_fetch_buffers(STMT *stmt, MYSQL_ROW values, uint rownum);
 char *    fix_str           (char *to,const char *from,int length);
 char *    dupp_str          (char *from,int length);
 SQLRETURN my_pos_delete_std (STMT *stmt,STMT *stmtParam,
@@ -151,6 +159,8 @@ SQLRETURN insert_param  (STMT *stmt, MYSQL_BIND *bind, DESC *apd,
                         DESCREC *aprec, DESCREC *iprec, SQLULEN row);
 
 SQLRETURN set_sql_select_limit(DBC *dbc, SQLULEN new_value, my_bool reqLock);
+/* Value of max_rows that means no limit, same as 0 */
+extern const SQLULEN sql_select_unlimited;
 SQLRETURN exec_stmt_query(STMT *stmt, const char *query, SQLULEN query_length,
                            my_bool reqLock);
 
@@ -354,6 +364,9 @@ int           got_out_parameters  (STMT *stmt);
 const char    get_identifier_quote(STMT *stmt);
 SQLULEN get_query_timeout(STMT *stmt);
 SQLRETURN set_query_timeout(STMT *stmt, SQLULEN new_value);
+/* max_allowed_packet assumed when the server value is unknown, 1M */
+#define MIN_DEFAULT_MAX_ALLOWED_PACKET (1024L*1024L)
+unsigned long get_max_allowed_packet(STMT *stmt);
 int get_session_variable(STMT *stmt, const char *var, char *result,
                          size_t buf_len);
 
@@ -388,6 +401,8 @@ MYSQL_ROW_OFFSET  row_seek            (STMT *stmt, MYSQL_ROW_OFFSET offset);
 void              data_seek           (STMT *stmt, my_ulonglong offset);
 MYSQL_ROW_OFFSET  row_tell            (STMT *stmt);
 int               next_result         (STMT *stmt);
+net_async_status  next_result_nonblocking(STMT *stmt, int *rc);
+net_async_status  store_result_nonblocking(STMT *stmt);
 SQLRETURN         send_long_data      (STMT *stmt, unsigned int param_num, DESCREC * aprec,
                                       const char *chunk, unsigned long length);
 
@@ -413,6 +428,8 @@ SQLRETURN     prepare     (STMT *stmt, char * query, SQLINTEGER query_length,
 inline
 void stmt_result_free(STMT * stmt)
 {
+  stmt->read_ahead.reset();
+
   if (!stmt->result)
     return;
 
@@ -455,6 +472,8 @@ double ssps_get_double            (STMT *stmt, ulong column_number, char *value,
                                   ulong length);
 char *      ssps_get_string       (STMT *stmt, ulong column_number, char *value,
                                   ulong *length, char * buffer);
+ssps_converter ssps_get_converter (STMT *stmt, uint column_number,
+                                  SQLSMALLINT c_type);
 SQLRETURN   ssps_send_long_data   (STMT *stmt, unsigned int param_num, const char *chunk,
                                   unsigned long length);
 MYSQL_BIND * get_param_bind       (STMT *stmt, unsigned int param_number, int reset);
@@ -50,9 +50,7 @@ static SQLRETURN set_constmt_attr(SQLSMALLINT  HandleType,
     switch (Attribute)
     {
         case SQL_ATTR_ASYNC_ENABLE:
-            if (ValuePtr == (SQLPOINTER) SQL_ASYNC_ENABLE_ON)
-                return set_handle_error(HandleType,Handle,MYERR_01S02,
-                                        "Doesn't support asynchronous, changed to default",0);
+            options->async_enable= ValuePtr == (SQLPOINTER) SQL_ASYNC_ENABLE_ON;
             break;
 
         case SQL_ATTR_CURSOR_SENSITIVITY:
@@ -174,7 +172,8 @@ get_constmt_attr(SQLSMALLINT  HandleType,
     switch (Attribute)
     {
         case SQL_ATTR_ASYNC_ENABLE:
-            *((SQLUINTEGER *) ValuePtr)= SQL_ASYNC_ENABLE_OFF;
+            *((SQLUINTEGER *) ValuePtr)= options->async_enable ?
+                                         SQL_ASYNC_ENABLE_ON : SQL_ASYNC_ENABLE_OFF;
             break;
 
         case SQL_ATTR_CURSOR_SENSITIVITY:
@@ -268,6 +267,14 @@ MySQLSetConnectAttr(SQLHDBC hdbc, SQLINTEGER Attribute,
   switch (Attribute)
   {
     case SQL_ATTR_ACCESS_MODE:
+      {
+        const bool read_only= ValuePtr == (SQLPOINTER) SQL_MODE_READ_ONLY;
+        /* Prepared statements of the other connection should not be reused */
+        if (read_only != dbc->read_only && dbc->ds && dbc->ds->opt_ENABLE_READ_WRITE_SPLITTING &&
+            dbc->connection_proxy)
+          dbc->ssps_cache.clear(dbc->connection_proxy);
+        dbc->read_only= read_only;
+      }
       break;
 
     case SQL_ATTR_AUTOCOMMIT:
@@ -428,6 +435,10 @@ MySQLSetConnectAttr(SQLHDBC hdbc, SQLINTEGER Attribute,
       dbc->need_to_wakeup= 1;
 
       return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
+      dbc->async_dbc_functions= ValuePtr == (SQLPOINTER)SQL_ASYNC_DBC_ENABLE_ON;
+      break;
 #endif
 
     case CB_FIDO_CONNECTION:
@@ -483,13 +494,20 @@ MySQLGetConnectAttr(SQLHDBC hdbc, SQLINTEGER attrib, SQLCHAR **char_attr,
   switch (attrib)
   {
   case SQL_ATTR_ACCESS_MODE:
-    *((SQLUINTEGER *)num_attr)= SQL_MODE_READ_WRITE;
+    *((SQLUINTEGER *)num_attr)= dbc->read_only ? SQL_MODE_READ_ONLY : SQL_MODE_READ_WRITE;
     break;
 
   case SQL_ATTR_AUTO_IPD:
     *((SQLUINTEGER *)num_attr)= SQL_FALSE;
     break;
 
+#ifndef USE_IODBC
+  case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
+    *((SQLUINTEGER *)num_attr)= dbc->async_dbc_functions ?
+                                SQL_ASYNC_DBC_ENABLE_ON : SQL_ASYNC_DBC_ENABLE_OFF;
+    break;
+#endif
+
   case SQL_ATTR_AUTOCOMMIT:
     *((SQLUINTEGER *)num_attr)= (autocommit_on(dbc) ||
                                  (!(trans_supported(dbc)) ?
@@ -35,6 +35,14 @@
 
 #include "driver.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARSE_USE_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 static const MY_QUERY_TYPE query_types_array[]=
 {
   /*myqtSelect*/      {'\1', '\1', NULL},
@@ -204,11 +212,139 @@ MY_PARSED_QUERY &MY_PARSED_QUERY::operator=(const MY_PARSED_QUERY &src)
 }
 
 
+/* Charsets in which bytes below 0x80 are always ASCII characters and are
+   never a part of a multi-byte character */
+static bool is_ascii_superset(CHARSET_INFO *cs)
+{
+  if (cs == NULL || (cs->state & MY_CS_NONASCII))
+  {
+    return false;
+  }
+
+  return cs->mbmaxlen == 1 ||
+         (cs->mbminlen == 1 && strncmp(cs->csname, "utf8", 4) == 0);
+}
+
+
+#ifdef PARSE_USE_SSE2
+static inline int first_set_bit(unsigned int mask)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (int)index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+
+/* Bytes outside of quotes which do not start a quote, a comment, a parameter
+   marker, a query separator or a space */
+static inline bool is_plain_byte(unsigned char c)
+{
+  if (c <= ' ' || c >= 0x7f)
+  {
+    return false;
+  }
+
+  switch (c)
+  {
+    case '\'':
+    case '"':
+    case '`':
+    case '#':
+    case '-':
+    case '/':
+    case '?':
+    case ';':
+    case '\\':
+      return false;
+    default:
+      return true;
+  }
+}
+
+
+/* Returns the first byte in [pos, end) that is not a plain byte */
+static const char *skip_plain_bytes(const char *pos, const char *end)
+{
+#ifdef PARSE_USE_SSE2
+  const __m128i space= _mm_set1_epi8(' ');
+  const __m128i del=   _mm_set1_epi8(0x7f);
+  const __m128i markers[]= {
+    _mm_set1_epi8('\''), _mm_set1_epi8('"'), _mm_set1_epi8('`'),
+    _mm_set1_epi8('#'),  _mm_set1_epi8('-'), _mm_set1_epi8('/'),
+    _mm_set1_epi8('?'),  _mm_set1_epi8(';'), _mm_set1_epi8('\\')
+  };
+
+  while (end - pos >= 16)
+  {
+    const __m128i bytes= _mm_loadu_si128((const __m128i *)pos);
+    /* Bytes from 0x80 are negative and are not greater than the space */
+    __m128i plain= _mm_and_si128(_mm_cmpgt_epi8(bytes, space),
+                                 _mm_cmplt_epi8(bytes, del));
+    for (const __m128i &marker : markers)
+    {
+      plain= _mm_andnot_si128(_mm_cmpeq_epi8(bytes, marker), plain);
+    }
+
+    const unsigned int other= ~(unsigned int)_mm_movemask_epi8(plain) & 0xFFFF;
+    if (other)
+    {
+      return pos + first_set_bit(other);
+    }
+    pos+= 16;
+  }
+#endif
+
+  while (pos < end && is_plain_byte((unsigned char)*pos))
+  {
+    ++pos;
+  }
+
+  return pos;
+}
+
+
+/* Returns the first quote or escape character in [pos, end) */
+static const char *find_quote_or_escape(const char *pos, const char *end,
+                                        char quote)
+{
+#ifdef PARSE_USE_SSE2
+  const __m128i quote_char= _mm_set1_epi8(quote);
+  const __m128i escape_char= _mm_set1_epi8('\\');
+
+  while (end - pos >= 16)
+  {
+    const __m128i bytes= _mm_loadu_si128((const __m128i *)pos);
+    const unsigned int found= (unsigned int)_mm_movemask_epi8(
+      _mm_or_si128(_mm_cmpeq_epi8(bytes, quote_char),
+                   _mm_cmpeq_epi8(bytes, escape_char)));
+    if (found)
+    {
+      return pos + first_set_bit(found);
+    }
+    pos+= 16;
+  }
+#endif
+
+  while (pos < end && *pos != quote && *pos != '\\')
+  {
+    ++pos;
+  }
+
+  return pos;
+}
+
+
 MY_PARSER * init_parser(MY_PARSER * parser, MY_PARSED_QUERY *pq)
 {
   parser->query=  pq;
   parser->pos=    GET_QUERY(pq);
   parser->quote=  NULL;
+  parser->ascii_scan= is_ascii_superset(pq->cs);
 
   get_ctype(parser);
 
@@ -624,6 +760,20 @@ const char * find_closing_quote(MY_PARSER *parser)
   const char *closing_quote = NULL;
   while(END_NOT_REACHED(parser))
   {
+    /* Jumping over the characters that cannot end the quote */
+    if (parser->ascii_scan && parser->quote->bytes == 1)
+    {
+      const char *next= find_quote_or_escape(parser->pos,
+                                             parser->query->query_end,
+                                             parser->quote->str[0]);
+      if (next != parser->pos)
+      {
+        parser->pos= next;
+        get_ctype(parser);
+        continue;
+      }
+    }
+
     if (is_escape(parser))
     {
       step_char(parser);
@@ -739,6 +889,19 @@ BOOL tokenize(MY_PARSER *parser)
     }
     else
     {
+      /* Jumping over a run of characters that only extend the current token */
+      if (parser->ascii_scan)
+      {
+        const char *next= skip_plain_bytes(parser->pos, parser->query->query_end);
+        if (next != parser->pos)
+        {
+          parser->query->last_char= next - 1;
+          parser->pos= next;
+          get_ctype(parser);
+          continue;
+        }
+      }
+
       if (IS_SPACE(parser))
       {
         step_char(parser);
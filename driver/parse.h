@@ -138,6 +138,8 @@ struct tempBuf {
   char *add_to_buffer(char *to, const char *from, size_t len);
   void remove_trail_zeroes();
   void reset();
+  // Exchanges the storage of the buffers without copying the data
+  void swap(tempBuf &b);
 
   operator bool();
 
@@ -186,6 +188,7 @@ typedef struct parser
   BOOL hash_comment;      /* Comment starts with "#" and end with end of line */
   BOOL dash_comment;      /* Comment starts with "-- " and end with end of line  */
   BOOL c_style_comment;   /* C style comment */
+  BOOL ascii_scan;        /* Syntax markers can be searched for byte by byte */
 
   const MY_SYNTAX_MARKERS *syntax;
 } MY_PARSER;
@@ -214,6 +217,7 @@ BOOL              is_escape(MY_PARSER *parser);
 const MY_STRING * is_quote(MY_PARSER *parser);
 BOOL              open_quote(MY_PARSER *parser, const MY_STRING * quote);
 BOOL              is_query_separator(MY_PARSER *parser);
+BOOL              is_comment(MY_PARSER *parser);
 /* Installs position on the character next after closing quote */
 const char *            find_closing_quote(MY_PARSER *parser);
 BOOL              is_param_marker(MY_PARSER *parser);
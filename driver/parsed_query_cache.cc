@@ -0,0 +1,163 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "parsed_query_cache.h"
+
+#include <cstring>
+
+#include "driver.h"
+
+constexpr size_t PARSED_QUERY_CACHE::MAX_QUERY_LENGTH;
+
+PARSED_QUERY_CACHE& PARSED_QUERY_CACHE::get_instance() {
+  static PARSED_QUERY_CACHE instance;
+  return instance;
+}
+
+size_t PARSED_QUERY_CACHE::hash(const char* text, size_t length, unsigned int charset) {
+  // FNV-1a
+  unsigned long long h = 14695981039346656037ULL ^ charset;
+  for (size_t i = 0; i < length; ++i) {
+    h ^= static_cast<unsigned char>(text[i]);
+    h *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(h);
+}
+
+bool PARSED_QUERY_CACHE::parse(MY_PARSED_QUERY* pq, size_t capacity) {
+  const size_t length = GET_QUERY_LENGTH(pq);
+  if (capacity == 0 || pq->query == nullptr || pq->cs == nullptr || length > MAX_QUERY_LENGTH) {
+    return ::parse(pq);
+  }
+
+  const unsigned int charset = pq->cs->number;
+  const size_t key = hash(pq->query, length, charset);
+  if (lookup(pq, key, charset)) {
+    ++hits;
+    return false;
+  }
+  ++misses;
+
+  // parse() may blank out characters of the query, the key is the original text
+  ENTRY entry;
+  entry.key = key;
+  entry.text.assign(pq->query, length);
+  entry.charset = charset;
+
+  if (::parse(pq)) {
+    return true;
+  }
+
+  for (size_t i = 0; i < length; ++i) {
+    if (pq->query[i] != entry.text[i]) {
+      entry.edits.emplace_back(i, pq->query[i]);
+    }
+  }
+  entry.tokens = pq->token2;
+  entry.params = pq->param_pos;
+  entry.query_type = pq->query_type;
+  entry.is_batch = pq->is_batch ? pq->is_batch - pq->query : -1;
+  entry.last_char = pq->last_char ? pq->last_char - pq->query : -1;
+
+  store(key, std::move(entry), capacity);
+  return false;
+}
+
+bool PARSED_QUERY_CACHE::lookup(MY_PARSED_QUERY* pq, size_t key, unsigned int charset) {
+  const size_t length = GET_QUERY_LENGTH(pq);
+
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  const auto range = entries.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    const ENTRY& entry = *it->second;
+    if (entry.charset != charset || entry.text.size() != length ||
+        memcmp(entry.text.data(), pq->query, length) != 0) {
+      continue;
+    }
+
+    char* query = const_cast<char*>(pq->query);
+    for (const auto& edit : entry.edits) {
+      query[edit.first] = edit.second;
+    }
+    pq->token2 = entry.tokens;
+    pq->param_pos = entry.params;
+    pq->query_type = static_cast<QUERY_TYPE_ENUM>(entry.query_type);
+    pq->is_batch = entry.is_batch < 0 ? nullptr : pq->query + entry.is_batch;
+    pq->last_char = entry.last_char < 0 ? nullptr : pq->query + entry.last_char;
+
+    lru.splice(lru.begin(), lru, it->second);
+    return true;
+  }
+
+  return false;
+}
+
+void PARSED_QUERY_CACHE::store(size_t key, ENTRY entry, size_t capacity) {
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  if (capacity > max_size) {
+    max_size = capacity;
+  }
+
+  // Another thread may have parsed the same query meanwhile
+  const auto range = entries.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->charset == entry.charset && it->second->text == entry.text) {
+      return;
+    }
+  }
+
+  lru.push_front(std::move(entry));
+  entries.emplace(key, lru.begin());
+
+  while (lru.size() > max_size) {
+    const auto& oldest = lru.back();
+    const auto old_range = entries.equal_range(oldest.key);
+    for (auto it = old_range.first; it != old_range.second; ++it) {
+      if (it->second == std::prev(lru.end())) {
+        entries.erase(it);
+        break;
+      }
+    }
+    lru.pop_back();
+  }
+}
+
+void PARSED_QUERY_CACHE::clear() {
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  entries.clear();
+  lru.clear();
+  max_size = 0;
+  hits = 0;
+  misses = 0;
+}
+
+size_t PARSED_QUERY_CACHE::size() {
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  return lru.size();
+}
@@ -0,0 +1,100 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __PARSED_QUERY_CACHE_H__
+#define __PARSED_QUERY_CACHE_H__
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct MY_PARSED_QUERY;
+
+/*
+  Process-wide cache of parse() results. The key is the query text and the
+  character set it was tokenized in. The value holds the token and parameter
+  offsets, the query type and the batch position. On a hit these are copied
+  into the MY_PARSED_QUERY instead of tokenizing the query again.
+
+  The least recently used entries are evicted once the cache holds more than
+  its capacity. The capacity is the largest one requested by any connection.
+*/
+class PARSED_QUERY_CACHE {
+ public:
+  // Longer queries are parsed every time rather than kept in the cache
+  static constexpr size_t MAX_QUERY_LENGTH = 64 * 1024;
+
+  static PARSED_QUERY_CACHE& get_instance();
+
+  PARSED_QUERY_CACHE() = default;
+  PARSED_QUERY_CACHE(const PARSED_QUERY_CACHE&) = delete;
+  PARSED_QUERY_CACHE& operator=(const PARSED_QUERY_CACHE&) = delete;
+
+  /* Same as parse(), returns TRUE on error */
+  bool parse(MY_PARSED_QUERY* pq, size_t capacity);
+  void clear();
+
+  unsigned long long get_hits() const { return hits.load(); }
+  unsigned long long get_misses() const { return misses.load(); }
+  size_t size();
+
+ private:
+  struct ENTRY {
+    size_t key = 0;
+    std::string text;
+    unsigned int charset = 0;
+    std::vector<unsigned int> tokens;
+    std::vector<unsigned int> params;
+    int query_type = 0;
+    // Offsets into the query, -1 when not set
+    long long is_batch = -1;
+    long long last_char = -1;
+    // Characters replaced while parsing, e.g. the braces of an ODBC escape
+    std::vector<std::pair<size_t, char>> edits;
+  };
+
+  static size_t hash(const char* text, size_t length, unsigned int charset);
+  bool lookup(MY_PARSED_QUERY* pq, size_t key, unsigned int charset);
+  void store(size_t key, ENTRY entry, size_t capacity);
+
+  std::mutex cache_mutex;
+  // Most recently used entries first
+  std::list<ENTRY> lru;
+  // Hash of the text and charset, collisions are told apart by comparing the text
+  std::unordered_multimap<size_t, std::list<ENTRY>::iterator> entries;
+  size_t max_size = 0;
+  std::atomic<unsigned long long> hits{0};
+  std::atomic<unsigned long long> misses{0};
+};
+
+#endif /* __PARSED_QUERY_CACHE_H__ */
@@ -29,181 +29,343 @@
 
 #include "rds_utils.h"
 
+#include <cstring>
+
 namespace {
-const std::regex AURORA_DNS_PATTERN(
-    R"#((.+)\.(proxy-|cluster-|cluster-ro-|cluster-custom-)?([a-zA-Z0-9]+\.([a-zA-Z0-9\-]+)\.rds\.amazonaws\.com))#",
-    std::regex_constants::icase);
-const std::regex AURORA_PROXY_DNS_PATTERN(R"#((.+)\.(proxy-)+([a-zA-Z0-9]+\.[a-zA-Z0-9\-]+\.rds\.amazonaws\.com))#",
-                                          std::regex_constants::icase);
-const std::regex AURORA_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-|cluster-ro-)+([a-zA-Z0-9]+\.[a-zA-Z0-9\-]+\.rds\.amazonaws\.com))#",
-    std::regex_constants::icase);
-const std::regex AURORA_WRITER_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-)+([a-zA-Z0-9]+\.[a-zA-Z0-9\-]+\.rds\.amazonaws\.com))#", std::regex_constants::icase);
-const std::regex AURORA_READER_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-ro-)+([a-zA-Z0-9]+\.[a-zA-Z0-9\-]+\.rds\.amazonaws\.com))#", std::regex_constants::icase);
-const std::regex AURORA_CUSTOM_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-custom-)+([a-zA-Z0-9]+\.[a-zA-Z0-9\-]+\.rds\.amazonaws\.com))#", std::regex_constants::icase);
-const std::regex AURORA_CHINA_DNS_PATTERN(
-    R"#((.+)\.(proxy-|cluster-|cluster-ro-|cluster-custom-)?([a-zA-Z0-9]+\.(rds\.[a-zA-Z0-9\-]+|[a-zA-Z0-9\-]+\.rds)\.amazonaws\.com\.cn))#",
-    std::regex_constants::icase);
-const std::regex AURORA_CHINA_PROXY_DNS_PATTERN(
-    R"#((.+)\.(proxy-)+([a-zA-Z0-9]+\.(rds\.[a-zA-Z0-9\-]+|[a-zA-Z0-9\-]+\.rds)\.amazonaws\.com\.cn))#",
-    std::regex_constants::icase);
-const std::regex AURORA_CHINA_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-|cluster-ro-)+([a-zA-Z0-9]+\.(rds\.[a-zA-Z0-9\-]+|[a-zA-Z0-9\-]+\.rds)\.amazonaws\.com\.cn))#",
-    std::regex_constants::icase);
-const std::regex AURORA_CHINA_WRITER_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-)+([a-zA-Z0-9]+\.(rds\.[a-zA-Z0-9\-]+|[a-zA-Z0-9\-]+\.rds)\.amazonaws\.com\.cn))#",
-    std::regex_constants::icase);
-const std::regex AURORA_CHINA_READER_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-ro-)+([a-zA-Z0-9]+\.(rds\.[a-zA-Z0-9\-]+|[a-zA-Z0-9\-]+\.rds)\.amazonaws\.com\.cn))#",
-    std::regex_constants::icase);
-const std::regex AURORA_CHINA_CUSTOM_CLUSTER_PATTERN(
-    R"#((.+)\.(cluster-custom-)+([a-zA-Z0-9]+\.(rds\.[a-zA-Z0-9\-]+|[a-zA-Z0-9\-]+\.rds)\.amazonaws\.com\.cn))#",
-    std::regex_constants::icase);
-const std::regex IPV4_PATTERN(
-    R"#(^(([1-9]|[1-9][0-9]|1[0-9]{2}|2[0-4][0-9]|25[0-5])\.){1}(([0-9]|[1-9][0-9]|1[0-9]{2}|2[0-4][0-9]|25[0-5])\.){2}([0-9]|[1-9][0-9]|1[0-9]{2}|2[0-4][0-9]|25[0-5])$)#");
-const std::regex IPV6_PATTERN(R"#(^[0-9a-fA-F]{1,4}(:[0-9a-fA-F]{1,4}){7}$)#");
-const std::regex IPV6_COMPRESSED_PATTERN(
-    R"#(^(([0-9A-Fa-f]{1,4}(:[0-9A-Fa-f]{1,4}){0,5})?)::(([0-9A-Fa-f]{1,4}(:[0-9A-Fa-f]{1,4}){0,5})?)$)#");
-}  // namespace
+// Endpoints look like <name>.<prefix><id>.<region>.rds.amazonaws.com, or
+// <name>.<prefix><id>.rds.<region>.amazonaws.com.cn and
+// <name>.<prefix><id>.<region>.rds.amazonaws.com.cn in China. Names are
+// matched without regard to case. The parser accepts the same host names as
+// the regular expressions it replaces, and returns the same parts.
+const char STANDARD_SUFFIX[] = "rds.amazonaws.com";
+const char CHINA_SUFFIX[] = "amazonaws.com.cn";
 
-bool RDS_UTILS::is_dns_pattern_valid(std::string host) { return (host.find("?") != std::string::npos); }
+enum PREFIX_KIND { NO_PREFIX, PROXY_PREFIX, WRITER_PREFIX, READER_PREFIX, CUSTOM_PREFIX, MIXED_CLUSTER_PREFIX, OTHER_PREFIX };
 
-bool RDS_UTILS::is_rds_dns(std::string host) {
-  return std::regex_match(host, AURORA_DNS_PATTERN) || std::regex_match(host, AURORA_CHINA_DNS_PATTERN);
-}
+struct SUFFIX_MATCH {
+  size_t name_begin = 0;    // start of the line
+  size_t name_end = 0;      // the dot ending the name
+  size_t id_begin = 0;      // after the prefix
+  size_t end = 0;           // after the suffix
+  size_t region_begin = 0;
+  size_t region_end = 0;
+  PREFIX_KIND prefix = NO_PREFIX;
+  int prefix_tokens = 0;
+};
 
-bool RDS_UTILS::is_rds_cluster_dns(std::string host) {
-  return std::regex_match(host, AURORA_CLUSTER_PATTERN) || std::regex_match(host, AURORA_CHINA_CLUSTER_PATTERN);
-}
+// Matches found in a host name for one partition
+struct PARTITION_MATCHES {
+  bool has_dns_match = false;      // first match with at most one prefix
+  SUFFIX_MATCH dns_match;
+  bool has_cluster_match = false;  // first match with cluster- and cluster-ro- prefixes
+  SUFFIX_MATCH cluster_match;
+  bool has_full_match = false;     // match of the whole host name
+  SUFFIX_MATCH full_match;
+};
 
-bool RDS_UTILS::is_rds_proxy_dns(std::string host) {
-  return std::regex_match(host, AURORA_PROXY_DNS_PATTERN) || std::regex_match(host, AURORA_CHINA_PROXY_DNS_PATTERN);
-}
+inline char lower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+inline bool is_alnum(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'); }
+inline bool is_label_char(char c) { return is_alnum(c) || c == '-'; }
+inline bool is_hex(char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+inline bool is_line_break(char c) { return c == '\n' || c == '\r'; }
 
-bool RDS_UTILS::is_rds_writer_cluster_dns(std::string host) {
-  return std::regex_match(host, AURORA_WRITER_CLUSTER_PATTERN) ||
-         std::regex_match(host, AURORA_CHINA_WRITER_CLUSTER_PATTERN);
+// Case insensitive comparison of host[pos, pos + strlen(literal)) with the literal
+bool matches_at(const std::string& host, size_t pos, const char* literal, size_t length) {
+  if (pos + length > host.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (lower(host[pos + i]) != literal[i]) {
+      return false;
+    }
+  }
+  return true;
 }
 
-bool RDS_UTILS::is_rds_reader_cluster_dns(std::string host) {
-  return std::regex_match(host, AURORA_READER_CLUSTER_PATTERN) ||
-         std::regex_match(host, AURORA_CHINA_READER_CLUSTER_PATTERN);
+// Position of the next dot of the label starting at pos, npos if a character
+// outside of [a-zA-Z0-9-] or the end of the host is found first
+size_t label_end(const std::string& host, size_t pos, size_t limit) {
+  size_t i = pos;
+  while (i < limit && is_label_char(host[i])) {
+    i++;
+  }
+  return (i > pos && i < limit && host[i] == '.') ? i : std::string::npos;
 }
 
-bool RDS_UTILS::is_rds_custom_cluster_dns(std::string host) {
-  return std::regex_match(host, AURORA_CUSTOM_CLUSTER_PATTERN) ||
-         std::regex_match(host, AURORA_CHINA_CUSTOM_CLUSTER_PATTERN);
-}
+// Splits proxy-, cluster-, cluster-ro- and cluster-custom- off the label
+void parse_prefix(const std::string& host, size_t begin, size_t end, SUFFIX_MATCH& match) {
+  static const struct {
+    const char* text;
+    PREFIX_KIND kind;
+  } TOKENS[] = {{"cluster-custom-", CUSTOM_PREFIX},
+                {"cluster-ro-", READER_PREFIX},
+                {"cluster-", WRITER_PREFIX},
+                {"proxy-", PROXY_PREFIX}};
 
-#if defined(__APPLE__) || defined(__linux__)
-#define strcmp_case_insensitive(str1, str2) strcasecmp(str1, str2)
-#else
-#define strcmp_case_insensitive(str1, str2) strcmpi(str1, str2)
-#endif
-
-std::string RDS_UTILS::get_rds_cluster_host_url(std::string host) {
-  auto f = [host](const std::regex pattern) {
-    std::smatch m;
-    if (std::regex_search(host, m, pattern) && m.size() > 1) {
-      std::string gr1 = m.size() > 1 ? m.str(1) : std::string("");
-      std::string gr2 = m.size() > 2 ? m.str(2) : std::string("");
-      std::string gr3 = m.size() > 3 ? m.str(3) : std::string("");
-      if (!gr1.empty() && !gr3.empty() &&
-          (strcmp_case_insensitive(gr2.c_str(), "cluster-") == 0 ||
-           strcmp_case_insensitive(gr2.c_str(), "cluster-ro-") == 0)) {
-        std::string result;
-        result.assign(gr1);
-        result.append(".cluster-");
-        result.append(gr3);
-
-        return result;
+  PREFIX_KIND kind = NO_PREFIX;
+  int tokens = 0;
+  size_t pos = begin;
+  while (pos < end) {
+    bool found = false;
+    for (const auto& token : TOKENS) {
+      const size_t length = strlen(token.text);
+      if (pos + length <= end && matches_at(host, pos, token.text, length)) {
+        if (kind == NO_PREFIX || kind == token.kind) {
+          kind = token.kind;
+        } else if ((kind == WRITER_PREFIX || kind == READER_PREFIX || kind == MIXED_CLUSTER_PREFIX) &&
+                   (token.kind == WRITER_PREFIX || token.kind == READER_PREFIX)) {
+          kind = MIXED_CLUSTER_PREFIX;
+        } else {
+          kind = OTHER_PREFIX;
+        }
+        tokens++;
+        pos += length;
+        found = true;
+        break;
       }
     }
-    return std::string();
-  };
-
-  auto result = f(AURORA_CLUSTER_PATTERN);
-  if (!result.empty()) {
-    return result;
+    if (!found) {
+      break;
+    }
   }
 
-  return f(AURORA_CHINA_CLUSTER_PATTERN);
+  match.prefix = kind;
+  match.prefix_tokens = tokens;
+  match.id_begin = pos;
 }
 
-std::string RDS_UTILS::get_rds_cluster_id(std::string host) {
-  auto f = [host](const std::regex pattern) {
-    std::smatch m;
-    if (std::regex_search(host, m, pattern) && m.size() > 1 && !m.str(2).empty()) {
-      return m.str(1);
-    }
-    return std::string();
-  };
+// Matches <prefix><id>.<region>.rds.amazonaws.com or its China counterparts
+// at pos. The host may continue after the suffix.
+bool match_suffix(const std::string& host, size_t pos, size_t limit, bool china, SUFFIX_MATCH& match) {
+  const size_t first_end = label_end(host, pos, limit);
+  if (first_end == std::string::npos) {
+    return false;
+  }
 
-  auto result = f(AURORA_DNS_PATTERN);
-  if (!result.empty()) {
-    return result;
+  // The id is the alphanumeric part after the last hyphen of the label
+  size_t id_begin = first_end;
+  while (id_begin > pos && is_alnum(host[id_begin - 1])) {
+    id_begin--;
+  }
+  if (id_begin == first_end) {
+    return false;
+  }
+  parse_prefix(host, pos, id_begin, match);
+  if (match.id_begin != id_begin) {
+    return false;
   }
 
-  return f(AURORA_CHINA_DNS_PATTERN);
+  const size_t second_end = label_end(host, first_end + 1, limit);
+  if (second_end == std::string::npos) {
+    return false;
+  }
+
+  size_t suffix_begin = second_end + 1;
+  match.region_begin = first_end + 1;
+  if (china) {
+    const size_t third_end = label_end(host, second_end + 1, limit);
+    if (third_end == std::string::npos) {
+      return false;
+    }
+    // Either rds.<region> or <region>.rds
+    if (!(second_end - first_end - 1 == 3 && matches_at(host, first_end + 1, "rds", 3)) &&
+        !(third_end - second_end - 1 == 3 && matches_at(host, second_end + 1, "rds", 3))) {
+      return false;
+    }
+    match.region_end = third_end;
+    suffix_begin = third_end + 1;
+    if (!matches_at(host, suffix_begin, CHINA_SUFFIX, sizeof(CHINA_SUFFIX) - 1)) {
+      return false;
+    }
+    match.end = suffix_begin + sizeof(CHINA_SUFFIX) - 1;
+  } else {
+    match.region_end = second_end;
+    if (!matches_at(host, suffix_begin, STANDARD_SUFFIX, sizeof(STANDARD_SUFFIX) - 1)) {
+      return false;
+    }
+    match.end = suffix_begin + sizeof(STANDARD_SUFFIX) - 1;
+  }
+
+  match.name_end = pos - 1;
+  return true;
+}
+
+bool is_cluster_prefix(PREFIX_KIND kind) {
+  return kind == WRITER_PREFIX || kind == READER_PREFIX || kind == MIXED_CLUSTER_PREFIX;
 }
 
-std::string RDS_UTILS::get_rds_instance_id(std::string host) {
-  auto f = [host](const std::regex pattern) {
-    std::smatch m;
-    if (std::regex_search(host, m, pattern) && m.size() > 1 && m.str(2).empty()) {
-      return m.str(1);
+// Finds the matches the way a regular expression search does: the first line
+// with a match, and in it the longest name
+PARTITION_MATCHES find_matches(const std::string& host, bool china) {
+  PARTITION_MATCHES result;
+  size_t line_begin = 0;
+  while (line_begin < host.size() && !(result.has_dns_match && result.has_cluster_match)) {
+    size_t line_end = line_begin;
+    while (line_end < host.size() && !is_line_break(host[line_end])) {
+      line_end++;
     }
-    return std::string();
-  };
 
-  auto result = f(AURORA_DNS_PATTERN);
-  if (!result.empty()) {
-    return result;
+    // The name before the dot can't be empty
+    for (size_t dot = line_end; dot > line_begin + 1; dot--) {
+      const size_t pos = dot - 1;
+      SUFFIX_MATCH match;
+      if (host[pos] != '.' || !match_suffix(host, pos + 1, line_end, china, match)) {
+        continue;
+      }
+      match.name_begin = line_begin;
+      if (!result.has_dns_match && match.prefix_tokens <= 1) {
+        result.has_dns_match = true;
+        result.dns_match = match;
+      }
+      if (!result.has_cluster_match && is_cluster_prefix(match.prefix)) {
+        result.has_cluster_match = true;
+        result.cluster_match = match;
+      }
+      if (line_begin == 0 && line_end == host.size() && match.end == host.size()) {
+        result.has_full_match = true;
+        result.full_match = match;
+      }
+    }
+    line_begin = line_end + 1;
   }
-
-  return f(AURORA_CHINA_DNS_PATTERN);
+  return result;
 }
-std::string RDS_UTILS::get_rds_instance_host_pattern(std::string host) {
-  auto f = [host](const std::regex pattern) {
-    std::smatch m;
-    if (std::regex_search(host, m, pattern) && m.size() > 4 && !m.str(3).empty()) {
-      std::string result("?.");
-      result.append(m.str(3));
 
-      return result;
+bool is_ipv4_address(const std::string& host) {
+  size_t pos = 0;
+  for (int octet = 0; octet < 4; octet++) {
+    if (octet > 0) {
+      if (pos >= host.size() || host[pos] != '.') {
+        return false;
+      }
+      pos++;
     }
-    return std::string();
-  };
+    const size_t begin = pos;
+    int value = 0;
+    while (pos < host.size() && pos - begin < 3 && host[pos] >= '0' && host[pos] <= '9') {
+      value = value * 10 + (host[pos] - '0');
+      pos++;
+    }
+    const size_t digits = pos - begin;
+    // No leading zeros, and the first octet isn't 0
+    if (digits == 0 || value > 255 || (digits > 1 && host[begin] == '0') || (octet == 0 && value == 0)) {
+      return false;
+    }
+  }
+  return pos == host.size();
+}
 
-  auto result = f(AURORA_DNS_PATTERN);
-  if (!result.empty()) {
-    return result;
+// Number of colon separated groups of 1 to 4 hex digits in host[begin, end), -1 if malformed
+int count_hex_groups(const std::string& host, size_t begin, size_t end) {
+  if (begin == end) {
+    return 0;
+  }
+  int groups = 0;
+  size_t pos = begin;
+  while (true) {
+    const size_t group_begin = pos;
+    while (pos < end && pos - group_begin < 4 && is_hex(host[pos])) {
+      pos++;
+    }
+    if (pos == group_begin) {
+      return -1;
+    }
+    groups++;
+    if (pos == end) {
+      return groups;
+    }
+    if (host[pos] != ':') {
+      return -1;
+    }
+    pos++;
   }
+}
 
-  return f(AURORA_CHINA_DNS_PATTERN);
+bool is_ipv6_address(const std::string& host) {
+  const size_t compressed = host.find("::");
+  if (compressed == std::string::npos) {
+    return count_hex_groups(host, 0, host.size()) == 8;
+  }
+  const int before = count_hex_groups(host, 0, compressed);
+  const int after = count_hex_groups(host, compressed + 2, host.size());
+  return before >= 0 && before <= 6 && after >= 0 && after <= 6;
 }
+}  // namespace
 
-std::string RDS_UTILS::get_rds_region(std::string host) {
-  auto f = [host](const std::regex pattern) {
-    std::smatch m;
-    if (std::regex_search(host, m, pattern) && m.size() > 4 && !m.str(4).empty()) {
-      return m.str(4);
+RDS_ENDPOINT RDS_UTILS::parse_endpoint(const std::string& host) {
+  RDS_ENDPOINT endpoint;
+
+  const PARTITION_MATCHES partitions[] = {find_matches(host, false), find_matches(host, true)};
+  for (const auto& matches : partitions) {
+    const bool china = &matches == &partitions[1];
+
+    if (matches.has_full_match) {
+      const SUFFIX_MATCH& match = matches.full_match;
+      endpoint.is_rds |= match.prefix_tokens <= 1;
+      endpoint.is_proxy |= match.prefix == PROXY_PREFIX;
+      endpoint.is_cluster |= is_cluster_prefix(match.prefix);
+      endpoint.is_writer_cluster |= match.prefix == WRITER_PREFIX;
+      endpoint.is_reader_cluster |= match.prefix == READER_PREFIX;
+      endpoint.is_custom_cluster |= match.prefix == CUSTOM_PREFIX;
+      endpoint.is_china |= china;
     }
-    return std::string();
-  };
 
-  auto result = f(AURORA_DNS_PATTERN);
-  if (!result.empty()) {
-    return result;
+    // Parts are taken from the standard partition first, as long as they are found in it
+    if (matches.has_dns_match) {
+      const SUFFIX_MATCH& match = matches.dns_match;
+      const std::string name = host.substr(match.name_begin, match.name_end - match.name_begin);
+      if (match.prefix == NO_PREFIX) {
+        if (endpoint.instance_id.empty()) {
+          endpoint.instance_id = name;
+        }
+      } else if (endpoint.cluster_id.empty()) {
+        endpoint.cluster_id = name;
+      }
+      if (endpoint.instance_host_pattern.empty()) {
+        endpoint.instance_host_pattern = "?." + host.substr(match.id_begin, match.end - match.id_begin);
+      }
+      if (endpoint.region.empty()) {
+        endpoint.region = host.substr(match.region_begin, match.region_end - match.region_begin);
+      }
+    }
+    if (matches.has_cluster_match && endpoint.cluster_host_url.empty()) {
+      const SUFFIX_MATCH& match = matches.cluster_match;
+      endpoint.cluster_host_url = host.substr(match.name_begin, match.name_end - match.name_begin) +
+                                  ".cluster-" + host.substr(match.id_begin, match.end - match.id_begin);
+    }
   }
 
-  return f(AURORA_CHINA_DNS_PATTERN);
+  endpoint.is_ipv4 = is_ipv4_address(host);
+  endpoint.is_ipv6 = is_ipv6_address(host);
+  return endpoint;
 }
 
-bool RDS_UTILS::is_ipv4(std::string host) { return std::regex_match(host, IPV4_PATTERN); }
-bool RDS_UTILS::is_ipv6(std::string host) {
-  return std::regex_match(host, IPV6_PATTERN) || std::regex_match(host, IPV6_COMPRESSED_PATTERN);
+bool RDS_UTILS::is_dns_pattern_valid(const std::string& host) { return (host.find("?") != std::string::npos); }
+
+bool RDS_UTILS::is_rds_dns(const std::string& host) { return parse_endpoint(host).is_rds; }
+
+bool RDS_UTILS::is_rds_cluster_dns(const std::string& host) { return parse_endpoint(host).is_cluster; }
+
+bool RDS_UTILS::is_rds_proxy_dns(const std::string& host) { return parse_endpoint(host).is_proxy; }
+
+bool RDS_UTILS::is_rds_writer_cluster_dns(const std::string& host) { return parse_endpoint(host).is_writer_cluster; }
+
+bool RDS_UTILS::is_rds_reader_cluster_dns(const std::string& host) { return parse_endpoint(host).is_reader_cluster; }
+
+bool RDS_UTILS::is_rds_custom_cluster_dns(const std::string& host) { return parse_endpoint(host).is_custom_cluster; }
+
+std::string RDS_UTILS::get_rds_cluster_host_url(const std::string& host) { return parse_endpoint(host).cluster_host_url; }
+
+std::string RDS_UTILS::get_rds_cluster_id(const std::string& host) { return parse_endpoint(host).cluster_id; }
+
+std::string RDS_UTILS::get_rds_instance_id(const std::string& host) { return parse_endpoint(host).instance_id; }
+
+std::string RDS_UTILS::get_rds_instance_host_pattern(const std::string& host) {
+  return parse_endpoint(host).instance_host_pattern;
 }
+
+std::string RDS_UTILS::get_rds_region(const std::string& host) { return parse_endpoint(host).region; }
+
+bool RDS_UTILS::is_ipv4(const std::string& host) { return is_ipv4_address(host); }
+
+bool RDS_UTILS::is_ipv6(const std::string& host) { return is_ipv6_address(host); }
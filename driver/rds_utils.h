@@ -30,25 +30,47 @@
 #ifndef __RDS_UTILS__
 #define __RDS_UTILS__
 
-#include <regex>
+#include <string>
+
+// What a host name is, as far as the Aurora and RDS Proxy endpoint formats go
+struct RDS_ENDPOINT {
+  bool is_rds = false;             // instance, cluster or proxy endpoint
+  bool is_proxy = false;
+  bool is_cluster = false;         // writer or reader cluster endpoint
+  bool is_writer_cluster = false;
+  bool is_reader_cluster = false;
+  bool is_custom_cluster = false;
+  bool is_china = false;           // endpoint in the amazonaws.com.cn partition
+  bool is_ipv4 = false;
+  bool is_ipv6 = false;
+
+  std::string instance_id;
+  std::string cluster_id;
+  std::string cluster_host_url;       // writer cluster endpoint of the same cluster
+  std::string instance_host_pattern;  // instance endpoints, with '?' for the instance
+  std::string region;
+};
 
 class RDS_UTILS {
  public:
-  static bool is_dns_pattern_valid(std::string host);
-  static bool is_rds_dns(std::string host);
-  static bool is_rds_cluster_dns(std::string host);
-  static bool is_rds_proxy_dns(std::string host);
-  static bool is_rds_writer_cluster_dns(std::string host);
-  static bool is_rds_reader_cluster_dns(std::string host);
-  static bool is_rds_custom_cluster_dns(std::string host);
-  static bool is_ipv4(std::string host);
-  static bool is_ipv6(std::string host);
-
-  static std::string get_rds_cluster_host_url(std::string host);
-  static std::string get_rds_cluster_id(std::string host);
-  static std::string get_rds_instance_host_pattern(std::string host);
-  static std::string get_rds_instance_id(std::string host);
-  static std::string get_rds_region(std::string host);
+  // Classifies the host in one pass over it, the functions below use it
+  static RDS_ENDPOINT parse_endpoint(const std::string& host);
+
+  static bool is_dns_pattern_valid(const std::string& host);
+  static bool is_rds_dns(const std::string& host);
+  static bool is_rds_cluster_dns(const std::string& host);
+  static bool is_rds_proxy_dns(const std::string& host);
+  static bool is_rds_writer_cluster_dns(const std::string& host);
+  static bool is_rds_reader_cluster_dns(const std::string& host);
+  static bool is_rds_custom_cluster_dns(const std::string& host);
+  static bool is_ipv4(const std::string& host);
+  static bool is_ipv6(const std::string& host);
+
+  static std::string get_rds_cluster_host_url(const std::string& host);
+  static std::string get_rds_cluster_id(const std::string& host);
+  static std::string get_rds_instance_host_pattern(const std::string& host);
+  static std::string get_rds_instance_id(const std::string& host);
+  static std::string get_rds_region(const std::string& host);
 };
 
 #endif
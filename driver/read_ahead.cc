@@ -0,0 +1,207 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "read_ahead.h"
+
+#include <cstring>
+
+#include "driver.h"
+
+constexpr size_t READ_AHEAD::BATCHES;
+constexpr size_t READ_AHEAD::NULL_VALUE;
+
+READ_AHEAD::READ_AHEAD(DBC* dbc, MYSQL_RES* result, unsigned int field_count, size_t max_rows)
+    : dbc(dbc),
+      result(result),
+      field_count(field_count),
+      batch_rows(max_rows > BATCHES ? (max_rows + BATCHES - 1) / BATCHES : 1),
+      row(field_count + 1, nullptr) {
+  worker = std::thread(&READ_AHEAD::read_rows, this);
+}
+
+READ_AHEAD::~READ_AHEAD() { stop(); }
+
+void READ_AHEAD::BATCH::clear() {
+  data.clear();
+  offsets.clear();
+  lengths.clear();
+  rows = 0;
+}
+
+void READ_AHEAD::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  batch_free.notify_one();
+  dbc->lock.notify_waiters();
+
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+MYSQL_ROW READ_AHEAD::fetch_row() {
+  if (current_row == current.rows) {
+    /*
+      The worker can't read while the application holds the connection lock,
+      as in SQLSetPos(). Rather than wait for it, stop it and read the rows
+      left directly from the result.
+    */
+    if (!stopping && dbc->lock.owned_by_this_thread()) {
+      std::unique_lock<std::mutex> lock(mutex);
+      const bool wait = filled.empty() && !done;
+      lock.unlock();
+      if (wait) {
+        stop();
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    lengths = nullptr;
+    if (current.rows) {
+      spare.push_back(std::move(current));
+      current = BATCH();
+    }
+    current_row = 0;
+
+    if (filled.empty() && !done) {
+      waiting = true;
+      batch_ready.wait(lock, [this] { return !filled.empty() || done; });
+      waiting = false;
+    }
+    if (filled.empty()) {
+      return at_end ? nullptr : read_direct();
+    }
+
+    current = std::move(filled.front());
+    filled.pop_front();
+    batch_free.notify_one();
+  }
+
+  const size_t first = current_row * field_count;
+  for (unsigned int i = 0; i < field_count; ++i) {
+    const size_t offset = current.offsets[first + i];
+    row[i] = offset == NULL_VALUE ? nullptr : &current.data[offset];
+  }
+  lengths = &current.lengths[first];
+
+  ++current_row;
+  ++rows_returned;
+  return row.data();
+}
+
+void READ_AHEAD::read_rows() {
+  BATCH batch;
+  bool end = false;
+
+  while (!end) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      batch_free.wait(lock, [this] { return stopping || filled.size() < BATCHES; });
+      if (stopping) {
+        break;
+      }
+      if (!spare.empty()) {
+        batch = std::move(spare.back());
+        spare.pop_back();
+      }
+    }
+
+    batch.clear();
+    while (batch.rows < batch_rows && !stopping) {
+      if (!read_row(batch)) {
+        end = true;
+        break;
+      }
+      // Hand over the rows read so far rather than keep the application waiting
+      if (waiting) {
+        break;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (batch.rows) {
+      filled.push_back(std::move(batch));
+      batch = BATCH();
+    }
+    done = end || stopping;
+    at_end = end && !stopping;
+    batch_ready.notify_one();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  done = true;
+  at_end = end && !stopping;
+  batch_ready.notify_one();
+}
+
+MYSQL_ROW READ_AHEAD::read_direct() {
+  MYSQL_ROW values = dbc->connection_proxy->fetch_row(result);
+  if (!values) {
+    at_end = true;
+    return nullptr;
+  }
+  lengths = dbc->connection_proxy->fetch_lengths(result);
+  ++rows_returned;
+  return values;
+}
+
+bool READ_AHEAD::read_row(BATCH& batch) {
+  /*
+    The application may hold the connection lock while it waits for the
+    worker to stop, which then wakes the worker up.
+  */
+  if (!dbc->lock.lock_unless(stopping)) {
+    return false;
+  }
+  std::unique_lock<DBC_MUTEX> dlock(dbc->lock, std::adopt_lock);
+
+  MYSQL_ROW values = dbc->connection_proxy->fetch_row(result);
+  if (!values) {
+    return false;
+  }
+  const unsigned long* value_lengths = dbc->connection_proxy->fetch_lengths(result);
+
+  // Values are copied with their terminating null, as in the rows of libmysqlclient
+  for (unsigned int i = 0; i < field_count; ++i) {
+    batch.lengths.push_back(value_lengths[i]);
+    if (!values[i]) {
+      batch.offsets.push_back(NULL_VALUE);
+      continue;
+    }
+    const size_t offset = batch.data.size();
+    batch.offsets.push_back(offset);
+    batch.data.resize(offset + value_lengths[i] + 1);
+    memcpy(&batch.data[offset], values[i], value_lengths[i]);
+    batch.data[offset + value_lengths[i]] = '\0';
+  }
+  ++batch.rows;
+  return true;
+}
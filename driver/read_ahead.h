@@ -0,0 +1,124 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __READ_AHEAD_H__
+#define __READ_AHEAD_H__
+
+#include "MYODBC_MYSQL.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct DBC;
+
+/*
+  Reads the rows of an unbuffered (mysql_use_result) result set on a worker
+  thread while the application processes the rows read before. The rows are
+  copied into batches, at most BATCHES of them are kept ahead of the
+  application. A batch is handed over before it is full when the application
+  is already waiting for rows.
+
+  The worker holds the connection lock while it reads a row, so that the
+  connection is not used by two threads at once. When the application needs
+  rows while it holds that lock itself, the worker is stopped and the rows
+  left are read from the result by fetch_row(). Once the worker has started,
+  the rows and their lengths must only be read through this object.
+*/
+class READ_AHEAD {
+ public:
+  static constexpr size_t BATCHES = 4;
+
+  /* Starts reading ahead up to max_rows rows of the result */
+  READ_AHEAD(DBC* dbc, MYSQL_RES* result, unsigned int field_count, size_t max_rows);
+  ~READ_AHEAD();
+
+  READ_AHEAD(const READ_AHEAD&) = delete;
+  READ_AHEAD& operator=(const READ_AHEAD&) = delete;
+
+  /* Same as mysql_fetch_row(), the row is valid until the next call */
+  MYSQL_ROW fetch_row();
+  /* Lengths of the columns of the row last returned by fetch_row() */
+  unsigned long* fetch_lengths() { return lengths; }
+  /* Number of rows returned by fetch_row() so far */
+  my_ulonglong num_rows() const { return rows_returned; }
+
+  /*
+    Stops the worker, the rows it has not read are left in the result and
+    returned by fetch_row() after the ones read ahead
+  */
+  void stop();
+
+ private:
+  struct BATCH {
+    std::vector<char> data;
+    // field_count offsets into data per row, NULL_VALUE for NULL columns
+    std::vector<size_t> offsets;
+    std::vector<unsigned long> lengths;
+    size_t rows = 0;
+
+    void clear();
+  };
+
+  static constexpr size_t NULL_VALUE = static_cast<size_t>(-1);
+
+  void read_rows();
+  bool read_row(BATCH& batch);
+  MYSQL_ROW read_direct();
+
+  DBC* dbc;
+  MYSQL_RES* result;
+  unsigned int field_count;
+  size_t batch_rows;
+
+  std::mutex mutex;
+  std::condition_variable batch_ready;
+  std::condition_variable batch_free;
+  std::deque<BATCH> filled;
+  // Batches already returned to the application, reused by the worker
+  std::vector<BATCH> spare;
+  bool done = false;
+  // Whether the worker has read the last row of the result
+  bool at_end = false;
+  std::atomic<bool> stopping{false};
+  std::atomic<bool> waiting{false};
+
+  BATCH current;
+  size_t current_row = 0;
+  std::vector<char*> row;
+  unsigned long* lengths = nullptr;
+  my_ulonglong rows_returned = 0;
+
+  std::thread worker;
+};
+
+#endif /* __READ_AHEAD_H__ */
@@ -0,0 +1,553 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "read_write_splitting_proxy.h"
+#include "mylog.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+// Whether the query starts with the keyword followed by a delimiter
+bool starts_with_keyword(const char* q, const char* end, const char* keyword) {
+    const size_t keyword_length = strlen(keyword);
+    if (static_cast<size_t>(end - q) < keyword_length ||
+        myodbc_casecmp(q, keyword, static_cast<uint>(keyword_length))) {
+        return false;
+    }
+    q += keyword_length;
+    return q == end || isspace(static_cast<unsigned char>(*q)) || *q == '(' || *q == '/';
+}
+
+const char* skip_spaces(const char* q, const char* end) {
+    while (q < end && (isspace(static_cast<unsigned char>(*q)) || *q == '(')) {
+        ++q;
+    }
+    return q;
+}
+
+bool is_use_statement(const std::string& statement) {
+    const char* end = statement.data() + statement.size();
+    return starts_with_keyword(skip_spaces(statement.data(), end), end, "USE");
+}
+}  // namespace
+
+std::atomic<unsigned int> READ_WRITE_SPLITTING_PROXY::round_robin_counter{0};
+
+READ_WRITE_SPLITTING_PROXY::READ_WRITE_SPLITTING_PROXY(DBC* dbc, DataSource* ds)
+    : READ_WRITE_SPLITTING_PROXY(dbc, ds, nullptr) {}
+
+READ_WRITE_SPLITTING_PROXY::READ_WRITE_SPLITTING_PROXY(DBC* dbc, DataSource* ds, CONNECTION_PROXY* next_proxy)
+    : CONNECTION_PROXY(dbc, ds) {
+    this->next_proxy = next_proxy;
+    this->writer_proxy = next_proxy;
+
+    if (ds->opt_LOG_QUERY) {
+        this->logger = init_log_file();
+    }
+}
+
+READ_WRITE_SPLITTING_PROXY::~READ_WRITE_SPLITTING_PROXY() {
+    close_readers();
+    // The base class deletes the writer
+    this->next_proxy = writer_proxy;
+}
+
+void READ_WRITE_SPLITTING_PROXY::delete_ds() {
+    writer_proxy->delete_ds();
+}
+
+int READ_WRITE_SPLITTING_PROXY::select_db(const char* db) {
+    const int ret = next_proxy->select_db(db);
+    if (ret == 0) {
+        // The database of a reader opened later on is set from dbc->database instead
+        session_statements.erase(
+            std::remove_if(session_statements.begin(), session_statements.end(), is_use_statement),
+            session_statements.end());
+    }
+    CONNECTION_PROXY* other = next_proxy == writer_proxy ? reader_proxy : writer_proxy;
+    if (ret == 0 && other && other->select_db(db) && other == reader_proxy) {
+        release_reader();
+    }
+    return ret;
+}
+
+int READ_WRITE_SPLITTING_PROXY::query(const char* q) {
+    return real_query(q, static_cast<unsigned long>(strlen(q)));
+}
+
+int READ_WRITE_SPLITTING_PROXY::real_query(const char* q, unsigned long length) {
+    route_query(q, length);
+    const int ret = next_proxy->real_query(q, length);
+    if (ret != 0 || !is_session_statement(q, length)) {
+        return ret;
+    }
+    record_session_statement(q, length);
+
+    // Keep the session state of both connections the same
+    CONNECTION_PROXY* other = next_proxy == writer_proxy ? reader_proxy : writer_proxy;
+    if (other && other->real_query(q, length)) {
+        MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Could not apply '%.*s' to the other connection: %s",
+                    static_cast<int>(length), q, other->error());
+        if (other == reader_proxy) {
+            release_reader();
+        }
+    }
+    return ret;
+}
+
+net_async_status READ_WRITE_SPLITTING_PROXY::real_query_nonblocking(const char* q, unsigned long length) {
+    // The query is sent again on every call until it completes
+    if (!nonblocking_pending) {
+        route_query(q, length);
+    }
+    const net_async_status status = next_proxy->real_query_nonblocking(q, length);
+    nonblocking_pending = status == NET_ASYNC_NOT_READY;
+    return status;
+}
+
+MYSQL_STMT* READ_WRITE_SPLITTING_PROXY::stmt_init() {
+    // Prepared statements stay on the connection they were prepared on, without switching the connection
+    // that queries of other statements run on
+    CONNECTION_PROXY* proxy = next_proxy;
+    if (!dbc->transaction_open) {
+        proxy = dbc->read_only && open_reader() ? reader_proxy : writer_proxy;
+    }
+
+    MYSQL_STMT* stmt = proxy->stmt_init();
+    if (stmt && proxy != writer_proxy) {
+        reader_statements[stmt] = proxy;
+    }
+    return stmt;
+}
+
+int READ_WRITE_SPLITTING_PROXY::stmt_prepare(MYSQL_STMT* stmt, const char* query, unsigned long length) {
+    return statement_proxy(stmt)->stmt_prepare(stmt, query, length);
+}
+
+int READ_WRITE_SPLITTING_PROXY::stmt_execute(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_execute(stmt);
+}
+
+int READ_WRITE_SPLITTING_PROXY::stmt_fetch(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_fetch(stmt);
+}
+
+int READ_WRITE_SPLITTING_PROXY::stmt_fetch_column(MYSQL_STMT* stmt, MYSQL_BIND* bind_arg, unsigned int column,
+                                                  unsigned long offset) {
+    return statement_proxy(stmt)->stmt_fetch_column(stmt, bind_arg, column, offset);
+}
+
+int READ_WRITE_SPLITTING_PROXY::stmt_store_result(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_store_result(stmt);
+}
+
+unsigned long READ_WRITE_SPLITTING_PROXY::stmt_param_count(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_param_count(stmt);
+}
+
+bool READ_WRITE_SPLITTING_PROXY::stmt_bind_named_param(MYSQL_STMT* stmt, MYSQL_BIND* binds, unsigned n_params,
+                                                       const char** names) {
+    return statement_proxy(stmt)->stmt_bind_named_param(stmt, binds, n_params, names);
+}
+
+bool READ_WRITE_SPLITTING_PROXY::stmt_bind_param(MYSQL_STMT* stmt, MYSQL_BIND* bnd) {
+    return statement_proxy(stmt)->stmt_bind_param(stmt, bnd);
+}
+
+bool READ_WRITE_SPLITTING_PROXY::stmt_bind_result(MYSQL_STMT* stmt, MYSQL_BIND* bnd) {
+    return statement_proxy(stmt)->stmt_bind_result(stmt, bnd);
+}
+
+bool READ_WRITE_SPLITTING_PROXY::stmt_close(MYSQL_STMT* stmt) {
+    const auto it = reader_statements.find(stmt);
+    if (it == reader_statements.end()) {
+        return writer_proxy->stmt_close(stmt);
+    }
+
+    CONNECTION_PROXY* reader = it->second;
+    reader_statements.erase(it);
+    const bool ret = reader->stmt_close(stmt);
+
+    // The last statement of a released reader was closed
+    const auto retired = std::find(retired_readers.begin(), retired_readers.end(), reader);
+    if (retired != retired_readers.end() && !has_statements(reader)) {
+        retired_readers.erase(retired);
+        delete reader;
+    }
+    return ret;
+}
+
+bool READ_WRITE_SPLITTING_PROXY::stmt_reset(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_reset(stmt);
+}
+
+bool READ_WRITE_SPLITTING_PROXY::stmt_free_result(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_free_result(stmt);
+}
+
+bool READ_WRITE_SPLITTING_PROXY::stmt_send_long_data(MYSQL_STMT* stmt, unsigned int param_number, const char* data,
+                                                     unsigned long length) {
+    return statement_proxy(stmt)->stmt_send_long_data(stmt, param_number, data, length);
+}
+
+MYSQL_RES* READ_WRITE_SPLITTING_PROXY::stmt_result_metadata(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_result_metadata(stmt);
+}
+
+unsigned int READ_WRITE_SPLITTING_PROXY::stmt_errno(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_errno(stmt);
+}
+
+const char* READ_WRITE_SPLITTING_PROXY::stmt_error(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_error(stmt);
+}
+
+MYSQL_ROW_OFFSET READ_WRITE_SPLITTING_PROXY::stmt_row_seek(MYSQL_STMT* stmt, MYSQL_ROW_OFFSET offset) {
+    return statement_proxy(stmt)->stmt_row_seek(stmt, offset);
+}
+
+MYSQL_ROW_OFFSET READ_WRITE_SPLITTING_PROXY::stmt_row_tell(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_row_tell(stmt);
+}
+
+void READ_WRITE_SPLITTING_PROXY::stmt_data_seek(MYSQL_STMT* stmt, uint64_t offset) {
+    statement_proxy(stmt)->stmt_data_seek(stmt, offset);
+}
+
+uint64_t READ_WRITE_SPLITTING_PROXY::stmt_num_rows(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_num_rows(stmt);
+}
+
+uint64_t READ_WRITE_SPLITTING_PROXY::stmt_affected_rows(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_affected_rows(stmt);
+}
+
+unsigned int READ_WRITE_SPLITTING_PROXY::stmt_field_count(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_field_count(stmt);
+}
+
+int READ_WRITE_SPLITTING_PROXY::stmt_next_result(MYSQL_STMT* stmt) {
+    return statement_proxy(stmt)->stmt_next_result(stmt);
+}
+
+bool READ_WRITE_SPLITTING_PROXY::autocommit(bool auto_mode) {
+    const bool ret = writer_proxy->autocommit(auto_mode);
+    if (!ret && reader_proxy && reader_proxy->autocommit(auto_mode)) {
+        release_reader();
+    }
+    return ret;
+}
+
+void READ_WRITE_SPLITTING_PROXY::close() {
+    close_readers();
+    writer_proxy->close();
+}
+
+bool READ_WRITE_SPLITTING_PROXY::release_failed_reader() {
+    // The writer is failed over if the statement ran on it and its connection was lost as well
+    if (!reader_proxy || reader_proxy->is_connected() ||
+        (next_proxy != reader_proxy && !writer_proxy->is_connected())) {
+        return false;
+    }
+
+    MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Lost the connection to reader %s",
+                reader_host ? reader_host->get_host_port_pair().c_str() : "");
+    if (reader_host) {
+        dbc->get_topology_service()->mark_host_down(reader_host);
+    }
+    release_reader();
+    return true;
+}
+
+void READ_WRITE_SPLITTING_PROXY::set_connection(CONNECTION_PROXY* connection_proxy) {
+    // The cluster has failed over, readers are selected again from the new topology
+    release_reader();
+    writer_proxy->set_connection(connection_proxy);
+}
+
+void READ_WRITE_SPLITTING_PROXY::set_next_proxy(CONNECTION_PROXY* next_proxy) {
+    CONNECTION_PROXY::set_next_proxy(next_proxy);
+    this->writer_proxy = next_proxy;
+}
+
+MYSQL* READ_WRITE_SPLITTING_PROXY::move_mysql_connection() {
+    close_readers();
+    return writer_proxy->move_mysql_connection();
+}
+
+bool READ_WRITE_SPLITTING_PROXY::is_read_only_query(const char* q, unsigned long length) {
+    const char* end = q + length;
+    q = skip_spaces(q, end);
+    if (!starts_with_keyword(q, end, "SELECT")) {
+        return false;
+    }
+
+    // Locking reads, assignments and functions returning state of the session must run on the writer
+    static const char* const writer_tokens[] = {
+        "FOR", "INTO", "LOCK", "LAST_INSERT_ID", "FOUND_ROWS", "ROW_COUNT", "NEXTVAL"
+    };
+    for (const char* p = q; p < end; ++p) {
+        if (*p == '@' || *p == ';') {
+            return false;
+        }
+        if (!isalpha(static_cast<unsigned char>(*p)) && *p != '_') {
+            continue;
+        }
+        const char* word = p;
+        while (p < end && (isalnum(static_cast<unsigned char>(*p)) || *p == '_')) {
+            ++p;
+        }
+        const size_t word_length = p - word;
+        for (const char* token : writer_tokens) {
+            if (strlen(token) == word_length && !myodbc_casecmp(word, token, static_cast<uint>(word_length))) {
+                return false;
+            }
+        }
+        if (word_length > 5 && !myodbc_casecmp(p - 5, "_LOCK", 5)) {
+            // GET_LOCK(), RELEASE_LOCK(), IS_FREE_LOCK() and similar
+            return false;
+        }
+        --p;
+    }
+    return true;
+}
+
+bool READ_WRITE_SPLITTING_PROXY::is_session_statement(const char* q, unsigned long length) {
+    const char* end = q + length;
+    q = skip_spaces(q, end);
+    return starts_with_keyword(q, end, "SET") || starts_with_keyword(q, end, "USE");
+}
+
+void READ_WRITE_SPLITTING_PROXY::route_query(const char* q, unsigned long length) {
+    // A transaction is finished on the connection it was started on. The remaining results of a statement are read
+    // with next_result(), which is not bound to the statement, so they are read from the connection of the first one.
+    if (dbc->transaction_open || next_proxy->more_results()) {
+        return;
+    }
+
+    if (is_session_statement(q, length)) {
+        use_writer();
+        return;
+    }
+
+    const bool to_reader =
+        dbc->read_only ||
+        (ds->opt_READ_WRITE_SPLITTING_SELECTS && (writer_proxy->get_server_status() & SERVER_STATUS_AUTOCOMMIT) &&
+         is_read_only_query(q, length));
+    if (!to_reader || !use_reader()) {
+        use_writer();
+    }
+}
+
+void READ_WRITE_SPLITTING_PROXY::use_writer() {
+    if (next_proxy != writer_proxy) {
+        MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Switching to the writer");
+        next_proxy = writer_proxy;
+    }
+}
+
+bool READ_WRITE_SPLITTING_PROXY::use_reader() {
+    if (!open_reader()) {
+        return false;
+    }
+
+    if (next_proxy != reader_proxy) {
+        MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Switching to the reader");
+        next_proxy = reader_proxy;
+    }
+    return true;
+}
+
+bool READ_WRITE_SPLITTING_PROXY::open_reader() {
+    if (reader_proxy && !reader_proxy->is_connected()) {
+        release_reader();
+    }
+
+    if (!reader_proxy) {
+        if (std::chrono::steady_clock::now() < next_reader_attempt) {
+            return false;
+        }
+
+        std::vector<std::shared_ptr<HOST_INFO>> readers;
+        auto topology_service = dbc->get_topology_service();
+        if (auto topology = topology_service->get_topology(writer_proxy, false)) {
+            for (const auto& reader : topology->get_readers()) {
+                if (reader->is_host_up()) {
+                    readers.push_back(reader);
+                }
+            }
+        }
+
+        while (!readers.empty() && !reader_proxy) {
+            auto reader = select_reader(readers);
+            reader_proxy = connect_to_reader(reader);
+            if (!reader_proxy) {
+                MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Failed to connect to reader %s",
+                            reader->get_host_port_pair().c_str());
+                topology_service->mark_host_down(reader);
+                readers.erase(std::remove(readers.begin(), readers.end(), reader), readers.end());
+            } else {
+                MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Connected to reader %s",
+                            reader->get_host_port_pair().c_str());
+                reader_host = reader;
+            }
+        }
+
+        if (!reader_proxy) {
+            // Run on the writer for a while instead of trying to connect before every statement
+            next_reader_attempt =
+                std::chrono::steady_clock::now() + std::chrono::milliseconds(ds->opt_TOPOLOGY_REFRESH_RATE);
+            return false;
+        }
+
+        if (!restore_reader_session()) {
+            release_reader();
+            next_reader_attempt =
+                std::chrono::steady_clock::now() + std::chrono::milliseconds(ds->opt_TOPOLOGY_REFRESH_RATE);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool READ_WRITE_SPLITTING_PROXY::restore_reader_session() {
+    if (!(writer_proxy->get_server_status() & SERVER_STATUS_AUTOCOMMIT)) {
+        reader_proxy->autocommit(false);
+    }
+
+    // USE statements are recorded only if they were run after the database was last selected
+    if (!dbc->database.empty() && reader_proxy->select_db(dbc->database.c_str())) {
+        MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Could not select database %s on the reader: %s",
+                    dbc->database.c_str(), reader_proxy->error());
+        return false;
+    }
+
+    for (const auto& statement : session_statements) {
+        if (reader_proxy->real_query(statement.c_str(), static_cast<unsigned long>(statement.size()))) {
+            MYLOG_TRACE(logger, dbc->id, "[READ_WRITE_SPLITTING_PROXY] Could not apply '%s' to the reader: %s",
+                        statement.c_str(), reader_proxy->error());
+            return false;
+        }
+    }
+    return true;
+}
+
+void READ_WRITE_SPLITTING_PROXY::record_session_statement(const char* q, unsigned long length) {
+    std::string statement(q, length);
+    const bool use = is_use_statement(statement);
+    // Only the last USE statement and the last of identical SET statements matter
+    session_statements.erase(std::remove_if(session_statements.begin(), session_statements.end(),
+                                            [&statement, use](const std::string& recorded) {
+                                                return recorded == statement || (use && is_use_statement(recorded));
+                                            }),
+                             session_statements.end());
+    session_statements.push_back(std::move(statement));
+}
+
+std::shared_ptr<HOST_INFO> READ_WRITE_SPLITTING_PROXY::select_reader(
+    const std::vector<std::shared_ptr<HOST_INFO>>& readers) {
+
+    const char* strategy = ds->opt_READER_HOST_SELECTOR_STRATEGY ?
+        static_cast<const char*>(ds->opt_READER_HOST_SELECTOR_STRATEGY) : READER_HOST_SELECTOR_RANDOM;
+
+    if (!myodbc_strcasecmp(READER_HOST_SELECTOR_ROUND_ROBIN, strategy)) {
+        return readers[round_robin_counter++ % readers.size()];
+    }
+
+    if (!myodbc_strcasecmp(READER_HOST_SELECTOR_LEAST_REPLICA_LAG, strategy)) {
+        // Readers that did not report their lag are only used if no other reader did
+        std::shared_ptr<HOST_INFO> selected = readers.front();
+        for (const auto& reader : readers) {
+            const double lag = reader->get_replica_lag();
+            const double selected_lag = selected->get_replica_lag();
+            if (lag >= 0 && (selected_lag < 0 || lag < selected_lag)) {
+                selected = reader;
+            }
+        }
+        return selected;
+    }
+
+    static thread_local std::mt19937 rng{std::random_device{}()};
+    return readers[std::uniform_int_distribution<size_t>(0, readers.size() - 1)(rng)];
+}
+
+void READ_WRITE_SPLITTING_PROXY::release_reader() {
+    if (!reader_proxy) {
+        return;
+    }
+
+    // Cached prepared statements may belong to the reader
+    dbc->ssps_cache.clear(this);
+    if (next_proxy == reader_proxy) {
+        next_proxy = writer_proxy;
+    }
+    // The reader shares the data source of the connection, it is not deleted with the proxies
+    if (has_statements(reader_proxy)) {
+        retired_readers.push_back(reader_proxy);
+    } else {
+        delete reader_proxy;
+    }
+    reader_proxy = nullptr;
+    reader_host.reset();
+}
+
+void READ_WRITE_SPLITTING_PROXY::close_readers() {
+    release_reader();
+    // Statements still prepared on the readers fail from now on, as they do once the writer connection is closed
+    reader_statements.clear();
+    for (CONNECTION_PROXY* reader : retired_readers) {
+        delete reader;
+    }
+    retired_readers.clear();
+}
+
+CONNECTION_PROXY* READ_WRITE_SPLITTING_PROXY::statement_proxy(MYSQL_STMT* stmt) {
+    const auto it = reader_statements.find(stmt);
+    return it == reader_statements.end() ? writer_proxy : it->second;
+}
+
+bool READ_WRITE_SPLITTING_PROXY::has_statements(CONNECTION_PROXY* reader) {
+    return std::any_of(reader_statements.begin(), reader_statements.end(),
+                       [reader](const std::pair<MYSQL_STMT* const, CONNECTION_PROXY*>& entry) {
+                           return entry.second == reader;
+                       });
+}
+
+CONNECTION_PROXY* READ_WRITE_SPLITTING_PROXY::connect_to_reader(std::shared_ptr<HOST_INFO> reader) {
+    CONNECTION_PROXY* new_connection = dbc->connection_handler->connect(reader, nullptr);
+    if (new_connection == nullptr) {
+        return nullptr;
+    }
+
+    // The connection was established by a cloned handle, move it into proxies owned by this one
+    CONNECTION_PROXY* proxy = dbc->create_proxy_chain(ds);
+    proxy->set_connection(new_connection);
+    return proxy;
+}
@@ -0,0 +1,147 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __READ_WRITE_SPLITTING_PROXY_H__
+#define __READ_WRITE_SPLITTING_PROXY_H__
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "connection_proxy.h"
+#include "driver.h"
+
+/*
+  Sends statements of a connection to a reader instance of the cluster while
+  the application has set SQL_ATTR_ACCESS_MODE to SQL_MODE_READ_ONLY, or for
+  SELECT statements run in autocommit mode if READ_WRITE_SPLITTING_SELECTS is
+  set, and to the writer otherwise.
+
+  The writer is the rest of the proxy chain. The reader connection is opened
+  on first use and is closed along with the writer connection. It gets the
+  current database and the SET and USE statements run so far when opened. An open
+  transaction always stays on the connection it was started on, and so do
+  the remaining results of a statement. Server-side prepared statements are
+  bound to the connection they were prepared on.
+*/
+class READ_WRITE_SPLITTING_PROXY : public CONNECTION_PROXY {
+ public:
+  READ_WRITE_SPLITTING_PROXY(DBC* dbc, DataSource* ds);
+  READ_WRITE_SPLITTING_PROXY(DBC* dbc, DataSource* ds, CONNECTION_PROXY* next_proxy);
+  ~READ_WRITE_SPLITTING_PROXY() override;
+
+  void delete_ds() override;
+  int select_db(const char* db) override;
+  int query(const char* q) override;
+  int real_query(const char* q, unsigned long length) override;
+  net_async_status real_query_nonblocking(const char* q, unsigned long length) override;
+  MYSQL_STMT* stmt_init() override;
+  int stmt_prepare(MYSQL_STMT* stmt, const char* query, unsigned long length) override;
+  int stmt_execute(MYSQL_STMT* stmt) override;
+  int stmt_fetch(MYSQL_STMT* stmt) override;
+  int stmt_fetch_column(MYSQL_STMT* stmt, MYSQL_BIND* bind_arg, unsigned int column, unsigned long offset) override;
+  int stmt_store_result(MYSQL_STMT* stmt) override;
+  unsigned long stmt_param_count(MYSQL_STMT* stmt) override;
+  bool stmt_bind_named_param(MYSQL_STMT* stmt, MYSQL_BIND* binds, unsigned n_params, const char** names) override;
+  bool stmt_bind_param(MYSQL_STMT* stmt, MYSQL_BIND* bnd) override;
+  bool stmt_bind_result(MYSQL_STMT* stmt, MYSQL_BIND* bnd) override;
+  bool stmt_close(MYSQL_STMT* stmt) override;
+  bool stmt_reset(MYSQL_STMT* stmt) override;
+  bool stmt_free_result(MYSQL_STMT* stmt) override;
+  bool stmt_send_long_data(MYSQL_STMT* stmt, unsigned int param_number, const char* data,
+                           unsigned long length) override;
+  MYSQL_RES* stmt_result_metadata(MYSQL_STMT* stmt) override;
+  unsigned int stmt_errno(MYSQL_STMT* stmt) override;
+  const char* stmt_error(MYSQL_STMT* stmt) override;
+  MYSQL_ROW_OFFSET stmt_row_seek(MYSQL_STMT* stmt, MYSQL_ROW_OFFSET offset) override;
+  MYSQL_ROW_OFFSET stmt_row_tell(MYSQL_STMT* stmt) override;
+  void stmt_data_seek(MYSQL_STMT* stmt, uint64_t offset) override;
+  uint64_t stmt_num_rows(MYSQL_STMT* stmt) override;
+  uint64_t stmt_affected_rows(MYSQL_STMT* stmt) override;
+  unsigned int stmt_field_count(MYSQL_STMT* stmt) override;
+  int stmt_next_result(MYSQL_STMT* stmt) override;
+  bool autocommit(bool auto_mode) override;
+  void close() override;
+  bool release_failed_reader() override;
+
+  void set_connection(CONNECTION_PROXY* connection_proxy) override;
+  void set_next_proxy(CONNECTION_PROXY* next_proxy) override;
+  MYSQL* move_mysql_connection() override;
+
+  // Whether a statement only reads data and does not depend on the session it runs in
+  static bool is_read_only_query(const char* q, unsigned long length);
+  // Whether a statement changes the state of the session, such as SET or USE
+  static bool is_session_statement(const char* q, unsigned long length);
+
+ protected:
+  CONNECTION_PROXY* writer_proxy = nullptr;
+  CONNECTION_PROXY* reader_proxy = nullptr;
+  std::shared_ptr<HOST_INFO> reader_host;
+  // Statements prepared on a reader, statements missing here were prepared on the writer
+  std::map<MYSQL_STMT*, CONNECTION_PROXY*> reader_statements;
+  // Released readers that statements were still prepared on, deleted along with the last of them
+  std::vector<CONNECTION_PROXY*> retired_readers;
+  // A reader failed to connect, do not try again before this time
+  std::chrono::steady_clock::time_point next_reader_attempt;
+  // SET and USE statements that succeeded on the connection, replayed on a newly opened reader
+  std::vector<std::string> session_statements;
+
+  void route_query(const char* q, unsigned long length);
+  void use_writer();
+  bool use_reader();
+  // Connects to a reader unless already connected, returns whether one is available
+  bool open_reader();
+  // Brings the session of a newly opened reader to the state of the writer
+  bool restore_reader_session();
+  void record_session_statement(const char* q, unsigned long length);
+  std::shared_ptr<HOST_INFO> select_reader(const std::vector<std::shared_ptr<HOST_INFO>>& readers);
+  CONNECTION_PROXY* statement_proxy(MYSQL_STMT* stmt);
+  bool has_statements(CONNECTION_PROXY* reader);
+  // Stops using the reader, it is kept until the statements prepared on it are closed
+  void release_reader();
+  // Closes all reader connections, including those statements are still prepared on
+  void close_readers();
+
+  // Opens a connection to the reader and returns its proxy chain, nullptr on failure
+  virtual CONNECTION_PROXY* connect_to_reader(std::shared_ptr<HOST_INFO> reader);
+
+ private:
+  std::shared_ptr<FILE> logger;
+  bool nonblocking_pending = false;
+  static std::atomic<unsigned int> round_robin_counter;
+
+#ifdef UNIT_TEST_BUILD
+  // Allows for testing private/protected methods
+  friend class TEST_UTILS;
+#endif
+};
+
+#endif /* __READ_WRITE_SPLITTING_PROXY_H__ */
@@ -349,7 +349,9 @@ char *fix_padding(STMT *stmt, SQLSMALLINT fCType, char *value, std::string &out_
        )
     {
       if (value)
-        out_str = std::string(value, data_len);
+        out_str.assign(value, data_len);
+      else
+        out_str.clear();
 
       /* Calculate new data length with spaces */
       data_len = (ulong)(irrec->octet_length < cbValueMax ? irrec->octet_length : cbValueMax);
@@ -1388,6 +1390,7 @@ SQLRETURN SQL_API SQLBindCol(SQLHSTMT      StatementHandle,
         arrec->octet_length_ptr= NULL;
       }
     }
+    stmt->ard->touch();
     return SQL_SUCCESS;
   }
 
@@ -1585,6 +1588,12 @@ SQLRETURN SQL_API SQLMoreResults( SQLHSTMT hstmt )
   LOCK_DBC(stmt->dbc);
   CLEAR_STMT_ERROR(stmt);
 
+  if (stmt->async.pending() && stmt->async.function != SQL_API_SQLMORERESULTS)
+  {
+    nReturn = stmt->set_error(MYERR_S1010, NULL, 0);
+    goto exitSQLMoreResults;
+  }
+
   /*
     http://msdn.microsoft.com/en-us/library/ms714673%28v=vs.85%29.aspx
 
@@ -1600,7 +1609,19 @@ SQLRETURN SQL_API SQLMoreResults( SQLHSTMT hstmt )
   }
 
   /* try to get next resultset */
-  nRetVal = next_result(stmt);
+  if (stmt->stmt_options.async_enable && !ssps_used(stmt))
+  {
+    /* The call is repeated until the result has been read */
+    stmt->async.function = SQL_API_SQLMORERESULTS;
+    if (next_result_nonblocking(stmt, &nRetVal) == NET_ASYNC_NOT_READY)
+    {
+      return SQL_STILL_EXECUTING;
+    }
+  }
+  else
+  {
+    nRetVal = next_result(stmt);
+  }
 
   /* call to next_result() failed */
   if (nRetVal > 0)
@@ -1833,6 +1854,67 @@ fill_fetch_bookmark_buffers(STMT *stmt, ulong value, uint rownum)
 }
 
 
+/**
+  Compile the plan of populating fetch buffers of bound columns.
+  Descriptor records, buffer strides and conversion rules are resolved
+  here once instead of for every column of every row.
+
+  @param[in]  stmt        Handle of statement
+*/
+static void compile_fetch_plan(STMT *stmt)
+{
+  FETCH_PLAN &plan= stmt->fetch_plan;
+  size_t count= myodbc_min(stmt->ird->rcount(), stmt->ard->rcount());
+  SQLINTEGER bind_type= stmt->ard->bind_type;
+  DESCREC *irrec, *arrec;
+
+  plan.columns.clear();
+
+  for (size_t i= 0; i < count; ++i)
+  {
+    FETCH_COLUMN_PLAN column;
+
+    irrec= desc_get_rec(stmt->ird, (int)i, FALSE);
+    arrec= desc_get_rec(stmt->ard, (int)i, FALSE);
+    assert(irrec && arrec);
+
+    if (!ARD_IS_BOUND(arrec))
+    {
+      continue;
+    }
+
+    column.column=           (uint)i;
+    column.irrec=            irrec;
+    column.arrec=            arrec;
+    column.c_type=           arrec->concise_type;
+    column.data_ptr=         arrec->data_ptr;
+    column.octet_length=     arrec->octet_length;
+    column.octet_length_ptr= arrec->octet_length_ptr;
+    column.data_stride=      bind_type == SQL_BIND_BY_COLUMN ?
+                             arrec->octet_length : bind_type;
+    column.length_stride=    bind_type == SQL_BIND_BY_COLUMN ?
+                             sizeof(SQLLEN) : bind_type;
+    column.pad_space=        stmt->dbc->ds->opt_PAD_SPACE &&
+                             (irrec->type == SQL_CHAR || irrec->type == SQL_WCHAR) &&
+                             (column.c_type == SQL_C_CHAR ||
+                              column.c_type == SQL_C_WCHAR ||
+                              column.c_type == SQL_C_BINARY);
+    /* Without retrieving data sql_get_data() only positions the cursor */
+    column.convert=          stmt->stmt_options.retrieve_data &&
+                             ssps_used(stmt) && stmt->result_bind ?
+                             ssps_get_converter(stmt, (uint)i, column.c_type) :
+                             NULL;
+
+    plan.columns.push_back(column);
+  }
+
+  plan.ard=         stmt->ard;
+  plan.ard_version= stmt->ard->version;
+  plan.ird_version= stmt->ird->version;
+  plan.retrieve_data= stmt->stmt_options.retrieve_data;
+}
+
+
 /**
   Populate a single row of fetch buffers
 
@@ -1840,74 +1922,92 @@ fill_fetch_bookmark_buffers(STMT *stmt, ulong value, uint rownum)
   @param[in]  values      Row buffers from libmysql
   @param[in]  rownum      Row number of current fetch block
 */
-static SQLRETURN
+SQLRETURN
 fill_fetch_buffers(STMT *stmt, MYSQL_ROW values, uint rownum)
 {
   SQLRETURN res= SQL_SUCCESS, tmp_res;
-  int i;
+  FETCH_PLAN &plan= stmt->fetch_plan;
+  size_t offset= 0;
   ulong length= 0;
-  DESCREC *irrec, *arrec;
 
-  for (i= 0; i < myodbc_min(stmt->ird->rcount(), stmt->ard->rcount()); ++i, ++values)
+  if (plan.ard != stmt->ard || plan.ard_version != stmt->ard->version ||
+      plan.ird_version != stmt->ird->version ||
+      plan.retrieve_data != stmt->stmt_options.retrieve_data)
   {
-    irrec= desc_get_rec(stmt->ird, i, FALSE);
-    arrec= desc_get_rec(stmt->ard, i, FALSE);
-    assert(irrec && arrec);
+    compile_fetch_plan(stmt);
+  }
+
+  if (stmt->ard->bind_offset_ptr)
+  {
+    offset= (size_t)*stmt->ard->bind_offset_ptr;
+  }
 
-    if (ARD_IS_BOUND(arrec))
+  for (const FETCH_COLUMN_PLAN &column : plan.columns)
+  {
+    SQLLEN *pcbValue= NULL;
+    SQLPOINTER TargetValuePtr= NULL;
+    char *value= values[column.column];
+
+    if (column.data_ptr)
     {
-      SQLLEN *pcbValue= NULL;
-      SQLPOINTER TargetValuePtr= NULL;
+      TargetValuePtr= (SQLCHAR *)column.data_ptr + offset +
+                      column.data_stride * rownum;
+    }
 
-      stmt->reset_getdata_position();
+    /* We need to pass that pointer to the sql_get_data so it could detect
+       22002 error - for NULL values that pointer has to be supplied by user.
+     */
+    if (column.octet_length_ptr)
+    {
+      pcbValue= (SQLLEN *)((SQLCHAR *)column.octet_length_ptr + offset +
+                           column.length_stride * rownum);
+    }
 
-      if (arrec->data_ptr)
-      {
-        TargetValuePtr= ptr_offset_adjust(arrec->data_ptr,
-                                          stmt->ard->bind_offset_ptr,
-                                          stmt->ard->bind_type,
-                                          (SQLINTEGER)arrec->octet_length, rownum);
-      }
+    /* Binary values of prepared statement results can be converted
+       without the string round trip, sql_get_data() leaves the buffers
+       alone if data is not retrieved */
+    if (column.convert && TargetValuePtr
+      && stmt->stmt_options.retrieve_data
+      && stmt->out_params_state != OPS_STREAMS_PENDING
+      && !*stmt->result_bind[column.column].is_null)
+    {
+      SQLLEN temp;
+      tmp_res= column.convert(stmt, &stmt->result_bind[column.column],
+                              TargetValuePtr, pcbValue ? pcbValue : &temp);
+    }
+    else
+    {
+      stmt->reset_getdata_position();
 
       /* catalog functions with "fake" results won't have lengths */
-      length= irrec->row.datalen;
+      length= column.irrec->row.datalen;
 
-      if (!length && *values)
+      if (!length && value)
       {
-        length = (ulong)strlen(*values);
+        length = (ulong)strlen(value);
       }
 
-      /* We need to pass that pointer to the sql_get_data so it could detect
-         22002 error - for NULL values that pointer has to be supplied by user.
-       */
-      if (arrec->octet_length_ptr)
+      if (column.pad_space)
       {
-        pcbValue= (SQLLEN*)ptr_offset_adjust(arrec->octet_length_ptr,
-                                      stmt->ard->bind_offset_ptr,
-                                      stmt->ard->bind_type,
-                                      sizeof(SQLLEN), rownum);
+        value= fix_padding(stmt, column.c_type, value, plan.padded,
+                           column.octet_length, length, column.irrec);
       }
 
-      std::string temp_str;
-      char *temp_val = fix_padding(stmt, arrec->concise_type, *values,
-                                   temp_str, arrec->octet_length,
-                                   length, irrec);
-
-      tmp_res= sql_get_data(stmt, arrec->concise_type, (uint)i,
-                            TargetValuePtr, arrec->octet_length, pcbValue,
-                            temp_val, length, arrec);
+      tmp_res= sql_get_data(stmt, column.c_type, column.column,
+                            TargetValuePtr, column.octet_length, pcbValue,
+                            value, length, column.arrec);
+    }
 
-      if (tmp_res != SQL_SUCCESS)
+    if (tmp_res != SQL_SUCCESS)
+    {
+      if (tmp_res == SQL_SUCCESS_WITH_INFO)
       {
-        if (tmp_res == SQL_SUCCESS_WITH_INFO)
-        {
-          if (res == SQL_SUCCESS)
-            res= tmp_res;
-        }
-        else
-        {
-          res= SQL_ERROR;
-        }
+        if (res == SQL_SUCCESS)
+          res= tmp_res;
+      }
+      else
+      {
+        res= SQL_ERROR;
       }
     }
   }
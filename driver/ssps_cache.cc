@@ -0,0 +1,112 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "ssps_cache.h"
+
+#include <cctype>
+
+#include "connection_proxy.h"
+
+std::string SSPS_CACHE::make_key(const char* query, size_t length, unsigned int charset,
+                                 const std::string& database) {
+  const char* end = query + length;
+  while (query < end && std::isspace(static_cast<unsigned char>(*query))) {
+    ++query;
+  }
+  while (end > query && std::isspace(static_cast<unsigned char>(end[-1]))) {
+    --end;
+  }
+
+  // The same text can resolve to different objects in another schema or
+  // be tokenized differently in another character set.
+  std::string key = std::to_string(charset);
+  key.append(":").append(std::to_string(database.size())).append(":").append(database);
+  key.append(query, end);
+  return key;
+}
+
+MYSQL_STMT* SSPS_CACHE::take(const std::string& key) {
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  const auto it = entries.find(key);
+  if (it == entries.end()) {
+    return nullptr;
+  }
+
+  MYSQL_STMT* ssps = it->second->second;
+  lru.erase(it->second);
+  entries.erase(it);
+  return ssps;
+}
+
+void SSPS_CACHE::put(const std::string& key, MYSQL_STMT* ssps, unsigned long long handle_epoch, size_t capacity,
+                     CONNECTION_PROXY* proxy) {
+  MYSQL_STMT* evicted = ssps;
+  {
+    std::lock_guard<std::mutex> guard(cache_mutex);
+    if (handle_epoch == epoch && capacity > 0 && entries.find(key) == entries.end()) {
+      lru.emplace_front(key, ssps);
+      entries[key] = lru.begin();
+      evicted = nullptr;
+
+      if (lru.size() > capacity) {
+        evicted = lru.back().second;
+        entries.erase(lru.back().first);
+        lru.pop_back();
+      }
+    }
+  }
+
+  if (evicted) {
+    proxy->stmt_close(evicted);
+  }
+}
+
+void SSPS_CACHE::clear(CONNECTION_PROXY* proxy) {
+  std::list<ENTRY> released;
+  {
+    std::lock_guard<std::mutex> guard(cache_mutex);
+    released.swap(lru);
+    entries.clear();
+    ++epoch;
+  }
+
+  for (const auto& entry : released) {
+    proxy->stmt_close(entry.second);
+  }
+}
+
+unsigned long long SSPS_CACHE::get_epoch() {
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  return epoch;
+}
+
+size_t SSPS_CACHE::size() {
+  std::lock_guard<std::mutex> guard(cache_mutex);
+  return lru.size();
+}
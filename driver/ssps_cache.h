@@ -0,0 +1,77 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __SSPS_CACHE_H__
+#define __SSPS_CACHE_H__
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "MYODBC_MYSQL.h"
+
+class CONNECTION_PROXY;
+
+/*
+  Keeps server-side prepared statement handles of a connection that are no
+  longer used by any statement, so that preparing the same query again does
+  not need a round trip to the server. Least recently used handles are closed
+  once the cache is full.
+
+  Handles belong to a particular server session. clear() closes all of them
+  and starts a new epoch, handles released with an older epoch are closed
+  instead of being cached.
+*/
+class SSPS_CACHE {
+ public:
+  SSPS_CACHE() = default;
+  ~SSPS_CACHE() = default;
+
+  static std::string make_key(const char* query, size_t length, unsigned int charset, const std::string& database);
+
+  MYSQL_STMT* take(const std::string& key);
+  void put(const std::string& key, MYSQL_STMT* ssps, unsigned long long epoch, size_t capacity,
+           CONNECTION_PROXY* proxy);
+  void clear(CONNECTION_PROXY* proxy);
+  unsigned long long get_epoch();
+  size_t size();
+
+ private:
+  using ENTRY = std::pair<std::string, MYSQL_STMT*>;
+
+  std::mutex cache_mutex;
+  // Most recently used handles first
+  std::list<ENTRY> lru;
+  std::unordered_map<std::string, std::list<ENTRY>::iterator> entries;
+  unsigned long long epoch = 0;
+};
+
+#endif /* __SSPS_CACHE_H__ */
@@ -0,0 +1,360 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "standby_connections.h"
+
+#include "driver.h"
+
+#include <algorithm>
+#include <set>
+
+namespace {
+// Standby connections of the clusters the process is connected to, keyed by
+// cluster ID and connection settings, as a connection that is taken over
+// keeps the user and session of the settings it was opened with.
+// Connections hold them, so they are closed with the last connection.
+std::map<std::pair<std::string, SQLWSTRING>, std::weak_ptr<STANDBY_CONNECTIONS>> standby_connections;
+std::mutex standby_connections_mutex;
+}  // namespace
+
+STANDBY_CONNECTIONS::STANDBY_CONNECTIONS(
+    std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
+    DataSource* ds,
+    size_t max_connections,
+    std::chrono::milliseconds refresh_interval,
+    unsigned long dbc_id,
+    bool enable_logging)
+    : topology_service{std::move(topology_service)},
+      max_connections{max_connections},
+      refresh_interval{refresh_interval},
+      dbc_id{dbc_id} {
+
+    this->ds = new DataSource();
+    this->ds->copy(ds);
+    // Idle connections are checked by the pings of this class
+    this->ds->opt_ENABLE_FAILURE_DETECTION = false;
+    this->ds->opt_ENABLE_TOPOLOGY_MONITORING = false;
+    this->ds->opt_ENABLE_READ_WRITE_SPLITTING = false;
+
+    if (enable_logging)
+        this->logger = init_log_file();
+}
+
+STANDBY_CONNECTIONS::~STANDBY_CONNECTIONS() {
+    stop();
+    if (this->ds) {
+        delete ds;
+        this->ds = nullptr;
+    }
+}
+
+std::shared_ptr<STANDBY_CONNECTIONS> STANDBY_CONNECTIONS::get_or_create(
+    std::string cluster_id,
+    std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
+    DataSource* ds,
+    size_t max_connections,
+    std::chrono::milliseconds refresh_interval,
+    unsigned long dbc_id,
+    bool enable_logging) {
+
+    std::unique_lock<std::mutex> lock(standby_connections_mutex);
+    // Drop the entries of pools whose last connection has been closed
+    for (auto it = standby_connections.begin(); it != standby_connections.end();) {
+        it = it->second.expired() ? standby_connections.erase(it) : std::next(it);
+    }
+
+    auto& entry = standby_connections[std::make_pair(std::move(cluster_id), ds->to_kvpair(';'))];
+    auto standby = entry.lock();
+    if (!standby) {
+        standby = std::make_shared<STANDBY_CONNECTIONS>(
+            std::move(topology_service), ds, max_connections, refresh_interval, dbc_id, enable_logging);
+        entry = standby;
+    }
+
+    return standby;
+}
+
+void STANDBY_CONNECTIONS::start() {
+    std::unique_lock<std::mutex> lock(connections_mutex);
+    if (thread.joinable() || should_stop) {
+        return;
+    }
+    thread = std::thread(&STANDBY_CONNECTIONS::run, this);
+}
+
+void STANDBY_CONNECTIONS::stop() {
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        should_stop = true;
+    }
+    cv.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    std::map<std::string, STANDBY_CONNECTION> to_release;
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        to_release.swap(connections);
+    }
+    for (const auto& entry : to_release) {
+        release(entry.second.connection);
+    }
+}
+
+void STANDBY_CONNECTIONS::add_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler) {
+    std::unique_lock<std::mutex> lock(handlers_mutex);
+    connection_handlers.push_back(std::move(connection_handler));
+}
+
+void STANDBY_CONNECTIONS::remove_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler) {
+    // Waits for a connection being opened or checked, which may belong to the handler
+    std::unique_lock<std::mutex> handlers_lock(handlers_mutex);
+    auto it = std::find(connection_handlers.begin(), connection_handlers.end(), connection_handler);
+    if (it != connection_handlers.end()) {
+        connection_handlers.erase(it);
+    }
+
+    std::vector<CONNECTION_PROXY*> to_release;
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        current_hosts.erase(connection_handler.get());
+        for (auto entry = connections.begin(); entry != connections.end();) {
+            if (entry->second.owner == connection_handler) {
+                to_release.push_back(entry->second.connection);
+                entry = connections.erase(entry);
+            } else {
+                ++entry;
+            }
+        }
+    }
+    for (CONNECTION_PROXY* connection : to_release) {
+        release(connection);
+    }
+    // Replace the connections that were closed
+    cv.notify_all();
+}
+
+CONNECTION_PROXY* STANDBY_CONNECTIONS::take(std::shared_ptr<HOST_INFO> host) {
+    if (!host) {
+        return nullptr;
+    }
+
+    CONNECTION_PROXY* connection = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        const auto it = connections.find(host->get_host_port_pair());
+        if (it == connections.end()) {
+            return nullptr;
+        }
+        connection = it->second.connection;
+        connections.erase(it);
+    }
+    cv.notify_all();
+
+    // The connection may have been idle since the last check
+    if (connection->ping() != 0) {
+        MYLOG_TRACE(logger, dbc_id, "[STANDBY_CONNECTIONS] Standby connection to %s is not usable",
+                    host->get_host_port_pair().c_str());
+        release(connection);
+        return nullptr;
+    }
+
+    MYLOG_TRACE(logger, dbc_id, "[STANDBY_CONNECTIONS] Using standby connection to %s",
+                host->get_host_port_pair().c_str());
+    return connection;
+}
+
+void STANDBY_CONNECTIONS::set_current_host(std::shared_ptr<CONNECTION_HANDLER> connection_handler,
+                                           std::shared_ptr<HOST_INFO> host) {
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        current_hosts[connection_handler.get()] = host ? host->get_host_port_pair() : "";
+    }
+    // Replace the connection that was taken over
+    cv.notify_all();
+}
+
+size_t STANDBY_CONNECTIONS::size() {
+    std::unique_lock<std::mutex> lock(connections_mutex);
+    return connections.size();
+}
+
+void STANDBY_CONNECTIONS::run() {
+    MYLOG_TRACE(logger, dbc_id, "[STANDBY_CONNECTIONS] Keeping up to %zu standby connections", max_connections);
+
+    while (true) {
+        refresh();
+
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        cv.wait_for(lock, refresh_interval, [this] { return should_stop; });
+        if (should_stop) {
+            break;
+        }
+    }
+}
+
+void STANDBY_CONNECTIONS::refresh() {
+    const auto hosts = select_hosts();
+    std::set<std::string> wanted;
+    for (const auto& host : hosts) {
+        wanted.insert(host->get_host_port_pair());
+    }
+
+    // Check the connections one at a time, the others stay available to failover
+    std::vector<std::string> keys;
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        for (const auto& entry : connections) {
+            keys.push_back(entry.first);
+        }
+    }
+    for (const auto& key : keys) {
+        // The DBC of the handler the connection was opened through is not freed during the check
+        std::unique_lock<std::mutex> handlers_lock(handlers_mutex);
+        STANDBY_CONNECTION standby;
+        {
+            std::unique_lock<std::mutex> lock(connections_mutex);
+            const auto it = connections.find(key);
+            if (it == connections.end()) {
+                continue;
+            }
+            standby = it->second;
+            connections.erase(it);
+        }
+
+        if (wanted.count(key) == 0 || standby.connection->ping() != 0) {
+            MYLOG_TRACE(logger, dbc_id, "[STANDBY_CONNECTIONS] Closing standby connection to %s", key.c_str());
+            release(standby.connection);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        if (should_stop) {
+            lock.unlock();
+            release(standby.connection);
+            continue;
+        }
+        connections.emplace(key, standby);
+    }
+
+    for (const auto& host : hosts) {
+        const std::string key = host->get_host_port_pair();
+        {
+            std::unique_lock<std::mutex> lock(connections_mutex);
+            if (should_stop) {
+                return;
+            }
+            if (connections.count(key) || connections.size() >= max_connections) {
+                continue;
+            }
+        }
+
+        std::unique_lock<std::mutex> handlers_lock(handlers_mutex);
+        if (connection_handlers.empty()) {
+            return;
+        }
+        auto connection_handler = connection_handlers.front();
+        CONNECTION_PROXY* connection = connection_handler->connect(host, ds);
+        if (connection == nullptr || !connection->is_connected()) {
+            MYLOG_TRACE(logger, dbc_id, "[STANDBY_CONNECTIONS] Unable to open standby connection to %s", key.c_str());
+            if (connection) {
+                release(connection);
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        if (should_stop || connections.count(key) || is_current_host(key)) {
+            lock.unlock();
+            release(connection);
+            continue;
+        }
+        MYLOG_TRACE(logger, dbc_id, "[STANDBY_CONNECTIONS] Opened standby connection to %s", key.c_str());
+        connections.emplace(key, STANDBY_CONNECTION{connection, connection_handler});
+    }
+}
+
+// Members to keep connections to: readers with the lowest replication lag
+// first, then the writer, never the host all connections are connected to.
+std::vector<std::shared_ptr<HOST_INFO>> STANDBY_CONNECTIONS::select_hosts() {
+    std::vector<std::shared_ptr<HOST_INFO>> hosts;
+    const auto topology = topology_service->get_cached_topology();
+    if (!topology) {
+        return hosts;
+    }
+
+    std::vector<std::shared_ptr<HOST_INFO>> candidates;
+    for (const auto& reader : topology->get_readers()) {
+        if (reader->is_host_up()) {
+            candidates.push_back(reader);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const std::shared_ptr<HOST_INFO>& a, const std::shared_ptr<HOST_INFO>& b) {
+            const double lag_a = a->get_replica_lag();
+            const double lag_b = b->get_replica_lag();
+            if (lag_b < 0) {
+                return lag_a >= 0;
+            }
+            return lag_a >= 0 && lag_a < lag_b;
+        });
+    for (const auto& writer : topology->get_writers()) {
+        candidates.push_back(writer);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex);
+        for (const auto& host : candidates) {
+            if (!is_current_host(host->get_host_port_pair())) {
+                hosts.push_back(host);
+            }
+        }
+    }
+
+    if (hosts.size() > max_connections) {
+        hosts.resize(max_connections);
+    }
+    return hosts;
+}
+
+bool STANDBY_CONNECTIONS::is_current_host(const std::string& host) {
+    if (current_hosts.empty()) {
+        return false;
+    }
+    return std::all_of(current_hosts.begin(), current_hosts.end(),
+                       [&host](const std::pair<CONNECTION_HANDLER* const, std::string>& entry) {
+                           return entry.second == host;
+                       });
+}
+
+void STANDBY_CONNECTIONS::release(CONNECTION_PROXY* connection) {
+    connection->delete_ds();
+    delete connection;
+}
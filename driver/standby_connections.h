@@ -0,0 +1,130 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __STANDBY_CONNECTIONS_H__
+#define __STANDBY_CONNECTIONS_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "connection_handler.h"
+#include "topology_service.h"
+
+class DataSource;
+class CONNECTION_PROXY;
+
+// Keeps idle connections to members of the cluster, so that failover can
+// take one over instead of opening a new connection. The connections are
+// shared by all connections to the cluster in the process that use the same
+// settings. A background thread pings them and follows the topology every
+// refresh interval, and runs while any connection holds it.
+class STANDBY_CONNECTIONS {
+public:
+    STANDBY_CONNECTIONS(
+        std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
+        DataSource* ds,
+        size_t max_connections,
+        std::chrono::milliseconds refresh_interval,
+        unsigned long dbc_id,
+        bool enable_logging = false);
+    virtual ~STANDBY_CONNECTIONS();
+
+    // Returns the running standby connections of the cluster for the settings, creating them if needed
+    static std::shared_ptr<STANDBY_CONNECTIONS> get_or_create(
+        std::string cluster_id,
+        std::shared_ptr<TOPOLOGY_SERVICE> topology_service,
+        DataSource* ds,
+        size_t max_connections,
+        std::chrono::milliseconds refresh_interval,
+        unsigned long dbc_id,
+        bool enable_logging = false);
+
+    void start();
+    void stop();
+
+    // Standby connections are opened through the handlers of the connections using them
+    void add_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler);
+    // Closes the standby connections opened through the handler, whose DBC is about to be freed
+    void remove_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler);
+
+    // Hands over the connection to the host, nullptr if there is no usable one
+    CONNECTION_PROXY* take(std::shared_ptr<HOST_INFO> host);
+    // No connection is kept to a host all connections using the standby connections are connected to
+    void set_current_host(std::shared_ptr<CONNECTION_HANDLER> connection_handler, std::shared_ptr<HOST_INFO> host);
+    size_t size();
+
+    // Drops connections that failed or left the topology and opens the missing ones
+    void refresh();
+
+private:
+    struct STANDBY_CONNECTION {
+        CONNECTION_PROXY* connection = nullptr;
+        // Handler the connection was opened through
+        std::shared_ptr<CONNECTION_HANDLER> owner;
+    };
+
+    std::shared_ptr<TOPOLOGY_SERVICE> topology_service;
+    // Copy of the connection settings, the original changes on failover
+    DataSource* ds = nullptr;
+    size_t max_connections;
+    std::chrono::milliseconds refresh_interval;
+    std::shared_ptr<FILE> logger;
+    unsigned long dbc_id = 0;
+
+    // Guards the handlers, held while a connection is opened or checked through one of them
+    std::mutex handlers_mutex;
+    std::list<std::shared_ptr<CONNECTION_HANDLER>> connection_handlers;
+    // Guards the connections and the fields below
+    std::mutex connections_mutex;
+    // Connections by host:port of the member
+    std::map<std::string, STANDBY_CONNECTION> connections;
+    // host:port each handler's connection is connected to
+    std::map<CONNECTION_HANDLER*, std::string> current_hosts;
+    bool should_stop = false;
+    std::condition_variable cv;
+    std::thread thread;
+
+    void run();
+    std::vector<std::shared_ptr<HOST_INFO>> select_hosts();
+    // Whether all connections using the standby connections are connected to the host, connections_mutex is held
+    bool is_current_host(const std::string& host);
+    static void release(CONNECTION_PROXY* connection);
+
+#ifdef UNIT_TEST_BUILD
+    // Allows for testing private methods
+    friend class TEST_UTILS;
+#endif
+};
+
+#endif /* __STANDBY_CONNECTIONS_H__ */
@@ -0,0 +1,269 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "topology_monitor.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#include "driver.h"
+#include "mylog.h"
+
+namespace {
+// Monitors of the clusters the process is connected to, keyed by cluster ID.
+// Connections hold the monitors, so a monitor stops with the last connection.
+std::map<std::string, std::weak_ptr<TOPOLOGY_MONITOR>> topology_monitors;
+std::mutex topology_monitors_mutex;
+}  // namespace
+
+constexpr int TOPOLOGY_MONITOR::STABLE_POLLS;
+constexpr int TOPOLOGY_MONITOR::MAX_STABLE_BACKOFF;
+
+TOPOLOGY_MONITOR::TOPOLOGY_MONITOR(
+    std::string cluster_id,
+    std::shared_ptr<HOST_INFO> host_template,
+    std::shared_ptr<HOST_INFO> initial_host,
+    DataSource* ds,
+    unsigned long dbc_id,
+    bool enable_logging)
+    : cluster_id{std::move(cluster_id)},
+      initial_host{std::move(initial_host)},
+      dbc_id{dbc_id} {
+
+    this->ds = new DataSource();
+    this->ds->copy(ds);
+    // The monitoring connection must not fail over or be monitored itself
+    this->ds->opt_ENABLE_CLUSTER_FAILOVER = false;
+    this->ds->opt_ENABLE_FAILURE_DETECTION = false;
+    this->ds->opt_ENABLE_TOPOLOGY_MONITORING = false;
+    // Bounds how long closing a connection can wait for a topology query
+    this->ds->opt_READTIMEOUT = (int)ds->opt_NETWORK_TIMEOUT;
+    this->ds->opt_WRITETIMEOUT = (int)ds->opt_NETWORK_TIMEOUT;
+
+    this->refresh_rate_ms = ds->opt_TOPOLOGY_REFRESH_RATE;
+    this->fast_refresh_rate_ms = ds->opt_FAILOVER_TOPOLOGY_REFRESH_RATE;
+
+    this->topology_service = std::make_shared<TOPOLOGY_SERVICE>(dbc_id, enable_logging);
+    this->topology_service->set_cluster_id(this->cluster_id);
+    this->topology_service->set_cluster_instance_template(std::move(host_template));
+
+    if (enable_logging)
+        this->logger = init_log_file();
+
+    this->thread = std::thread(&TOPOLOGY_MONITOR::run, this);
+}
+
+TOPOLOGY_MONITOR::~TOPOLOGY_MONITOR() {
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        should_stop = true;
+    }
+    cv.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    release_connection();
+    if (this->ds) {
+        delete ds;
+        this->ds = nullptr;
+    }
+    MYLOG_TRACE(logger, dbc_id, "[TOPOLOGY_MONITOR] Stopped monitoring cluster %s", cluster_id.c_str());
+}
+
+std::shared_ptr<TOPOLOGY_MONITOR> TOPOLOGY_MONITOR::get_or_create(
+    std::string cluster_id,
+    std::shared_ptr<HOST_INFO> host_template,
+    std::shared_ptr<HOST_INFO> initial_host,
+    DataSource* ds,
+    unsigned long dbc_id,
+    bool enable_logging) {
+
+    std::unique_lock<std::mutex> lock(topology_monitors_mutex);
+    // Drop the entries of clusters the process is no longer connected to
+    for (auto it = topology_monitors.begin(); it != topology_monitors.end();) {
+        it = it->second.expired() ? topology_monitors.erase(it) : std::next(it);
+    }
+
+    auto& entry = topology_monitors[cluster_id];
+    auto monitor = entry.lock();
+    if (!monitor) {
+        monitor = std::make_shared<TOPOLOGY_MONITOR>(
+            cluster_id, std::move(host_template), std::move(initial_host), ds, dbc_id, enable_logging);
+        entry = monitor;
+    }
+
+    return monitor;
+}
+
+void TOPOLOGY_MONITOR::add_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler) {
+    std::unique_lock<std::mutex> lock(connection_mutex);
+    connection_handlers.push_back(std::move(connection_handler));
+}
+
+void TOPOLOGY_MONITOR::remove_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler) {
+    // Waits for a topology query in progress, the connection may belong to
+    // the handler's DBC that is about to be freed.
+    std::unique_lock<std::mutex> lock(connection_mutex);
+    auto it = std::find(connection_handlers.begin(), connection_handlers.end(), connection_handler);
+    if (it != connection_handlers.end()) {
+        connection_handlers.erase(it);
+    }
+
+    if (connection_owner == connection_handler) {
+        release_connection();
+    }
+}
+
+void TOPOLOGY_MONITOR::request_fast_refresh() {
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        fast_refresh_requested = true;
+    }
+    cv.notify_all();
+}
+
+std::chrono::milliseconds TOPOLOGY_MONITOR::get_refresh_interval(
+    int refresh_rate_ms, int fast_refresh_rate_ms, int unchanged_polls) {
+
+    const int fast_rate_ms = (std::min)(refresh_rate_ms, fast_refresh_rate_ms);
+    if (unchanged_polls < STABLE_POLLS) {
+        return std::chrono::milliseconds(fast_rate_ms);
+    }
+
+    const int backoff = (std::min)(1 << (std::min)(unchanged_polls - STABLE_POLLS, 30), MAX_STABLE_BACKOFF);
+    return std::chrono::milliseconds(static_cast<long long>(refresh_rate_ms) * backoff);
+}
+
+void TOPOLOGY_MONITOR::run() {
+    MYLOG_TRACE(logger, dbc_id, "[TOPOLOGY_MONITOR] Started monitoring cluster %s", cluster_id.c_str());
+
+    std::string last_signature;
+    // The connection creating the monitor has just fetched the topology
+    int unchanged_polls = STABLE_POLLS;
+    while (true) {
+        const auto interval = get_refresh_interval(refresh_rate_ms, fast_refresh_rate_ms, unchanged_polls);
+        bool fast_refresh = false;
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            cv.wait_for(lock, interval, [this] { return should_stop || fast_refresh_requested; });
+            if (should_stop) {
+                break;
+            }
+            fast_refresh = fast_refresh_requested;
+            fast_refresh_requested = false;
+        }
+
+        bool refreshed = false;
+        bool changed = false;
+        {
+            std::unique_lock<std::mutex> lock(connection_mutex);
+            if (connection_handlers.empty()) {
+                // No connection to open a monitoring connection through yet
+                continue;
+            }
+
+            if (connection_proxy == nullptr || !connection_proxy->is_connected()) {
+                connect();
+            }
+
+            if (connection_proxy) {
+                auto topology = topology_service->get_topology(connection_proxy, true);
+                if (topology && topology->total_hosts() > 0) {
+                    refreshed = true;
+                    const std::string signature = get_topology_signature(topology);
+                    changed = !last_signature.empty() && signature != last_signature;
+                    last_signature = signature;
+                } else {
+                    // Reconnect on the next poll, possibly to another host
+                    release_connection();
+                }
+            }
+        }
+
+        if (changed) {
+            MYLOG_TRACE(logger, dbc_id, "[TOPOLOGY_MONITOR] Topology of cluster %s changed", cluster_id.c_str());
+        }
+        if (!refreshed || changed || fast_refresh) {
+            unchanged_polls = 0;
+        } else if (unchanged_polls < STABLE_POLLS + MAX_STABLE_BACKOFF) {
+            unchanged_polls++;
+        }
+    }
+}
+
+bool TOPOLOGY_MONITOR::connect() {
+    release_connection();
+    if (connection_handlers.empty()) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<HOST_INFO>> hosts;
+    if (auto topology = topology_service->get_cached_topology()) {
+        hosts = topology->get_writers();
+    }
+    hosts.push_back(initial_host);
+
+    auto connection_handler = connection_handlers.front();
+    for (const auto& host : hosts) {
+        connection_proxy = connection_handler->connect(host, ds, true);
+        if (connection_proxy && connection_proxy->is_connected()) {
+            connection_owner = connection_handler;
+            return true;
+        }
+        release_connection();
+    }
+
+    MYLOG_TRACE(logger, dbc_id, "[TOPOLOGY_MONITOR] Unable to connect to cluster %s", cluster_id.c_str());
+    return false;
+}
+
+void TOPOLOGY_MONITOR::release_connection() {
+    if (connection_proxy) {
+        connection_proxy->delete_ds();
+        delete connection_proxy;
+        connection_proxy = nullptr;
+    }
+    connection_owner.reset();
+}
+
+std::string TOPOLOGY_MONITOR::get_topology_signature(std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology) {
+    std::vector<std::string> hosts;
+    for (const auto& host : topology->get_instances()) {
+        hosts.push_back((host->is_host_writer() ? "W:" : "R:") + host->get_host_port_pair());
+    }
+    std::sort(hosts.begin(), hosts.end());
+
+    std::stringstream signature;
+    for (const auto& host : hosts) {
+        signature << host << ";";
+    }
+    return signature.str();
+}
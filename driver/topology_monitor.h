@@ -0,0 +1,113 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#ifndef __TOPOLOGY_MONITOR_H__
+#define __TOPOLOGY_MONITOR_H__
+
+#include "connection_handler.h"
+#include "host_info.h"
+#include "topology_service.h"
+
+#include <condition_variable>
+#include <list>
+#include <thread>
+
+class DataSource;
+class CONNECTION_PROXY;
+
+// Keeps the shared topology of one cluster up to date from a background thread
+// and its own connection, so that connections to the cluster don't have to
+// query the topology themselves. The monitor runs while any connection holds it.
+class TOPOLOGY_MONITOR {
+public:
+    TOPOLOGY_MONITOR(
+        std::string cluster_id,
+        std::shared_ptr<HOST_INFO> host_template,
+        std::shared_ptr<HOST_INFO> initial_host,
+        DataSource* ds,
+        unsigned long dbc_id,
+        bool enable_logging = false);
+    virtual ~TOPOLOGY_MONITOR();
+
+    // Returns the running monitor of the cluster, creating one if needed
+    static std::shared_ptr<TOPOLOGY_MONITOR> get_or_create(
+        std::string cluster_id,
+        std::shared_ptr<HOST_INFO> host_template,
+        std::shared_ptr<HOST_INFO> initial_host,
+        DataSource* ds,
+        unsigned long dbc_id,
+        bool enable_logging = false);
+
+    void add_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler);
+    void remove_connection_handler(std::shared_ptr<CONNECTION_HANDLER> connection_handler);
+    // Polls the cluster right away and at the fast rate until the topology settles
+    void request_fast_refresh();
+
+    static std::chrono::milliseconds get_refresh_interval(
+        int refresh_rate_ms, int fast_refresh_rate_ms, int unchanged_polls);
+
+    // Number of unchanged polls after which the topology is considered stable
+    static constexpr int STABLE_POLLS = 3;
+    // Stable polling slows down to at most this multiple of the refresh rate
+    static constexpr int MAX_STABLE_BACKOFF = 4;
+
+private:
+    std::string cluster_id;
+    std::shared_ptr<HOST_INFO> initial_host;
+    std::shared_ptr<TOPOLOGY_SERVICE> topology_service;
+    std::list<std::shared_ptr<CONNECTION_HANDLER>> connection_handlers;
+    // Handler the current connection was opened through
+    std::shared_ptr<CONNECTION_HANDLER> connection_owner;
+    CONNECTION_PROXY* connection_proxy = nullptr;
+    DataSource* ds = nullptr;
+    int refresh_rate_ms;
+    int fast_refresh_rate_ms;
+    std::shared_ptr<FILE> logger;
+    unsigned long dbc_id = 0;
+    // Guards the connection and its handlers, held while querying the topology
+    std::mutex connection_mutex;
+    // Guards the flags below
+    std::mutex state_mutex;
+    bool should_stop = false;
+    bool fast_refresh_requested = false;
+    std::condition_variable cv;
+    std::thread thread;
+
+    void run();
+    bool connect();
+    void release_connection();
+    static std::string get_topology_signature(std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology);
+
+#ifdef UNIT_TEST_BUILD
+    // Allows for testing private methods
+    friend class TEST_UTILS;
+#endif
+};
+
+#endif /* __TOPOLOGY_MONITOR_H__ */
@@ -28,9 +28,54 @@
 // http://www.gnu.org/licenses/gpl-2.0.html.
 
 #include "cluster_aware_metrics_container.h"
+#include "dns_cache.h"
 #include "topology_service.h"
+#include <shared_mutex>
 #include <sstream>
 
+namespace {
+struct TOPOLOGY_CACHE_ENTRY {
+    std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology;
+    // Incremented every time a new topology is put to the cache
+    unsigned long long generation = 0;
+    // Held by the connection querying the cluster for its topology
+    std::mutex refresh_mutex;
+};
+
+// Topologies of all clusters the process is connected to, keyed by cluster ID.
+// Shared by every connection, so only one of them queries a cluster at a time.
+std::map<std::string, std::shared_ptr<TOPOLOGY_CACHE_ENTRY>> topology_cache;
+std::shared_mutex topology_cache_mutex;
+
+std::shared_ptr<TOPOLOGY_CACHE_ENTRY> get_cache_entry(const std::string& cluster_id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(topology_cache_mutex);
+        auto result = topology_cache.find(cluster_id);
+        if (result != topology_cache.end()) {
+            return result->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(topology_cache_mutex);
+    auto& entry = topology_cache[cluster_id];
+    if (!entry) {
+        entry = std::make_shared<TOPOLOGY_CACHE_ENTRY>();
+    }
+    return entry;
+}
+
+unsigned long long get_generation(const std::shared_ptr<TOPOLOGY_CACHE_ENTRY>& entry) {
+    std::shared_lock<std::shared_mutex> lock(topology_cache_mutex);
+    return entry->generation;
+}
+
+// Must be called while holding topology_cache_mutex
+std::shared_ptr<CLUSTER_TOPOLOGY_INFO> find_topology(const std::string& cluster_id) {
+    auto result = topology_cache.find(cluster_id);
+    return result != topology_cache.end() ? result->second->topology : nullptr;
+}
+}  // namespace
+
 TOPOLOGY_SERVICE::TOPOLOGY_SERVICE(unsigned long dbc_id, bool enable_logging)
     : dbc_id{dbc_id},
       cluster_instance_host{nullptr},
@@ -48,6 +93,8 @@ TOPOLOGY_SERVICE::TOPOLOGY_SERVICE(const TOPOLOGY_SERVICE& ts) {
     refresh_rate_in_ms = ts.refresh_rate_in_ms;
     cluster_id = ts.cluster_id;
     cluster_instance_host = ts.cluster_instance_host;
+    background_refresh = ts.background_refresh;
+    dns_cache_ttl_ms = ts.dns_cache_ttl_ms;
     logger = ts.logger;
     dbc_id = ts.dbc_id;
     metrics_container = ts.metrics_container;
@@ -82,6 +129,18 @@ void TOPOLOGY_SERVICE::set_refresh_rate(int refresh_rate) {
     refresh_rate_in_ms = refresh_rate;
 }
 
+void TOPOLOGY_SERVICE::set_dns_cache_ttl(int dns_cache_ttl_ms) {
+    this->dns_cache_ttl_ms = dns_cache_ttl_ms;
+}
+
+void TOPOLOGY_SERVICE::set_background_refresh(bool background_refresh) {
+    this->background_refresh = background_refresh;
+}
+
+std::shared_ptr<HOST_INFO> TOPOLOGY_SERVICE::get_cluster_instance_template() {
+    return cluster_instance_host;
+}
+
 std::shared_ptr<HOST_INFO> TOPOLOGY_SERVICE::get_last_used_reader() {
     auto topology_info = get_from_cache();
     if (!topology_info || refresh_needed(topology_info->time_last_updated())) {
@@ -93,8 +152,8 @@ std::shared_ptr<HOST_INFO> TOPOLOGY_SERVICE::get_last_used_reader() {
 
 void TOPOLOGY_SERVICE::set_last_used_reader(std::shared_ptr<HOST_INFO> reader) {
     if (reader) {
-        std::unique_lock<std::mutex> lock(topology_cache_mutex);
-        auto topology_info = get_from_cache();
+        std::unique_lock<std::shared_mutex> lock(topology_cache_mutex);
+        auto topology_info = find_topology(cluster_id);
         if (topology_info) {
             topology_info->set_last_used_reader(reader);
         }
@@ -105,8 +164,8 @@ void TOPOLOGY_SERVICE::set_last_used_reader(std::shared_ptr<HOST_INFO> reader) {
 std::set<std::string> TOPOLOGY_SERVICE::get_down_hosts() {
     std::set<std::string> down_hosts;
 
-    std::unique_lock<std::mutex> lock(topology_cache_mutex);
-    auto topology_info = get_from_cache();
+    std::shared_lock<std::shared_mutex> lock(topology_cache_mutex);
+    auto topology_info = find_topology(cluster_id);
     if (topology_info) {
         down_hosts = topology_info->get_down_hosts();
     }
@@ -120,9 +179,9 @@ void TOPOLOGY_SERVICE::mark_host_down(std::shared_ptr<HOST_INFO> host) {
         return;
     }
 
-    std::unique_lock<std::mutex> lock(topology_cache_mutex);
+    std::unique_lock<std::shared_mutex> lock(topology_cache_mutex);
 
-    auto topology_info = get_from_cache();
+    auto topology_info = find_topology(cluster_id);
     if (topology_info) {
         topology_info->mark_host_down(host);
     }
@@ -135,9 +194,9 @@ void TOPOLOGY_SERVICE::mark_host_up(std::shared_ptr<HOST_INFO> host) {
         return;
     }
 
-    std::unique_lock<std::mutex> lock(topology_cache_mutex);
+    std::unique_lock<std::shared_mutex> lock(topology_cache_mutex);
 
-    auto topology_info = get_from_cache();
+    auto topology_info = find_topology(cluster_id);
     if (topology_info) {
         topology_info->mark_host_up(host);
     }
@@ -150,13 +209,13 @@ void TOPOLOGY_SERVICE::set_gather_metric(bool can_gather) {
 }
 
 void TOPOLOGY_SERVICE::clear_all() {
-    std::unique_lock<std::mutex> lock(topology_cache_mutex);
+    std::unique_lock<std::shared_mutex> lock(topology_cache_mutex);
     topology_cache.clear();
     lock.unlock();
 }
 
 void TOPOLOGY_SERVICE::clear() {
-    std::unique_lock<std::mutex> lock(topology_cache_mutex);
+    std::unique_lock<std::shared_mutex> lock(topology_cache_mutex);
     topology_cache.erase(cluster_id);
     lock.unlock();
 }
@@ -166,19 +225,38 @@ std::shared_ptr<CLUSTER_TOPOLOGY_INFO> TOPOLOGY_SERVICE::get_cached_topology() {
 }
 
 std::shared_ptr<CLUSTER_TOPOLOGY_INFO> TOPOLOGY_SERVICE::get_topology(CONNECTION_PROXY* connection, bool force_update) {
-    // TODO reconsider using this cache. It appears that we only store information for the current cluster Id.
-    // therefore instead of a map we can just keep CLUSTER_TOPOLOGY_INFO* topology_info member variable.
+    // The generation is read first, so a topology put to the cache after it
+    // is either returned below or noticed once the refresh lock is held
+    auto entry = get_cache_entry(cluster_id);
+    const auto generation = get_generation(entry);
     auto cached_topology = get_from_cache();
-    if (!cached_topology
-        || force_update
-        || refresh_needed(cached_topology->time_last_updated()))
+    if (cached_topology
+        && !force_update
+        && (background_refresh || !refresh_needed(cached_topology->time_last_updated())))
     {
-        if (auto latest_topology = query_for_topology(connection)) {
-            put_to_cache(latest_topology);
+        return cached_topology;
+    }
+
+    std::unique_lock<std::mutex> refresh_lock(entry->refresh_mutex, std::defer_lock);
+    if (!refresh_lock.try_lock()) {
+        // Another connection is already querying this cluster
+        if (cached_topology && !force_update) {
+            return cached_topology;
+        }
+
+        refresh_lock.lock();
+    }
+    if (get_generation(entry) != generation) {
+        if (auto latest_topology = get_from_cache()) {
             return latest_topology;
         }
     }
 
+    if (auto latest_topology = query_for_topology(connection)) {
+        put_to_cache(latest_topology);
+        return latest_topology;
+    }
+
     return cached_topology;
 }
 
@@ -215,37 +293,33 @@ std::string TOPOLOGY_SERVICE::log_topology(const std::shared_ptr<CLUSTER_TOPOLOG
     return topology_str.str();
 }
 
-// TODO consider thread safety and usage of pointers
 std::shared_ptr<CLUSTER_TOPOLOGY_INFO> TOPOLOGY_SERVICE::get_from_cache() {
-    if (topology_cache.empty()) {
-        metrics_container->register_use_cached_topology(false);
-        return nullptr;
-    }
-        
-    auto result = topology_cache.find(cluster_id);
-    if (result == topology_cache.end()) {
-        metrics_container->register_use_cached_topology(false);
-        return nullptr;
-    }
-    
-    metrics_container->register_use_cached_topology(true);
-    return result->second;
+    std::shared_lock<std::shared_mutex> lock(topology_cache_mutex);
+    auto topology_info = find_topology(cluster_id);
+    lock.unlock();
+
+    metrics_container->register_use_cached_topology(topology_info != nullptr);
+    return topology_info;
 }
 
-// TODO consider thread safety and usage of pointers
 void TOPOLOGY_SERVICE::put_to_cache(std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology_info) {
-    if (!topology_cache.empty())
-    {
-        auto result = topology_cache.find(cluster_id);
-        if (result != topology_cache.end()) {
-            result->second.reset();
-            result->second = topology_info;
-            return;
-        }
+    std::unique_lock<std::shared_mutex> lock(topology_cache_mutex);
+    auto& entry = topology_cache[cluster_id];
+    if (!entry) {
+        entry = std::make_shared<TOPOLOGY_CACHE_ENTRY>();
     }
-    std::unique_lock<std::mutex> lock(topology_cache_mutex);
-    topology_cache[cluster_id] = topology_info;
+    entry->topology = topology_info;
+    entry->generation++;
     lock.unlock();
+
+    // Keep the addresses of the instances cached for failover and new connections
+    if (dns_cache_ttl_ms > 0 && topology_info) {
+        std::vector<std::string> hosts;
+        for (const auto& host : topology_info->get_instances()) {
+            hosts.push_back(host->get_host());
+        }
+        DNS_CACHE::get_instance().prefetch(hosts, std::chrono::milliseconds(dns_cache_ttl_ms));
+    }
 }
 
 MYSQL_RES* TOPOLOGY_SERVICE::try_execute_query(CONNECTION_PROXY* connection_proxy, const char* query) {
@@ -52,9 +52,6 @@
     WHERE time_to_sec(timediff(now(), LAST_UPDATE_TIMESTAMP)) <= 300 \
     ORDER BY LAST_UPDATE_TIMESTAMP DESC"
 
-static std::map<std::string, std::shared_ptr<CLUSTER_TOPOLOGY_INFO>> topology_cache;
-static std::mutex topology_cache_mutex;
-
 class TOPOLOGY_SERVICE {
  public:
   TOPOLOGY_SERVICE(unsigned long dbc_id, bool enable_logging = false);
@@ -68,7 +65,7 @@ class TOPOLOGY_SERVICE {
   virtual std::shared_ptr<CLUSTER_TOPOLOGY_INFO> get_topology(CONNECTION_PROXY* connection, bool force_update = false);
   virtual std::shared_ptr<CLUSTER_TOPOLOGY_INFO> get_filtered_topology(std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology);
   virtual std::string log_topology(const std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology);
-  std::shared_ptr<CLUSTER_TOPOLOGY_INFO> get_cached_topology();
+  virtual std::shared_ptr<CLUSTER_TOPOLOGY_INFO> get_cached_topology();
 
   std::shared_ptr<HOST_INFO> get_last_used_reader();
   void set_last_used_reader(std::shared_ptr<HOST_INFO> reader);
@@ -76,6 +73,12 @@ class TOPOLOGY_SERVICE {
   virtual void mark_host_down(std::shared_ptr<HOST_INFO> host);
   virtual void mark_host_up(std::shared_ptr<HOST_INFO> host);
   void set_refresh_rate(int refresh_rate);
+  // Instance endpoints of new topologies are resolved ahead of use, 0 to disable
+  void set_dns_cache_ttl(int dns_cache_ttl_ms);
+  // When the topology is refreshed in the background, get_topology() returns
+  // the cached topology without querying unless an update is forced
+  void set_background_refresh(bool background_refresh);
+  std::shared_ptr<HOST_INFO> get_cluster_instance_template();
   void set_gather_metric(bool can_gather);
   void clear_all();
   void clear();
@@ -106,6 +109,8 @@ class TOPOLOGY_SERVICE {
  protected:
   const int NO_CONNECTION_INDEX = -1;
   int refresh_rate_in_ms;
+  bool background_refresh = false;
+  int dns_cache_ttl_ms = 0;
 
   std::string cluster_id;
   std::shared_ptr<HOST_INFO> cluster_instance_host;
@@ -35,6 +35,7 @@
 
 #include "driver.h"
 #include "errmsg.h"
+#include <algorithm>
 #include <ctype.h>
 #include <iostream>
 #include <map>
@@ -152,6 +153,7 @@ void fix_result_types(STMT *stmt)
   int capint32= stmt->dbc->ds->opt_COLUMN_SIZE_S32 ? 1 : 0;
 
   stmt->state= ST_EXECUTED;  /* Mark set found */
+  stmt->fetch_plan.reset();  /* Columns may differ from the previous result */
 
   /* Populate the IRD records */
   size_t f_count = stmt->field_count();
@@ -2433,6 +2435,17 @@ bool is_server_alive( DBC *dbc )
     time_t seconds= (time_t) time( (time_t*)0 );
     bool server_alive = true;
 
+    /*
+      A lost connection is detected by the query itself: writing it fails
+      and the error goes through the same connection lost handling as a
+      failed ping.
+    */
+    if (dbc->ds && dbc->ds->opt_NO_IDLE_PING)
+    {
+        dbc->last_query_time = seconds;
+        return server_alive;
+    }
+
     if ( (ulong)(seconds - dbc->last_query_time) >= CHECK_IF_ALIVE )
     {
         if ( dbc->connection_proxy->ping() )
@@ -3152,9 +3165,12 @@ SQLRETURN set_sql_select_limit(DBC *dbc, SQLULEN lim_value, my_bool req_lock)
   char query[44];
   SQLRETURN rc;
 
-  /* Both 0 and max(SQLULEN) value mean no limit and sql_select_limit to DEFAULT */
+  /* Both 0 and max(SQLULEN) value mean no limit and sql_select_limit to DEFAULT.
+     A session in which the driver has not set the limit has the default one. */
   if (lim_value == dbc->sql_select_limit
-   || lim_value == sql_select_unlimited && dbc->sql_select_limit == 0)
+   || (lim_value == 0 || lim_value == sql_select_unlimited)
+      && (dbc->sql_select_limit == 0
+          || dbc->sql_select_limit == sql_select_unlimited))
     return SQL_SUCCESS;
 
   if (lim_value > 0 && lim_value < sql_select_unlimited)
@@ -3901,12 +3917,15 @@ char *tempBuf::extend_buffer(size_t len)
 
   if (len > buf_len - cur_pos)
   {
-    buf = (char*)realloc(buf, buf_len + len);
+    /* Growing at least twice so that appending large queries piece by piece
+       does not reallocate the buffer on every append */
+    size_t new_len = std::max(buf_len + len, buf_len * 2);
+    buf = (char*)realloc(buf, new_len);
 
     // TODO: smarter processing for Out-of-Memory
     if (buf == NULL)
       throw "Not enough memory for buffering";
-    buf_len += len;
+    buf_len = new_len;
   }
 
   return buf + cur_pos; // Return position in the new buffer
@@ -3954,6 +3973,13 @@ void tempBuf::reset()
   cur_pos = 0;
 }
 
+void tempBuf::swap(tempBuf &b)
+{
+  std::swap(buf, b.buf);
+  std::swap(buf_len, b.buf_len);
+  std::swap(cur_pos, b.cur_pos);
+}
+
 tempBuf::~tempBuf()
 {
   if (buf_len && buf)
@@ -4275,6 +4301,38 @@ SQLULEN get_query_timeout(STMT *stmt)
 }
 
 
+/**
+  Returns the value of @@max_allowed_packet, i.e. the size of the largest
+  query the server accepts, limited by the packet size of the client. The
+  variable is read once per connection. If it cannot be read, the smallest
+  default among the supported servers is used.
+
+  @param[in]  stmt        stmt handler
+ */
+unsigned long get_max_allowed_packet(STMT *stmt)
+{
+  DBC *dbc= stmt->dbc;
+
+  if (!dbc->max_allowed_packet)
+  {
+    char max_allowed_packet[32]= {0};
+    uint length= get_session_variable(stmt, "MAX_ALLOWED_PACKET",
+                                      max_allowed_packet,
+                                      sizeof(max_allowed_packet) - 1);
+    unsigned long client_max_packet= dbc->connection_proxy->get_max_packet();
+
+    max_allowed_packet[length]= 0;
+    dbc->max_allowed_packet= strtoul(max_allowed_packet, NULL, 10);
+    if (!dbc->max_allowed_packet)
+      dbc->max_allowed_packet= MIN_DEFAULT_MAX_ALLOWED_PACKET;
+    if (client_max_packet && client_max_packet < dbc->max_allowed_packet)
+      dbc->max_allowed_packet= client_max_packet;
+  }
+
+  return dbc->max_allowed_packet;
+}
+
+
 const char get_identifier_quote(STMT *stmt)
 {
   const char tick= '`', quote= '"', empty= ' ';
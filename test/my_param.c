@@ -1206,6 +1206,163 @@ DECLARE_TEST(t_bug56804)
 }
 
 
+/*
+  Arrays of parameters of an INSERT sent as multi-row statements with
+  ENABLE_BATCH_INSERTS. A failed statement fails all its paramsets.
+*/
+DECLARE_TEST(paramarray_batch_insert)
+{
+#define PARAMSET_SIZE 10
+  SQLHENV       henv1;
+  SQLHDBC       hdbc1;
+  SQLHSTMT      hstmt1;
+  SQLINTEGER    id[PARAMSET_SIZE];
+  SQLUSMALLINT  operation[PARAMSET_SIZE];
+  SQLUSMALLINT  status[PARAMSET_SIZE];
+  SQLULEN       processed, i;
+
+  is(OK == alloc_basic_handles_with_opt(&henv1, &hdbc1, &hstmt1, NULL, NULL,
+                                        NULL, NULL,
+                                        (SQLCHAR*)"ENABLE_BATCH_INSERTS=1"));
+
+  ok_sql(hstmt1, "DROP TABLE IF EXISTS t_batch_insert");
+  ok_sql(hstmt1, "CREATE TABLE t_batch_insert (id INT PRIMARY KEY)");
+  ok_sql(hstmt1, "INSERT INTO t_batch_insert VALUES (5)");
+
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    id[i]= (SQLINTEGER)i;
+    operation[i]= i == 3 ? SQL_PARAM_IGNORE : SQL_PARAM_PROCEED;
+  }
+
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)PARAMSET_SIZE, 0));
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAM_OPERATION_PTR, operation, 0));
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAM_STATUS_PTR, status, 0));
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0));
+  ok_stmt(hstmt1, SQLBindParameter(hstmt1, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+                                   SQL_INTEGER, 0, 0, id, 0, NULL));
+  ok_stmt(hstmt1, SQLPrepare(hstmt1, (SQLCHAR*)"INSERT INTO t_batch_insert VALUES (?)", SQL_NTS));
+
+  /* All paramsets are in the same statement, the duplicate fails all of them */
+  expect_stmt(hstmt1, SQLExecute(hstmt1), SQL_ERROR);
+  is_num(processed, PARAMSET_SIZE);
+
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    if (i == 3)
+      is_num(status[i], SQL_PARAM_UNUSED);
+    else if (i == PARAMSET_SIZE - 1)
+      is_num(status[i], SQL_PARAM_ERROR);
+    else
+      is_num(status[i], SQL_PARAM_DIAG_UNAVAILABLE);
+  }
+
+  ok_sql(hstmt, "DELETE FROM t_batch_insert");
+
+  ok_stmt(hstmt1, SQLExecute(hstmt1));
+  is_num(processed, PARAMSET_SIZE);
+
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    is_num(status[i], i == 3 ? SQL_PARAM_UNUSED : SQL_PARAM_SUCCESS);
+  }
+
+  ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_CLOSE));
+  ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_RESET_PARAMS));
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0));
+
+  ok_sql(hstmt1, "SELECT COUNT(*), SUM(id) FROM t_batch_insert");
+  ok_stmt(hstmt1, SQLFetch(hstmt1));
+  is_num(my_fetch_int(hstmt1, 1), PARAMSET_SIZE - 1);
+  is_num(my_fetch_int(hstmt1, 2), 45 - 3);
+  ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_CLOSE));
+
+  ok_sql(hstmt1, "DROP TABLE IF EXISTS t_batch_insert");
+  free_basic_handles(&henv1, &hdbc1, &hstmt1);
+
+  return OK;
+#undef PARAMSET_SIZE
+}
+
+
+/*
+  Multi-row INSERT statements are split to stay within max_allowed_packet
+  of the server. Each paramset takes a third of it, so that at most two of
+  them fit into one statement.
+*/
+DECLARE_TEST(paramarray_batch_insert_split)
+{
+#define PARAMSET_SIZE 4
+  SQLHENV       henv1;
+  SQLHDBC       hdbc1;
+  SQLHSTMT      hstmt1;
+  SQLUSMALLINT  status[PARAMSET_SIZE];
+  SQLLEN        ind[PARAMSET_SIZE];
+  SQLULEN       processed, i;
+  SQLLEN        max_allowed_packet, value_length;
+  SQLCHAR      *values;
+
+  ok_sql(hstmt, "SELECT @@max_allowed_packet");
+  ok_stmt(hstmt, SQLFetch(hstmt));
+  max_allowed_packet= my_fetch_int(hstmt, 1);
+  ok_stmt(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+
+  if (max_allowed_packet > 64L * 1024L * 1024L)
+  {
+    skip("max_allowed_packet is too large for the test");
+  }
+
+  value_length= max_allowed_packet / 3;
+  values= (SQLCHAR*)malloc(value_length * PARAMSET_SIZE);
+  memset(values, 'a', value_length * PARAMSET_SIZE);
+
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    ind[i]= value_length;
+  }
+
+  is(OK == alloc_basic_handles_with_opt(&henv1, &hdbc1, &hstmt1, NULL, NULL,
+                                        NULL, NULL,
+                                        (SQLCHAR*)"ENABLE_BATCH_INSERTS=1"));
+
+  ok_sql(hstmt1, "DROP TABLE IF EXISTS t_batch_insert_split");
+  ok_sql(hstmt1, "CREATE TABLE t_batch_insert_split (id INT AUTO_INCREMENT PRIMARY KEY, val LONGTEXT)");
+
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)PARAMSET_SIZE, 0));
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAM_STATUS_PTR, status, 0));
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0));
+  ok_stmt(hstmt1, SQLBindParameter(hstmt1, 1, SQL_PARAM_INPUT, SQL_C_CHAR,
+                                   SQL_LONGVARCHAR, value_length, 0, values,
+                                   value_length, ind));
+
+  /* Would fail with ER_NET_PACKET_TOO_LARGE if sent as a single statement */
+  ok_stmt(hstmt1, SQLExecDirect(hstmt1, (SQLCHAR*)"INSERT INTO t_batch_insert_split (val) VALUES (?)", SQL_NTS));
+  is_num(processed, PARAMSET_SIZE);
+
+  for (i= 0; i < PARAMSET_SIZE; ++i)
+  {
+    is_num(status[i], SQL_PARAM_SUCCESS);
+  }
+
+  ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_CLOSE));
+  ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_RESET_PARAMS));
+  ok_stmt(hstmt1, SQLSetStmtAttr(hstmt1, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0));
+  free(values);
+
+  ok_sql(hstmt1, "SELECT COUNT(*), MIN(LENGTH(val)) FROM t_batch_insert_split");
+  ok_stmt(hstmt1, SQLFetch(hstmt1));
+  is_num(my_fetch_int(hstmt1, 1), PARAMSET_SIZE);
+  is_num(my_fetch_int(hstmt1, 2), value_length);
+  ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_CLOSE));
+
+  ok_sql(hstmt1, "DROP TABLE IF EXISTS t_batch_insert_split");
+  free_basic_handles(&henv1, &hdbc1, &hstmt1);
+
+  return OK;
+#undef PARAMSET_SIZE
+}
+
+
 /*
   Bug 59772 - Column parameter binding makes SQLExecute not to return
   SQL_ERROR on disconnect
@@ -2422,6 +2579,8 @@ BEGIN_TESTS
 #ifndef USE_IODBC
   ADD_TEST(t_bug56804)
 #endif
+  ADD_TEST(paramarray_batch_insert)
+  ADD_TEST(paramarray_batch_insert_split)
   ADD_TEST_UNICODE(t_bug31678876)
   ADD_TEST(t_param_offset)
   ADD_TEST(t_bug49029)
@@ -1279,6 +1279,245 @@ DECLARE_TEST(t_bug31667091)
   return OK;
 }
 
+/*
+  Integer and date/time columns of server-side prepared statement results
+  are converted straight into the bound C types. The values must be the
+  same as with the text protocol.
+*/
+DECLARE_TEST(t_prep_bound_conversions)
+{
+  char *conn_opt[]= { "NO_SSPS=0", "NO_SSPS=1" };
+  int   i;
+
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_conv");
+  ok_sql(hstmt, "CREATE TABLE t_prep_conv (id INT, ti TINYINT, uti TINYINT UNSIGNED,"
+                "i INT, ubi BIGINT UNSIGNED, d DATE, dt DATETIME(6), zd DATE)");
+  ok_sql(hstmt, "SET @@SESSION.sql_mode=''");
+  ok_sql(hstmt, "INSERT INTO t_prep_conv VALUES (1, -128, 255, -2147483647,"
+                "18446744073709551615, '2024-02-29', '2024-02-29 23:59:58.123456',"
+                "'0000-00-00')");
+  ok_sql(hstmt, "SET @@SESSION.sql_mode=DEFAULT");
+
+  for (i= 0; i < 2; ++i)
+  {
+    DECLARE_BASIC_HANDLES(henv1, hdbc1, hstmt1);
+    SQLINTEGER            id= 0, int_val;
+    SQLSCHAR              ti;
+    SQLCHAR               uti;
+    SQLUBIGINT            ubi;
+    double                int_as_double;
+    SQL_DATE_STRUCT       d, zd;
+    SQL_TIMESTAMP_STRUCT  dt;
+    SQLLEN                zd_ind;
+
+    is(OK == alloc_basic_handles_with_opt(&henv1, &hdbc1, &hstmt1, NULL,
+                                          NULL, NULL, NULL,
+                                          (SQLCHAR*)conn_opt[i]));
+
+    /* The parameter makes the driver prepare the query on the server */
+    ok_stmt(hstmt1, SQLPrepare(hstmt1, (SQLCHAR*)"SELECT ti, uti, i, ubi, i, d, dt, zd "
+                               "FROM t_prep_conv WHERE id > ?", SQL_NTS));
+    ok_stmt(hstmt1, SQLBindParameter(hstmt1, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+                                     SQL_INTEGER, 0, 0, &id, 0, NULL));
+
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 1, SQL_C_STINYINT, &ti, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 2, SQL_C_UTINYINT, &uti, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 3, SQL_C_SLONG, &int_val, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 4, SQL_C_UBIGINT, &ubi, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 5, SQL_C_DOUBLE, &int_as_double, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 6, SQL_C_TYPE_DATE, &d, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 7, SQL_C_TYPE_TIMESTAMP, &dt, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 8, SQL_C_TYPE_DATE, &zd, 0, &zd_ind));
+
+    ok_stmt(hstmt1, SQLExecute(hstmt1));
+    ok_stmt(hstmt1, SQLFetch(hstmt1));
+
+    is_num(ti, -128);
+    is_num(uti, 255);
+    is_num(int_val, -2147483647);
+    is(ubi == 18446744073709551615ULL);
+    is(int_as_double == -2147483647.0);
+    is_num(d.year, 2024);
+    is_num(d.month, 2);
+    is_num(d.day, 29);
+    is_num(dt.year, 2024);
+    is_num(dt.month, 2);
+    is_num(dt.day, 29);
+    is_num(dt.hour, 23);
+    is_num(dt.minute, 59);
+    is_num(dt.second, 58);
+    is_num(dt.fraction, 123456000);
+    /* ODBC can't handle 0000-00-00 dates */
+    is_num(zd_ind, SQL_NULL_DATA);
+
+    expect_stmt(hstmt1, SQLFetch(hstmt1), SQL_NO_DATA);
+    ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_CLOSE));
+    free_basic_handles(&henv1, &hdbc1, &hstmt1);
+  }
+
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_conv");
+  return OK;
+}
+
+
+/*
+  The way bound columns are filled is worked out once per result and
+  binding. Changing the binding or the bind offset between fetches must
+  still be honored.
+*/
+DECLARE_TEST(t_prep_rebind_between_fetches)
+{
+  SQLINTEGER  id= 0, first= 0, second= 0, vals[2]= {0, 0};
+  SQLCHAR     str[16];
+  SQLLEN      str_len, offset= 0;
+
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_rebind");
+  ok_sql(hstmt, "CREATE TABLE t_prep_rebind (id INT)");
+  ok_sql(hstmt, "INSERT INTO t_prep_rebind VALUES (1), (2), (3), (4), (5), (6)");
+
+  ok_stmt(hstmt, SQLPrepare(hstmt, (SQLCHAR*)"SELECT id FROM t_prep_rebind "
+                            "WHERE id > ? ORDER BY id", SQL_NTS));
+  ok_stmt(hstmt, SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+                                  SQL_INTEGER, 0, 0, &id, 0, NULL));
+  ok_stmt(hstmt, SQLExecute(hstmt));
+
+  ok_stmt(hstmt, SQLBindCol(hstmt, 1, SQL_C_LONG, &first, 0, NULL));
+  ok_stmt(hstmt, SQLFetch(hstmt));
+  is_num(first, 1);
+
+  /* Another buffer of the same type */
+  ok_stmt(hstmt, SQLBindCol(hstmt, 1, SQL_C_LONG, &second, 0, NULL));
+  ok_stmt(hstmt, SQLFetch(hstmt));
+  is_num(first, 1);
+  is_num(second, 2);
+
+  /* Another type */
+  ok_stmt(hstmt, SQLBindCol(hstmt, 1, SQL_C_CHAR, str, sizeof(str), &str_len));
+  ok_stmt(hstmt, SQLFetch(hstmt));
+  is_num(second, 2);
+  is_str(str, "3", 2);
+  is_num(str_len, 1);
+
+  /* The offset is applied to the buffer bound before */
+  ok_stmt(hstmt, SQLBindCol(hstmt, 1, SQL_C_LONG, &vals[0], 0, NULL));
+  offset= sizeof(SQLINTEGER);
+  ok_stmt(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_BIND_OFFSET_PTR, &offset, 0));
+  ok_stmt(hstmt, SQLFetch(hstmt));
+  is_num(vals[0], 0);
+  is_num(vals[1], 4);
+
+  /* Data is not retrieved, then retrieved again */
+  ok_stmt(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_RETRIEVE_DATA,
+                                (SQLPOINTER)SQL_RD_OFF, 0));
+  ok_stmt(hstmt, SQLFetch(hstmt));
+  is_num(vals[1], 4);
+  ok_stmt(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_RETRIEVE_DATA,
+                                (SQLPOINTER)SQL_RD_ON, 0));
+  ok_stmt(hstmt, SQLFetch(hstmt));
+  is_num(vals[1], 6);
+
+  ok_stmt(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_BIND_OFFSET_PTR, NULL, 0));
+  ok_stmt(hstmt, SQLFreeStmt(hstmt, SQL_UNBIND));
+  ok_stmt(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+  ok_stmt(hstmt, SQLFreeStmt(hstmt, SQL_RESET_PARAMS));
+
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_rebind");
+  return OK;
+}
+
+
+/*
+  Fetching with SQL_ATTR_RETRIEVE_DATA set to SQL_RD_OFF only positions the
+  cursor, the bound buffers of prepared statement columns are not written.
+*/
+DECLARE_TEST(t_prep_retrieve_data_off)
+{
+  SQLINTEGER id= 0, int_val= 12345;
+  SQL_DATE_STRUCT d;
+
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_rd_off");
+  ok_sql(hstmt, "CREATE TABLE t_prep_rd_off (id INT, i INT, d DATE)");
+  ok_sql(hstmt, "INSERT INTO t_prep_rd_off VALUES (1, 7, '2024-02-29')");
+
+  memset(&d, 0xAB, sizeof(d));
+
+  ok_stmt(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_RETRIEVE_DATA,
+                                (SQLPOINTER)SQL_RD_OFF, 0));
+  ok_stmt(hstmt, SQLPrepare(hstmt, (SQLCHAR*)"SELECT i, d FROM t_prep_rd_off "
+                            "WHERE id > ?", SQL_NTS));
+  ok_stmt(hstmt, SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+                                  SQL_INTEGER, 0, 0, &id, 0, NULL));
+  ok_stmt(hstmt, SQLBindCol(hstmt, 1, SQL_C_SLONG, &int_val, 0, NULL));
+  ok_stmt(hstmt, SQLBindCol(hstmt, 2, SQL_C_TYPE_DATE, &d, 0, NULL));
+
+  ok_stmt(hstmt, SQLExecute(hstmt));
+  ok_stmt(hstmt, SQLFetch(hstmt));
+
+  is_num(int_val, 12345);
+  is_num(d.year, 0xABAB);
+
+  expect_stmt(hstmt, SQLFetch(hstmt), SQL_NO_DATA);
+  ok_stmt(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+  ok_stmt(hstmt, SQLFreeStmt(hstmt, SQL_UNBIND));
+  ok_stmt(hstmt, SQLFreeStmt(hstmt, SQL_RESET_PARAMS));
+  ok_stmt(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_RETRIEVE_DATA,
+                                (SQLPOINTER)SQL_RD_ON, 0));
+
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_rd_off");
+  return OK;
+}
+
+
+/*
+  Prepared statements cached by the connection are bound to the database
+  they were prepared in. After USE, preparing the same query again must
+  not return a statement of the previous database.
+*/
+DECLARE_TEST(t_prep_cache_use_db)
+{
+  DECLARE_BASIC_HANDLES(henv1, hdbc1, hstmt1);
+  SQLINTEGER id= 1, val;
+  int        i;
+
+  ok_sql(hstmt, "DROP DATABASE IF EXISTS t_prep_cache_db");
+  ok_sql(hstmt, "CREATE DATABASE t_prep_cache_db");
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_cache");
+  ok_sql(hstmt, "CREATE TABLE t_prep_cache (id INT, val INT)");
+  ok_sql(hstmt, "INSERT INTO t_prep_cache VALUES (1, 1)");
+  ok_sql(hstmt, "CREATE TABLE t_prep_cache_db.t_prep_cache (id INT, val INT)");
+  ok_sql(hstmt, "INSERT INTO t_prep_cache_db.t_prep_cache VALUES (1, 2)");
+
+  is(OK == alloc_basic_handles_with_opt(&henv1, &hdbc1, &hstmt1, NULL,
+                                        NULL, NULL, NULL,
+                                        (SQLCHAR*)"SSPS_CACHE_SIZE=4"));
+
+  for (i= 0; i < 2; ++i)
+  {
+    if (i)
+    {
+      ok_sql(hstmt1, "USE t_prep_cache_db");
+    }
+
+    val= 0;
+    ok_stmt(hstmt1, SQLPrepare(hstmt1, (SQLCHAR*)"SELECT val FROM t_prep_cache "
+                               "WHERE id = ?", SQL_NTS));
+    ok_stmt(hstmt1, SQLBindParameter(hstmt1, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+                                     SQL_INTEGER, 0, 0, &id, 0, NULL));
+    ok_stmt(hstmt1, SQLBindCol(hstmt1, 1, SQL_C_LONG, &val, 0, NULL));
+    ok_stmt(hstmt1, SQLExecute(hstmt1));
+    ok_stmt(hstmt1, SQLFetch(hstmt1));
+    is_num(val, i + 1);
+    ok_stmt(hstmt1, SQLFreeStmt(hstmt1, SQL_CLOSE));
+  }
+
+  free_basic_handles(&henv1, &hdbc1, &hstmt1);
+
+  ok_sql(hstmt, "DROP TABLE IF EXISTS t_prep_cache");
+  ok_sql(hstmt, "DROP DATABASE IF EXISTS t_prep_cache_db");
+  return OK;
+}
+
+
 BEGIN_TESTS
   ADD_TEST(t_prep_basic)
   ADD_TEST(t_prep_buffer_length)
@@ -1298,6 +1537,10 @@ BEGIN_TESTS
   ADD_TEST(t_bug67702)
   ADD_TEST(t_bug68243)
   ADD_TEST(t_bug67920)
+  ADD_TEST(t_prep_bound_conversions)
+  ADD_TEST(t_prep_retrieve_data_off)
+  ADD_TEST(t_prep_cache_use_db)
+  ADD_TEST(t_prep_rebind_between_fetches)
   ADD_TODO(t_bug31667091)
 END_TESTS
 
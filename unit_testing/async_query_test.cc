@@ -0,0 +1,200 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <mysqld_error.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using testing::_;
+using testing::Return;
+
+class AsyncQueryTest : public testing::Test {
+ protected:
+  SQLHENV env;
+  DBC* dbc;
+  DataSource* ds;
+  MOCK_CONNECTION_PROXY* mock_connection_proxy;
+
+  static void SetUpTestSuite() {}
+
+  static void TearDownTestSuite() { mysql_library_end(); }
+
+  void SetUp() override {
+    allocate_odbc_handles(env, dbc, ds);
+    dbc->ds = ds;
+    // A recent query spares the ping of is_server_alive()
+    dbc->last_query_time = time(nullptr);
+    mock_connection_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+    delete dbc->connection_proxy;
+    dbc->connection_proxy = mock_connection_proxy;
+  }
+
+  void TearDown() override {
+    dbc->ds = nullptr;
+    cleanup_odbc_handles(env, dbc, ds);
+  }
+};
+
+TEST_F(AsyncQueryTest, StillExecutingUntilComplete) {
+  const char* query = "SELECT 1";
+  EXPECT_CALL(*mock_connection_proxy, is_connected()).WillOnce(Return(true));
+  EXPECT_CALL(*mock_connection_proxy, real_query_nonblocking(query, 8))
+      .WillOnce(Return(NET_ASYNC_NOT_READY))
+      .WillOnce(Return(NET_ASYNC_COMPLETE));
+  EXPECT_CALL(*mock_connection_proxy, ping()).Times(0);
+
+  EXPECT_EQ(SQL_STILL_EXECUTING, dbc->execute_query_nonblocking(query, 8, true));
+  EXPECT_EQ(SQL_SUCCESS, dbc->execute_query_nonblocking(query, 8, false));
+}
+
+TEST_F(AsyncQueryTest, ErrorOfQuery) {
+  const char* query = "SELEC 1";
+  EXPECT_CALL(*mock_connection_proxy, is_connected()).WillOnce(Return(true));
+  EXPECT_CALL(*mock_connection_proxy, real_query_nonblocking(query, 7))
+      .WillOnce(Return(NET_ASYNC_ERROR));
+  EXPECT_CALL(*mock_connection_proxy, error_code()).WillRepeatedly(Return(ER_PARSE_ERROR));
+  EXPECT_CALL(*mock_connection_proxy, error()).WillRepeatedly(Return("You have an error in your SQL syntax"));
+
+  EXPECT_EQ(SQL_ERROR, dbc->execute_query_nonblocking(query, 7, true));
+  EXPECT_EQ(ER_PARSE_ERROR, dbc->error.native_error);
+}
+
+TEST_F(AsyncQueryTest, NotConnected) {
+  EXPECT_CALL(*mock_connection_proxy, is_connected()).WillOnce(Return(false));
+  EXPECT_CALL(*mock_connection_proxy, real_query_nonblocking(_, _)).Times(0);
+
+  EXPECT_EQ(SQL_ERROR, dbc->execute_query_nonblocking("SELECT 1", 8, true));
+}
+
+TEST_F(AsyncQueryTest, FinishWaitsForResponse) {
+  STMT* stmt = new STMT(dbc);
+  stmt->async.function = SQL_API_SQLEXECDIRECT;
+  stmt->async.step = ASYNC_QUERY;
+  stmt->async.query = "SELECT 1";
+  stmt->async.query_length = 8;
+  dbc->async_stmt = stmt;
+
+  EXPECT_CALL(*mock_connection_proxy, real_query_nonblocking(stmt->async.query, 8))
+      .WillOnce(Return(NET_ASYNC_NOT_READY))
+      .WillOnce(Return(NET_ASYNC_COMPLETE));
+  EXPECT_CALL(*mock_connection_proxy, wait_for_response(ASYNC_WAIT_TIMEOUT_MS)).WillOnce(Return(true));
+  EXPECT_CALL(*mock_connection_proxy, field_count()).WillOnce(Return(0));
+  EXPECT_CALL(*mock_connection_proxy, free_result(nullptr));
+
+  finish_async_call(stmt);
+  EXPECT_FALSE(stmt->async.pending());
+  EXPECT_EQ(nullptr, dbc->async_stmt);
+
+  delete stmt;
+}
+
+TEST_F(AsyncQueryTest, OtherQueriesFailWhileCallPending) {
+  STMT* stmt = new STMT(dbc);
+  dbc->async_stmt = stmt;
+  EXPECT_CALL(*mock_connection_proxy, real_query(_, _)).Times(0);
+
+  EXPECT_EQ(SQL_ERROR, dbc->execute_query("SET autocommit=1", SQL_NTS, true));
+
+  dbc->async_stmt = nullptr;
+  delete stmt;
+}
+
+#ifndef USE_IODBC
+TEST_F(AsyncQueryTest, AsyncDbcFunctionsAttribute) {
+  SQLUINTEGER value = SQL_ASYNC_DBC_ENABLE_ON;
+  EXPECT_EQ(SQL_SUCCESS, MySQLGetConnectAttr(dbc, SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE, nullptr, &value));
+  EXPECT_EQ(SQL_ASYNC_DBC_ENABLE_OFF, value);
+
+  EXPECT_EQ(SQL_SUCCESS, MySQLSetConnectAttr(dbc, SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE,
+                                             (SQLPOINTER)SQL_ASYNC_DBC_ENABLE_ON, 0));
+  EXPECT_TRUE(dbc->async_dbc_functions);
+  EXPECT_EQ(SQL_SUCCESS, MySQLGetConnectAttr(dbc, SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE, nullptr, &value));
+  EXPECT_EQ(SQL_ASYNC_DBC_ENABLE_ON, value);
+}
+#endif
+
+TEST_F(AsyncQueryTest, ConnectPollsUntilComplete) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  DataSource* connect_ds = new DataSource();
+  dbc->pending_connect_ds = connect_ds;
+  dbc->pending_connect = dbc->env->start_connect([released]() {
+    released.wait();
+    return (SQLRETURN)SQL_SUCCESS;
+  });
+
+  EXPECT_EQ(SQL_STILL_EXECUTING, dbc->init_connection(connect_ds, true));
+  EXPECT_EQ(connect_ds, dbc->pending_connect_ds);
+
+  release.set_value();
+  dbc->pending_connect.wait();
+  EXPECT_EQ(SQL_SUCCESS, dbc->init_connection(connect_ds, true));
+  EXPECT_EQ(nullptr, dbc->pending_connect_ds);
+  EXPECT_FALSE(dbc->pending_connect.valid());
+
+  delete connect_ds;
+}
+
+TEST_F(AsyncQueryTest, FreeingConnectionWaitsForConnect) {
+  SQLHDBC hdbc = nullptr;
+  ASSERT_EQ(SQL_SUCCESS, SQLAllocHandle(SQL_HANDLE_DBC, env, &hdbc));
+  DBC* connecting = static_cast<DBC*>(hdbc);
+  std::atomic<bool> connected{false};
+
+  // Freed with the connection, as the application never completes the connect
+  connecting->pending_connect_ds = new DataSource();
+  connecting->pending_connect = connecting->env->start_connect([&connected]() {
+    connected = true;
+    return (SQLRETURN)SQL_SUCCESS;
+  });
+
+  SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+  EXPECT_TRUE(connected);
+}
+
+TEST_F(AsyncQueryTest, ConnectOnWorkerThread) {
+  const auto caller = std::this_thread::get_id();
+  std::thread::id worker;
+
+  auto result = dbc->env->start_connect([&worker]() {
+    worker = std::this_thread::get_id();
+    return (SQLRETURN)SQL_SUCCESS_WITH_INFO;
+  });
+
+  EXPECT_EQ(SQL_SUCCESS_WITH_INFO, result.get());
+  EXPECT_NE(caller, worker);
+}
@@ -109,6 +109,7 @@ TEST_F(ClusterAwareMetricsContainerTest, collectClusterOnly) {
     metrics_container->register_failure_detection_time(1234);
     metrics_container->register_writer_failover_procedure_time(1234);
     metrics_container->register_reader_failover_procedure_time(1234);
+    metrics_container->register_writer_failover_poll_interval(100);
     metrics_container->register_failover_connects(true);
     metrics_container->register_invalid_initial_connection(true);
     metrics_container->register_use_cached_topology(true);
@@ -128,7 +129,7 @@ TEST_F(ClusterAwareMetricsContainerTest, collectInstance) {
     ds->opt_GATHER_PERF_METRICS_PER_INSTANCE = true;
 
     EXPECT_CALL(*metrics_container, get_curr_conn_url())
-        .Times(7)
+        .Times(8)
         .WillRepeatedly(Return(instance_url));
 
     metrics_container->set_cluster_id(cluster_id);
@@ -136,6 +137,7 @@ TEST_F(ClusterAwareMetricsContainerTest, collectInstance) {
     metrics_container->register_failure_detection_time(1234);
     metrics_container->register_writer_failover_procedure_time(1234);
     metrics_container->register_reader_failover_procedure_time(1234);
+    metrics_container->register_writer_failover_poll_interval(100);
     metrics_container->register_failover_connects(true);
     metrics_container->register_invalid_initial_connection(true);
     metrics_container->register_use_cached_topology(true);
@@ -0,0 +1,186 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "driver/dns_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+
+namespace {
+const auto TTL = std::chrono::milliseconds(60000);
+const auto TIMEOUT = std::chrono::milliseconds(10000);
+}  // namespace
+
+class DnsCacheTest : public testing::Test {
+ protected:
+    std::atomic<int> lookups{0};
+    // Lookups wait for this until the test releases them
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<std::chrono::steady_clock::rep> now{0};
+
+    void SetUp() override { release.set_value(); }
+
+    DNS_CACHE::LOOKUP lookup() {
+        return [this](const std::string& host) {
+            lookups++;
+            released.wait();
+            return host == "unknown-host" ? std::string("") : std::string("10.0.0.1");
+        };
+    }
+
+    DNS_CACHE::CLOCK clock() {
+        return [this] {
+            return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(now.load()));
+        };
+    }
+
+    void hold_lookups() {
+        release = std::promise<void>();
+        released = release.get_future().share();
+    }
+
+    void advance(std::chrono::milliseconds time) {
+        now += std::chrono::duration_cast<std::chrono::steady_clock::duration>(time).count();
+    }
+};
+
+TEST_F(DnsCacheTest, ResolveCachesAddress) {
+    DNS_CACHE cache(lookup(), clock());
+
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    EXPECT_EQ(1, lookups.load());
+}
+
+TEST_F(DnsCacheTest, ResolveCachesFailedLookup) {
+    DNS_CACHE cache(lookup(), clock());
+
+    EXPECT_EQ("", cache.resolve("unknown-host", TTL, TIMEOUT));
+    EXPECT_EQ("", cache.resolve("unknown-host", TTL, TIMEOUT));
+    EXPECT_EQ(1, lookups.load());
+
+    // Failed lookups are kept for a shorter time
+    advance(std::chrono::milliseconds(DNS_NEGATIVE_CACHE_TTL_MS));
+    EXPECT_EQ("", cache.resolve("unknown-host", TTL, TIMEOUT));
+    EXPECT_EQ(2, lookups.load());
+}
+
+TEST_F(DnsCacheTest, ExpiredEntryIsLookedUpAgain) {
+    DNS_CACHE cache(lookup(), clock());
+
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    advance(TTL - std::chrono::milliseconds(1));
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    EXPECT_EQ(1, lookups.load());
+
+    advance(std::chrono::milliseconds(1));
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    EXPECT_EQ(2, lookups.load());
+}
+
+TEST_F(DnsCacheTest, ZeroTtlAlwaysLooksUp) {
+    DNS_CACHE cache(lookup(), clock());
+
+    EXPECT_EQ("10.0.0.1", cache.resolve("reader-host", TTL, TIMEOUT));
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", std::chrono::milliseconds(0), TIMEOUT));
+    advance(std::chrono::milliseconds(1));
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", std::chrono::milliseconds(0), TIMEOUT));
+    EXPECT_EQ(3, lookups.load());
+
+    // Other entries are kept
+    EXPECT_EQ("10.0.0.1", cache.resolve("reader-host", TTL, TIMEOUT));
+    EXPECT_EQ(3, lookups.load());
+}
+
+TEST_F(DnsCacheTest, ExpiredEntriesAreEvicted) {
+    DNS_CACHE cache(lookup(), clock());
+
+    cache.resolve("reader-a-host", TTL, TIMEOUT);
+    advance(TTL / 2);
+    cache.resolve("reader-b-host", TTL, TIMEOUT);
+    EXPECT_EQ(2u, cache.size());
+
+    advance(TTL / 2);
+    cache.get("reader-b-host", TTL);
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST_F(DnsCacheTest, ResolveWaitsAtMostTimeout) {
+    DNS_CACHE cache(lookup(), clock());
+    hold_lookups();
+
+    EXPECT_EQ("", cache.resolve("writer-host", TTL, std::chrono::milliseconds(1)));
+
+    // The lookup completes in the background
+    release.set_value();
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    EXPECT_EQ(1, lookups.load());
+}
+
+TEST_F(DnsCacheTest, GetDoesNotWait) {
+    DNS_CACHE cache(lookup(), clock());
+    hold_lookups();
+
+    EXPECT_EQ("", cache.get("reader-host", TTL));
+    release.set_value();
+    EXPECT_EQ("10.0.0.1", cache.resolve("reader-host", TTL, TIMEOUT));
+    EXPECT_EQ("10.0.0.1", cache.get("reader-host", TTL));
+    EXPECT_EQ(1, lookups.load());
+}
+
+TEST_F(DnsCacheTest, PrefetchResolvesHosts) {
+    DNS_CACHE cache(lookup(), clock());
+
+    cache.prefetch({ "reader-a-host", "reader-b-host", "unknown-host" }, TTL);
+    EXPECT_EQ("10.0.0.1", cache.resolve("reader-a-host", TTL, TIMEOUT));
+    EXPECT_EQ("10.0.0.1", cache.resolve("reader-b-host", TTL, TIMEOUT));
+    EXPECT_EQ("", cache.resolve("unknown-host", TTL, TIMEOUT));
+    EXPECT_EQ(3, lookups.load());
+    EXPECT_EQ(3u, cache.size());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(DnsCacheTest, ReleaseResourcesClearsCache) {
+    DNS_CACHE cache(lookup(), clock());
+
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    cache.release_resources();
+    EXPECT_EQ(0u, cache.size());
+
+    // The threads are started again
+    EXPECT_EQ("10.0.0.1", cache.resolve("writer-host", TTL, TIMEOUT));
+    EXPECT_EQ(2, lookups.load());
+}
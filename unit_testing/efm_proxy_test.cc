@@ -113,3 +113,67 @@ TEST_F(EFMProxyTest, DoesNotNeedMonitoring) {
     EFM_PROXY efm_proxy(dbc, ds, mock_connection_proxy, mock_monitor_service);
     efm_proxy.close();
 }
+
+TEST_F(EFMProxyTest, ReusesContextAcrossCalls) {
+    auto mock_context = std::make_shared<MONITOR_CONNECTION_CONTEXT>(
+        nullptr, std::set<std::string>(), std::chrono::milliseconds(0),
+        std::chrono::milliseconds(0), 0);
+
+    // The context is registered once and only unregistered when the proxy is destroyed.
+    EXPECT_CALL(*mock_monitor_service, start_monitoring(_, _, _, _, _, _, _, _, _)).WillOnce(Return(mock_context));
+    EXPECT_CALL(*mock_monitor_service, stop_monitoring(mock_context)).Times(1);
+    const char *q = nullptr;
+    EXPECT_CALL(*mock_connection_proxy, query(q)).Times(3);
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+
+    {
+        EFM_PROXY efm_proxy(dbc, ds, mock_connection_proxy, mock_monitor_service);
+        for (int i = 0; i < 3; i++) {
+            efm_proxy.query(q);
+            EXPECT_FALSE(mock_context->is_armed());
+        }
+    }
+}
+
+TEST_F(EFMProxyTest, BufferedFetchRowNotMonitored) {
+    MYSQL_DATA data{};
+    MYSQL_RES result{};
+    result.data = &data;
+
+    EXPECT_CALL(*mock_monitor_service, start_monitoring(_, _, _, _, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*mock_monitor_service, stop_monitoring(_)).Times(0);
+    EXPECT_CALL(*mock_connection_proxy, fetch_row(&result)).Times(2);
+    EXPECT_CALL(*mock_connection_proxy, free_result(&result));
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+
+    EFM_PROXY efm_proxy(dbc, ds, mock_connection_proxy, mock_monitor_service);
+    efm_proxy.fetch_row(&result);
+    efm_proxy.fetch_row(&result);
+    efm_proxy.free_result(&result);
+}
+
+TEST_F(EFMProxyTest, NonblockingQueryMonitoredUntilComplete) {
+    auto mock_context = std::make_shared<MONITOR_CONNECTION_CONTEXT>(
+        nullptr, std::set<std::string>(), std::chrono::milliseconds(0),
+        std::chrono::milliseconds(0), 0);
+
+    EXPECT_CALL(*mock_monitor_service, start_monitoring(_, _, _, _, _, _, _, _, _)).WillOnce(Return(mock_context));
+    EXPECT_CALL(*mock_monitor_service, stop_monitoring(mock_context)).Times(1);
+    const char *q = "SELECT 1";
+    EXPECT_CALL(*mock_connection_proxy, real_query_nonblocking(q, 8))
+        .WillOnce(Return(NET_ASYNC_NOT_READY))
+        .WillOnce(Return(NET_ASYNC_NOT_READY))
+        .WillOnce(Return(NET_ASYNC_COMPLETE));
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+
+    {
+        EFM_PROXY efm_proxy(dbc, ds, mock_connection_proxy, mock_monitor_service);
+        // Polling the call keeps the context armed since the first call
+        EXPECT_EQ(NET_ASYNC_NOT_READY, efm_proxy.real_query_nonblocking(q, 8));
+        EXPECT_TRUE(mock_context->is_armed());
+        EXPECT_EQ(NET_ASYNC_NOT_READY, efm_proxy.real_query_nonblocking(q, 8));
+        EXPECT_TRUE(mock_context->is_armed());
+        EXPECT_EQ(NET_ASYNC_COMPLETE, efm_proxy.real_query_nonblocking(q, 8));
+        EXPECT_FALSE(mock_context->is_armed());
+    }
+}
@@ -445,6 +445,41 @@ TEST_F(FailoverHandlerTest, GetRdsInstanceId) {
   EXPECT_EQ(std::string(), TEST_UTILS::get_rds_instance_id(US_EAST_REGION_CLUSTER));
 }
 
+TEST_F(FailoverHandlerTest, ParseRdsEndpoint) {
+    RDS_ENDPOINT endpoint = TEST_UTILS::parse_rds_endpoint(US_EAST_REGION_CLUSTER_READ_ONLY);
+    EXPECT_TRUE(endpoint.is_rds);
+    EXPECT_TRUE(endpoint.is_cluster);
+    EXPECT_TRUE(endpoint.is_reader_cluster);
+    EXPECT_FALSE(endpoint.is_writer_cluster);
+    EXPECT_FALSE(endpoint.is_proxy);
+    EXPECT_FALSE(endpoint.is_china);
+    EXPECT_EQ("database-test-name", endpoint.cluster_id);
+    EXPECT_EQ(US_EAST_REGION_CLUSTER, endpoint.cluster_host_url);
+    EXPECT_EQ("?.XYZ.us-east-2.rds.amazonaws.com", endpoint.instance_host_pattern);
+    EXPECT_EQ("us-east-2", endpoint.region);
+
+    endpoint = TEST_UTILS::parse_rds_endpoint(CHINA_REGION_PROXY);
+    EXPECT_TRUE(endpoint.is_rds);
+    EXPECT_TRUE(endpoint.is_proxy);
+    EXPECT_TRUE(endpoint.is_china);
+    EXPECT_FALSE(endpoint.is_cluster);
+    EXPECT_EQ("proxy-test-name", endpoint.cluster_id);
+    EXPECT_EQ(std::string(), endpoint.cluster_host_url);
+
+    endpoint = TEST_UTILS::parse_rds_endpoint(US_EAST_REGION_INSTANCE);
+    EXPECT_TRUE(endpoint.is_rds);
+    EXPECT_FALSE(endpoint.is_cluster);
+    EXPECT_EQ("instance-test-name", endpoint.instance_id);
+
+    endpoint = TEST_UTILS::parse_rds_endpoint("10.0.0.1");
+    EXPECT_TRUE(endpoint.is_ipv4);
+    EXPECT_FALSE(endpoint.is_rds);
+
+    endpoint = TEST_UTILS::parse_rds_endpoint("fe80::1");
+    EXPECT_TRUE(endpoint.is_ipv6);
+    EXPECT_FALSE(endpoint.is_ipv4);
+}
+
 TEST_F(FailoverHandlerTest, ConnectToNewWriter) {
     std::string server = "my-cluster-name.cluster-XYZ.us-east-2.rds.amazonaws.com";
     ds->opt_SERVER.set_remove_brackets((SQLWCHAR*)to_sqlwchar_string(server).c_str(), server.size());
@@ -98,6 +98,8 @@ protected:
         reader_b_host->set_host_state(UP);
         reader_c_host->set_host_state(DOWN);
         writer_host->set_host_state(UP);
+        reader_a_host->replica_lag = "";
+        reader_b_host->replica_lag = "";
 
         mock_ts = std::make_shared<MOCK_TOPOLOGY_SERVICE>();
         mock_connection_handler = std::make_shared<MOCK_CONNECTION_HANDLER>();
@@ -363,6 +365,95 @@ TEST_F(FailoverReaderHandlerTest, GetConnectionFromHosts_Timeout) {
     EXPECT_THAT(result->new_connection, nullptr);
 }
 
+// Verify that readers reporting less replication lag are tried first.
+// Expected result: readers up ordered by lag, then readers without lag, then readers down
+TEST_F(FailoverReaderHandlerTest, BuildHostsList_ReplicaLag) {
+    FAILOVER_READER_HANDLER reader_handler(mock_ts, mock_connection_handler, failover_thread_pool, 60000, 30000, false, 0);
+    CLUSTER_TOPOLOGY_INFO topology_info = generate_topology(0, 1, 1);
+    const std::vector<std::string> lags = {"30", "", "5", "10.5"};
+    for (const auto& lag : lags) {
+        auto reader = std::make_shared<HOST_INFO>("reader-" + lag, 1234, UP, false);
+        reader->replica_lag = lag;
+        topology_info.add_host(reader);
+    }
+
+    auto hosts_list = reader_handler.build_hosts_list(std::make_shared<CLUSTER_TOPOLOGY_INFO>(topology_info), false);
+
+    ASSERT_EQ(5, hosts_list.size());
+    EXPECT_EQ("5", hosts_list[0]->replica_lag);
+    EXPECT_EQ("10.5", hosts_list[1]->replica_lag);
+    EXPECT_EQ("30", hosts_list[2]->replica_lag);
+    EXPECT_EQ("", hosts_list[3]->replica_lag);
+    EXPECT_TRUE(hosts_list[3]->is_host_up());
+    EXPECT_TRUE(hosts_list[4]->is_host_down());
+}
+
+// Verify that all hosts are tried at once when the fan-out is not set.
+// Expected result: new connection to the writer without waiting for the slow readers
+TEST_F(FailoverReaderHandlerTest, GetConnectionFromHosts_AllHostsAtOnce) {
+    mock_writer_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+
+    EXPECT_CALL(*mock_writer_proxy, is_connected()).WillRepeatedly(Return(true));
+
+    EXPECT_CALL(*mock_connection_handler, connect_impl(_, nullptr, false)).WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(*mock_connection_handler, connect_impl(reader_a_host, nullptr, false)).WillRepeatedly(Invoke([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+            return static_cast<CONNECTION_PROXY*>(nullptr);
+        }));
+    EXPECT_CALL(*mock_connection_handler, connect_impl(reader_b_host, nullptr, false)).WillRepeatedly(Invoke([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+            return static_cast<CONNECTION_PROXY*>(nullptr);
+        }));
+    EXPECT_CALL(*mock_connection_handler, connect_impl(writer_host, nullptr, false)).WillRepeatedly(Return(mock_writer_proxy));
+
+    EXPECT_CALL(*mock_ts, mark_host_down(_)).Times(AnyNumber());
+    EXPECT_CALL(*mock_ts, mark_host_up(writer_host)).Times(1);
+
+    FAILOVER_READER_HANDLER reader_handler(mock_ts, mock_connection_handler, failover_thread_pool, 60000, 30000, false, 0, false, 0);
+    auto hosts_list = reader_handler.build_hosts_list(topology, true);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = reader_handler.get_connection_from_hosts(hosts_list, mock_sync);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    EXPECT_TRUE(result->connected);
+    EXPECT_THAT(result->new_connection, mock_writer_proxy);
+    EXPECT_LT(elapsed.count(), 1500);
+
+    // Explicit delete as it is returned as result & is not deconstructed during failover
+    delete mock_writer_proxy;
+}
+
+// Verify that staggered attempts are cancelled once an earlier one connects.
+// Expected result: new connection to reader A, no attempt to connect to reader B
+TEST_F(FailoverReaderHandlerTest, GetConnectionFromHosts_StaggeredStart) {
+    mock_reader_a_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    reader_a_host->replica_lag = "1";
+    reader_b_host->replica_lag = "2";
+
+    EXPECT_CALL(*mock_reader_a_proxy, is_connected()).WillRepeatedly(Return(true));
+
+    EXPECT_CALL(*mock_connection_handler, connect_impl(_, nullptr, false)).Times(0);
+    EXPECT_CALL(*mock_connection_handler, connect_impl(reader_a_host, nullptr, false)).WillOnce(Return(mock_reader_a_proxy));
+
+    EXPECT_CALL(*mock_ts, mark_host_up(reader_a_host)).Times(1);
+
+    FAILOVER_READER_HANDLER reader_handler(mock_ts, mock_connection_handler, failover_thread_pool, 60000, 30000, false, 0, false, 0, 1000);
+    auto hosts_list = reader_handler.build_hosts_list(topology, true);
+    ASSERT_EQ(reader_a_host, hosts_list[0]);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = reader_handler.get_connection_from_hosts(hosts_list, mock_sync);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    EXPECT_TRUE(result->connected);
+    EXPECT_THAT(result->new_connection, mock_reader_a_proxy);
+    EXPECT_LT(elapsed.count(), 1000);
+
+    // Explicit delete on reader A as it is returned as a valid result
+    delete mock_reader_a_proxy;
+}
+
 // Verify that reader failover handler fails to connect to any reader node or
 // writer node. Expected result: no new connection
 TEST_F(FailoverReaderHandlerTest, Failover_Failure) {
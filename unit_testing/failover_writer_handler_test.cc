@@ -485,3 +485,58 @@ TEST_F(FailoverWriterHandlerTest, FailedToConnect_TaskAFailed_TaskBWriterFailed)
     // delete reader b explicitly, since get_reader_connection() is mocked
     delete mock_reader_b_proxy;
 }
+
+// Verify that the writer failover tasks poll tightly right after the failure and back off afterwards.
+// topology: no changes
+// taskA: fails to re-connect to writer three times, then succeeds
+// taskB: fail to connect to any reader
+// expected test result: new connection by taskA, reporting doubling poll intervals
+TEST_F(FailoverWriterHandlerTest, ReconnectToWriter_AdaptivePollIntervals) {
+    mock_writer_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    EXPECT_CALL(*mock_writer_proxy, is_connected()).WillRepeatedly(Return(true));
+
+    EXPECT_CALL(*mock_ts, get_topology(_, true))
+        .WillRepeatedly(Return(current_topology));
+    EXPECT_CALL(*mock_ts, mark_host_down(writer_host)).Times(1);
+    EXPECT_CALL(*mock_ts, mark_host_up(writer_host)).Times(1);
+
+    EXPECT_CALL(*mock_reader_handler, get_reader_connection(_, _))
+        .WillRepeatedly(Return(std::make_shared<READER_FAILOVER_RESULT>(false, nullptr, nullptr)));
+
+    EXPECT_CALL(*mock_connection_handler, connect_impl(writer_host, nullptr, false))
+        .WillOnce(Return(nullptr))
+        .WillOnce(Return(nullptr))
+        .WillOnce(Return(nullptr))
+        .WillRepeatedly(Return(mock_writer_proxy));
+
+    FAILOVER_WRITER_HANDLER writer_handler(
+        mock_ts, mock_reader_handler, mock_connection_handler, failover_thread_pool, 5000, 2000, 2000, 0);
+    auto result = writer_handler.failover(current_topology);
+
+    EXPECT_TRUE(result->connected);
+    EXPECT_FALSE(result->is_new_host);
+    EXPECT_THAT(result->new_connection, mock_writer_proxy);
+    EXPECT_EQ(std::vector<int>({ 100, 200, 400 }), result->poll_intervals_ms);
+
+    // Explicit delete on writer connection as it's returned as a valid result
+    delete mock_writer_proxy;
+}
+
+TEST_F(FailoverWriterHandlerTest, PollScheduleBackOffIsBounded) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    FAILOVER_POLL_SCHEDULE schedule(1000, deadline);
+
+    EXPECT_EQ(100, schedule.next_interval_ms());
+    EXPECT_EQ(200, schedule.next_interval_ms());
+    EXPECT_EQ(400, schedule.next_interval_ms());
+    EXPECT_EQ(800, schedule.next_interval_ms());
+    EXPECT_EQ(1000, schedule.next_interval_ms());
+    EXPECT_EQ(1000, schedule.next_interval_ms());
+    EXPECT_EQ(6u, schedule.get_intervals().size());
+
+    // Never waits past the failover deadline
+    FAILOVER_POLL_SCHEDULE expiring_schedule(1000, std::chrono::steady_clock::now() + std::chrono::milliseconds(50));
+    EXPECT_GE(50, expiring_schedule.next_interval_ms());
+    FAILOVER_POLL_SCHEDULE expired_schedule(1000, std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+    EXPECT_EQ(0, expired_schedule.next_interval_ms());
+}
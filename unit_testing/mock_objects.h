@@ -40,6 +40,7 @@
 #include "driver/saml_http_client.h"
 #include "driver/monitor_thread_container.h"
 #include "driver/monitor_service.h"
+#include "driver/read_write_splitting_proxy.h"
 
 #ifdef WIN32
 #ifdef _DEBUG
@@ -77,11 +78,23 @@ public:
     MOCK_METHOD(bool, is_connected, ());
     MOCK_METHOD(std::string, get_host, ());
     MOCK_METHOD(unsigned int, get_port, ());
+    MOCK_METHOD(char*, get_server_version, (), (const));
+    MOCK_METHOD(int, select_db, (const char*));
     MOCK_METHOD(int, query, (const char*));
+    MOCK_METHOD(int, real_query, (const char*, unsigned long));
+    MOCK_METHOD(unsigned int, get_server_status, (), (const));
     MOCK_METHOD(MYSQL_RES*, store_result, ());
+    MOCK_METHOD(unsigned int, field_count, ());
+    MOCK_METHOD(net_async_status, real_query_nonblocking, (const char*, unsigned long));
+    MOCK_METHOD(net_async_status, store_result_nonblocking, (MYSQL_RES**));
+    MOCK_METHOD(net_async_status, next_result_nonblocking, ());
+    MOCK_METHOD(bool, more_results, ());
+    MOCK_METHOD(bool, autocommit, (bool));
     MOCK_METHOD(char**, fetch_row, (MYSQL_RES*));
+    MOCK_METHOD(unsigned long*, fetch_lengths, (MYSQL_RES*));
     MOCK_METHOD(void, free_result, (MYSQL_RES*));
     MOCK_METHOD(void, close_socket, ());
+    MOCK_METHOD(bool, wait_for_response, (int));
     MOCK_METHOD(void, mock_connection_proxy_destructor, ());
     MOCK_METHOD(void, close, ());
     MOCK_METHOD(void, init, ());
@@ -89,6 +102,12 @@ public:
     MOCK_METHOD(void, delete_ds, ());
     MOCK_METHOD(bool, connect, (const char*, const char*, const char*, const char*, unsigned int, const char*, unsigned long));
     MOCK_METHOD(unsigned int, error_code, ());
+    MOCK_METHOD(const char*, error, ());
+    MOCK_METHOD(MYSQL_STMT*, stmt_init, ());
+    MOCK_METHOD(int, stmt_execute, (MYSQL_STMT*));
+    MOCK_METHOD(bool, stmt_close, (MYSQL_STMT*));
+    MOCK_METHOD(bool, stmt_reset, (MYSQL_STMT*));
+    MOCK_METHOD(bool, stmt_free_result, (MYSQL_STMT*));
 };
 
 class MOCK_TOPOLOGY_SERVICE : public TOPOLOGY_SERVICE {
@@ -99,6 +118,7 @@ public:
     MOCK_METHOD(void, set_cluster_instance_template, (std::shared_ptr<HOST_INFO>));
     MOCK_METHOD(std::shared_ptr<CLUSTER_TOPOLOGY_INFO>, get_topology, (CONNECTION_PROXY*, bool));
     MOCK_METHOD(std::shared_ptr<CLUSTER_TOPOLOGY_INFO>, get_filtered_topology, (CONNECTION_PROXY*, bool));
+    MOCK_METHOD(std::shared_ptr<CLUSTER_TOPOLOGY_INFO>, get_cached_topology, ());
     MOCK_METHOD(void, mark_host_down, (std::shared_ptr<HOST_INFO>));
     MOCK_METHOD(void, mark_host_up, (std::shared_ptr<HOST_INFO>));
 };
@@ -256,6 +276,12 @@ public:
     static int get_monitor_size() { return monitors.size(); }
 };
 
+class TEST_READ_WRITE_SPLITTING_PROXY : public READ_WRITE_SPLITTING_PROXY {
+public:
+    TEST_READ_WRITE_SPLITTING_PROXY(DBC* dbc, DataSource* ds, CONNECTION_PROXY* next_proxy) : READ_WRITE_SPLITTING_PROXY(dbc, ds, next_proxy) {};
+    MOCK_METHOD(CONNECTION_PROXY*, connect_to_reader, (std::shared_ptr<HOST_INFO>), (override));
+};
+
 class MOCK_CUSTOM_ENDPOINT_MONITOR : public CUSTOM_ENDPOINT_MONITOR {
  public:
   MOCK_CUSTOM_ENDPOINT_MONITOR(ctpl::thread_pool& pool) : CUSTOM_ENDPOINT_MONITOR(pool) {};
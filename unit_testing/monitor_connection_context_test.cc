@@ -127,3 +127,26 @@ TEST_F(MonitorConnectionContextTest, IsNodeUnhealthyExceedsFailureDetectionCount
     context->set_connection_valid(false, status_check_start_time, status_check_end_time);
     EXPECT_TRUE(context->is_node_unhealthy());
 }
+
+TEST_F(MonitorConnectionContextTest, DisarmedContextIgnoresStatus) {
+    std::chrono::steady_clock::time_point current_time = std::chrono::steady_clock::now();
+    context->set_start_monitor_time(current_time);
+    context->disarm();
+    EXPECT_FALSE(context->is_armed());
+
+    context->update_connection_status(current_time, current_time + std::chrono::seconds(1), false);
+    EXPECT_EQ(0, context->get_failure_count());
+
+    // Re-arming restarts the grace period and drops failures from the previous call.
+    context->arm(current_time);
+    context->update_connection_status(current_time, current_time + std::chrono::seconds(1), false);
+    EXPECT_EQ(1, context->get_failure_count());
+
+    context->disarm();
+    context->arm(current_time + std::chrono::seconds(2));
+    EXPECT_TRUE(context->is_armed());
+    EXPECT_FALSE(context->is_node_unhealthy());
+    context->update_connection_status(
+        current_time + std::chrono::seconds(2), current_time + std::chrono::seconds(3), false);
+    EXPECT_EQ(1, context->get_failure_count());
+}
@@ -288,3 +288,56 @@ TEST_F(MonitorThreadContainerTest, PopulateAndRemoveMappings) {
 
     cleanup_odbc_handles(env, dbc, ds);
 }
+
+TEST_F(MonitorThreadContainerTest, SchedulerRunsMonitorsOnSharedWorkers) {
+    auto mock_thread_container = std::make_shared<MOCK_MONITOR_THREAD_CONTAINER>();
+    auto monitor_service = std::make_shared<MONITOR_SERVICE>(mock_thread_container);
+    mock_thread_container->set_scheduler_threads(1);
+
+    auto mock_monitor1 = std::make_shared<MOCK_MONITOR2>(host, monitor_disposal_time);
+    auto mock_monitor2 = std::make_shared<MOCK_MONITOR2>(host, monitor_disposal_time);
+
+    // Scheduled monitors are checked by the scheduler's workers, not by a thread running run().
+    EXPECT_CALL(*mock_monitor1, run(_)).Times(0);
+    EXPECT_CALL(*mock_monitor2, run(_)).Times(0);
+
+    mock_thread_container->add_task(mock_monitor1, monitor_service);
+    mock_thread_container->add_task(mock_monitor2, monitor_service);
+
+    // Both monitors have no contexts, so they are disposed of on the single worker.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    EXPECT_TRUE(mock_monitor1->is_stopped());
+    EXPECT_TRUE(mock_monitor2->is_stopped());
+    EXPECT_FALSE(TEST_UTILS::has_any_tasks(mock_thread_container));
+
+    monitor_service->release_resources();
+    mock_thread_container->release_resources();
+}
+
+TEST_F(MonitorThreadContainerTest, ScheduledMonitorsKeepPoolThreads) {
+    auto mock_thread_container = std::make_shared<MOCK_MONITOR_THREAD_CONTAINER>();
+    auto monitor_service = std::make_shared<MONITOR_SERVICE>(mock_thread_container);
+
+    auto pool_monitor = std::make_shared<MOCK_MONITOR2>(host, monitor_disposal_time);
+    auto scheduled_monitor = std::make_shared<MOCK_MONITOR2>(host, monitor_disposal_time);
+    EXPECT_CALL(*pool_monitor, run(_));
+    EXPECT_CALL(*scheduled_monitor, run(_)).Times(0);
+
+    // Added before the scheduler exists, so it gets a thread of the pool
+    mock_thread_container->add_task(pool_monitor, monitor_service);
+    EXPECT_EQ(1, TEST_UTILS::get_thread_pool_size(mock_thread_container));
+
+    mock_thread_container->set_scheduler_threads(1);
+    mock_thread_container->add_task(scheduled_monitor, monitor_service);
+
+    // The scheduled monitor has no contexts and is released, the pool thread stays
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    EXPECT_FALSE(TEST_UTILS::has_task(mock_thread_container, scheduled_monitor));
+    EXPECT_TRUE(TEST_UTILS::has_task(mock_thread_container, pool_monitor));
+    EXPECT_EQ(1, TEST_UTILS::get_thread_pool_size(mock_thread_container));
+
+    monitor_service->release_resources();
+    mock_thread_container->release_resources();
+}
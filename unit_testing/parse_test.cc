@@ -0,0 +1,132 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "driver/driver.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+const std::vector<std::string> queries = {
+  "SELECT a, b FROM t WHERE a = ? AND b = ?",
+  "  SELECT\t1\r\n;  SELECT 2 \\g SELECT 3",
+  "INSERT INTO t VALUES (1, 'a''b', \"c\\\"d ?\", `e f`), (?, 'caf\xC3\xA9 ?', ?)",
+  "SELECT 'unterminated ? quote",
+  "SELECT 1 -- comment ?\nFROM dual # another ?\n WHERE x = ?",
+  "SELECT /* comment ? */ 1, /*!50000 ? */ 2 FROM t WHERE a=?-1",
+  "{call proc(?, 'x\\\\', ?)}",
+  "SELECT '\xE2\x82\xAC\xE2\x82\xAC' AS euro,\xC2\xA0? FROM t;",
+  "",
+};
+
+void tokenize_query(MY_PARSED_QUERY& pq, const std::string& query,
+                    CHARSET_INFO* cs, bool ascii_scan) {
+  std::string copy(query);
+  pq.reset(&copy[0], &copy[0] + copy.size(), cs);
+
+  MY_PARSER parser;
+  init_parser(&parser, &pq);
+  parser.ascii_scan = ascii_scan;
+  tokenize(&parser);
+}
+}  // namespace
+
+class ParseTest : public testing::Test {
+ protected:
+  static void TearDownTestSuite() { mysql_library_end(); }
+};
+
+TEST_F(ParseTest, AsciiScanEnabledForAsciiSupersets) {
+  MY_PARSED_QUERY pq;
+  MY_PARSER parser;
+  std::string query = "SELECT 1";
+
+  for (const char* csname : {"utf8mb4", "utf8mb3", "latin1", "ascii"}) {
+    CHARSET_INFO* cs = get_charset_by_csname(csname, MYF(MY_CS_PRIMARY), MYF(0));
+    ASSERT_NE(nullptr, cs) << csname;
+    pq.reset(&query[0], &query[0] + query.size(), cs);
+    init_parser(&parser, &pq);
+    EXPECT_TRUE(parser.ascii_scan) << csname;
+  }
+
+  // Second bytes of multi-byte characters can be ASCII in those
+  for (const char* csname : {"sjis", "gbk", "big5"}) {
+    CHARSET_INFO* cs = get_charset_by_csname(csname, MYF(MY_CS_PRIMARY), MYF(0));
+    ASSERT_NE(nullptr, cs) << csname;
+    pq.reset(&query[0], &query[0] + query.size(), cs);
+    init_parser(&parser, &pq);
+    EXPECT_FALSE(parser.ascii_scan) << csname;
+  }
+}
+
+TEST_F(ParseTest, AsciiScanMatchesScalarTokenizer) {
+  for (const char* csname : {"utf8mb4", "latin1"}) {
+    CHARSET_INFO* cs = get_charset_by_csname(csname, MYF(MY_CS_PRIMARY), MYF(0));
+    ASSERT_NE(nullptr, cs);
+
+    for (const auto& query : queries) {
+      MY_PARSED_QUERY scalar, scan;
+      tokenize_query(scalar, query, cs, false);
+      tokenize_query(scan, query, cs, true);
+
+      EXPECT_EQ(scalar.token2, scan.token2) << csname << ": " << query;
+      EXPECT_EQ(scalar.param_pos, scan.param_pos) << csname << ": " << query;
+      EXPECT_EQ(scalar.last_char == nullptr, scan.last_char == nullptr);
+      if (scalar.last_char && scan.last_char) {
+        EXPECT_EQ(scalar.last_char - scalar.query, scan.last_char - scan.query)
+          << csname << ": " << query;
+      }
+    }
+  }
+}
+
+TEST_F(ParseTest, LargeInsert) {
+  CHARSET_INFO* cs = get_charset_by_csname("utf8mb4", MYF(MY_CS_PRIMARY), MYF(0));
+  ASSERT_NE(nullptr, cs);
+
+  std::string query = "INSERT INTO t (id, name) VALUES ";
+  for (int i = 0; i < 1000; ++i) {
+    query += "(" + std::to_string(i) + ", 'name \\'" + std::to_string(i) + "\\' ;?'), (?, ?),";
+  }
+  query.back() = ' ';
+
+  MY_PARSED_QUERY pq;
+  pq.reset(&query[0], &query[0] + query.size(), cs);
+  ASSERT_FALSE(parse(&pq));
+  EXPECT_EQ(2000, PARAM_COUNT(pq));
+  EXPECT_FALSE(IS_BATCH(&pq));
+  EXPECT_EQ(myqtInsert, pq.query_type);
+
+  MY_PARSED_QUERY scalar;
+  tokenize_query(scalar, query, cs, false);
+  EXPECT_EQ(scalar.token2, pq.token2);
+  EXPECT_EQ(scalar.param_pos, pq.param_pos);
+}
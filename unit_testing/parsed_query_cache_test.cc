@@ -0,0 +1,200 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "driver/driver.h"
+#include "driver/parsed_query_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+namespace {
+void reset_query(MY_PARSED_QUERY& pq, const char* text, CHARSET_INFO* cs) {
+  std::string copy(text);
+  pq.reset(&copy[0], &copy[0] + copy.size(), cs);
+}
+
+std::string query_text(MY_PARSED_QUERY& pq) {
+  return std::string(GET_QUERY(&pq), GET_QUERY_LENGTH(&pq));
+}
+}  // namespace
+
+class ParsedQueryCacheTest : public testing::Test {
+ protected:
+  CHARSET_INFO* utf8mb4;
+  CHARSET_INFO* latin1;
+  PARSED_QUERY_CACHE cache;
+
+  static void TearDownTestSuite() { mysql_library_end(); }
+
+  void SetUp() override {
+    utf8mb4 = get_charset_by_csname("utf8mb4", MYF(MY_CS_PRIMARY), MYF(0));
+    latin1 = get_charset_by_csname("latin1", MYF(MY_CS_PRIMARY), MYF(0));
+    ASSERT_NE(nullptr, utf8mb4);
+    ASSERT_NE(nullptr, latin1);
+  }
+};
+
+TEST_F(ParsedQueryCacheTest, HitMatchesParse) {
+  const char* query = "SELECT a, b FROM t WHERE a = ? AND b = '?' AND c = ?";
+
+  MY_PARSED_QUERY expected;
+  reset_query(expected, query, utf8mb4);
+  ASSERT_FALSE(parse(&expected));
+
+  MY_PARSED_QUERY first, second;
+  reset_query(first, query, utf8mb4);
+  ASSERT_FALSE(cache.parse(&first, 10));
+  reset_query(second, query, utf8mb4);
+  ASSERT_FALSE(cache.parse(&second, 10));
+
+  EXPECT_EQ(1, cache.get_misses());
+  EXPECT_EQ(1, cache.get_hits());
+  EXPECT_EQ(1, cache.size());
+
+  EXPECT_EQ(expected.token2, second.token2);
+  EXPECT_EQ(expected.param_pos, second.param_pos);
+  EXPECT_EQ(2, PARAM_COUNT(second));
+  EXPECT_EQ(expected.query_type, second.query_type);
+  EXPECT_FALSE(IS_BATCH(&second));
+  EXPECT_TRUE(second.is_select_statement());
+}
+
+TEST_F(ParsedQueryCacheTest, HitRemovesBraces) {
+  const char* query = "{call proc(?, ?)}";
+
+  MY_PARSED_QUERY expected;
+  reset_query(expected, query, utf8mb4);
+  ASSERT_FALSE(parse(&expected));
+
+  MY_PARSED_QUERY first, second;
+  reset_query(first, query, utf8mb4);
+  ASSERT_FALSE(cache.parse(&first, 10));
+  reset_query(second, query, utf8mb4);
+  ASSERT_FALSE(cache.parse(&second, 10));
+
+  EXPECT_EQ(1, cache.get_hits());
+  EXPECT_EQ(query_text(expected), query_text(second));
+  EXPECT_EQ(expected.token2, second.token2);
+  EXPECT_EQ(expected.param_pos, second.param_pos);
+  EXPECT_EQ(expected.query_type, second.query_type);
+  EXPECT_STREQ(expected.get_token(0), second.get_token(0));
+}
+
+TEST_F(ParsedQueryCacheTest, HitKeepsLastChar) {
+  const char* query = "INSERT INTO t VALUES (?, 'a;b'); SELECT 1  ";
+
+  MY_PARSED_QUERY first, second;
+  reset_query(first, query, utf8mb4);
+  ASSERT_FALSE(cache.parse(&first, 10));
+  reset_query(second, query, utf8mb4);
+  ASSERT_FALSE(cache.parse(&second, 10));
+
+  EXPECT_EQ(1, cache.get_hits());
+  ASSERT_NE(nullptr, second.last_char);
+  EXPECT_EQ(first.last_char - GET_QUERY(&first), second.last_char - GET_QUERY(&second));
+  EXPECT_EQ(first.token2, second.token2);
+}
+
+TEST_F(ParsedQueryCacheTest, CharsetIsPartOfKey) {
+  const char* query = "SELECT ?";
+
+  MY_PARSED_QUERY first, second;
+  reset_query(first, query, utf8mb4);
+  ASSERT_FALSE(cache.parse(&first, 10));
+  reset_query(second, query, latin1);
+  ASSERT_FALSE(cache.parse(&second, 10));
+
+  EXPECT_EQ(0, cache.get_hits());
+  EXPECT_EQ(2, cache.get_misses());
+  EXPECT_EQ(2, cache.size());
+}
+
+TEST_F(ParsedQueryCacheTest, EvictsLeastRecentlyUsed) {
+  MY_PARSED_QUERY pq;
+  reset_query(pq, "SELECT 1", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 2));
+  reset_query(pq, "SELECT 2", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 2));
+  // Makes "SELECT 2" the oldest entry
+  reset_query(pq, "SELECT 1", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 2));
+  reset_query(pq, "SELECT 3", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 2));
+
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(1, cache.get_hits());
+  EXPECT_EQ(3, cache.get_misses());
+
+  reset_query(pq, "SELECT 1", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 2));
+  EXPECT_EQ(2, cache.get_hits());
+
+  reset_query(pq, "SELECT 2", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 2));
+  EXPECT_EQ(2, cache.get_hits());
+  EXPECT_EQ(4, cache.get_misses());
+}
+
+TEST_F(ParsedQueryCacheTest, DisabledWithoutCapacity) {
+  MY_PARSED_QUERY pq;
+  reset_query(pq, "SELECT ?", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 0));
+  reset_query(pq, "SELECT ?", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 0));
+
+  EXPECT_EQ(1, PARAM_COUNT(pq));
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(0, cache.get_hits());
+  EXPECT_EQ(0, cache.get_misses());
+}
+
+TEST_F(ParsedQueryCacheTest, LongQueriesNotCached) {
+  std::string query = "SELECT '";
+  query.append(PARSED_QUERY_CACHE::MAX_QUERY_LENGTH, 'x');
+  query.append("'");
+
+  MY_PARSED_QUERY pq;
+  reset_query(pq, query.c_str(), utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 10));
+
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(0, cache.get_misses());
+}
+
+TEST_F(ParsedQueryCacheTest, Clear) {
+  MY_PARSED_QUERY pq;
+  reset_query(pq, "SELECT ?", utf8mb4);
+  ASSERT_FALSE(cache.parse(&pq, 10));
+  cache.clear();
+
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(0, cache.get_misses());
+}
@@ -0,0 +1,169 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using testing::_;
+using testing::Invoke;
+
+class ReadAheadTest : public testing::Test {
+ protected:
+  SQLHENV env;
+  DBC* dbc;
+  DataSource* ds;
+  MOCK_CONNECTION_PROXY* mock_connection_proxy;
+  MYSQL_RES result{};
+
+  // Rows returned by the mock, two columns each, the second one is NULL in odd rows
+  std::vector<std::string> row_values;
+  std::vector<char*> row;
+  std::vector<unsigned long> lengths;
+  std::atomic<size_t> rows_read{0};
+
+  static void SetUpTestSuite() {}
+
+  static void TearDownTestSuite() { mysql_library_end(); }
+
+  void SetUp() override {
+    allocate_odbc_handles(env, dbc, ds);
+    dbc->ds = ds;
+    mock_connection_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+    delete dbc->connection_proxy;
+    dbc->connection_proxy = mock_connection_proxy;
+
+    row.resize(3);
+    lengths.resize(2);
+  }
+
+  void TearDown() override {
+    dbc->ds = nullptr;
+    cleanup_odbc_handles(env, dbc, ds);
+  }
+
+  // Make the mock return total rows, or rows without end if total is 0
+  void expect_rows(size_t total) {
+    EXPECT_CALL(*mock_connection_proxy, fetch_row(&result)).WillRepeatedly(Invoke([this, total](MYSQL_RES*) -> char** {
+      const size_t n = rows_read;
+      if (total && n == total) {
+        return nullptr;
+      }
+      ++rows_read;
+
+      row_values = {"row" + std::to_string(n), "value" + std::to_string(n)};
+      row[0] = &row_values[0][0];
+      row[1] = n % 2 ? nullptr : &row_values[1][0];
+      lengths[0] = row_values[0].size();
+      lengths[1] = n % 2 ? 0 : row_values[1].size();
+      return row.data();
+    }));
+    EXPECT_CALL(*mock_connection_proxy, fetch_lengths(&result)).WillRepeatedly(Invoke([this](MYSQL_RES*) {
+      return lengths.data();
+    }));
+  }
+};
+
+TEST_F(ReadAheadTest, RowsInOrder) {
+  expect_rows(10);
+  READ_AHEAD read_ahead(dbc, &result, 2, 4);
+
+  for (size_t n = 0; n < 10; ++n) {
+    MYSQL_ROW values = read_ahead.fetch_row();
+    ASSERT_NE(nullptr, values);
+    unsigned long* value_lengths = read_ahead.fetch_lengths();
+    ASSERT_NE(nullptr, value_lengths);
+
+    const std::string first = "row" + std::to_string(n);
+    EXPECT_STREQ(first.c_str(), values[0]);
+    EXPECT_EQ(first.size(), value_lengths[0]);
+    if (n % 2) {
+      EXPECT_EQ(nullptr, values[1]);
+      EXPECT_EQ(0u, value_lengths[1]);
+    } else {
+      const std::string second = "value" + std::to_string(n);
+      EXPECT_STREQ(second.c_str(), values[1]);
+      EXPECT_EQ(second.size(), value_lengths[1]);
+    }
+    EXPECT_EQ(n + 1, read_ahead.num_rows());
+  }
+
+  EXPECT_EQ(nullptr, read_ahead.fetch_row());
+  EXPECT_EQ(nullptr, read_ahead.fetch_row());
+  EXPECT_EQ(10u, read_ahead.num_rows());
+}
+
+TEST_F(ReadAheadTest, StopLeavesRowsUnread) {
+  expect_rows(0);
+  READ_AHEAD read_ahead(dbc, &result, 2, 4);
+
+  ASSERT_NE(nullptr, read_ahead.fetch_row());
+  read_ahead.stop();
+
+  // One row per batch, the batch of the application and the ones kept ahead
+  EXPECT_LE(rows_read.load(), READ_AHEAD::BATCHES + 2);
+}
+
+TEST_F(ReadAheadTest, StopWhileConnectionLocked) {
+  expect_rows(0);
+  LOCK_DBC(dbc);
+  READ_AHEAD read_ahead(dbc, &result, 2, 4);
+
+  // The worker does not read while the connection is in use, and gives up waiting for it
+  read_ahead.stop();
+  EXPECT_EQ(0u, rows_read.load());
+}
+
+TEST_F(ReadAheadTest, FetchWhileConnectionLocked) {
+  expect_rows(10);
+  READ_AHEAD read_ahead(dbc, &result, 2, 4);
+
+  // Rows the worker read before are returned first, then the ones left in the result
+  for (size_t n = 0; n < 10; ++n) {
+    LOCK_DBC(dbc);
+    MYSQL_ROW values = read_ahead.fetch_row();
+    ASSERT_NE(nullptr, values);
+    const std::string first = "row" + std::to_string(n);
+    EXPECT_STREQ(first.c_str(), values[0]);
+    EXPECT_EQ(first.size(), read_ahead.fetch_lengths()[0]);
+    EXPECT_EQ(n + 1, read_ahead.num_rows());
+  }
+
+  LOCK_DBC(dbc);
+  EXPECT_EQ(nullptr, read_ahead.fetch_row());
+  EXPECT_EQ(10u, read_ahead.num_rows());
+}
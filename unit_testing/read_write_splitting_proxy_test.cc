@@ -0,0 +1,351 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using ::testing::_;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::StrEq;
+using ::testing::Truly;
+
+namespace {
+    SQLHENV env;
+    DBC* dbc;
+    DataSource* ds;
+
+    bool is_read_only(const char* q) {
+        return READ_WRITE_SPLITTING_PROXY::is_read_only_query(q, static_cast<unsigned long>(strlen(q)));
+    }
+
+    std::function<bool(std::shared_ptr<HOST_INFO>)> is_host(const std::string& host) {
+        return [host](std::shared_ptr<HOST_INFO> h) { return h->get_host() == host; };
+    }
+}
+
+class ReadWriteSplittingProxyTest : public testing::Test {
+protected:
+    MOCK_CONNECTION_PROXY* writer_proxy;
+    MOCK_CONNECTION_PROXY* reader_proxy;
+    std::shared_ptr<MOCK_TOPOLOGY_SERVICE> mock_ts;
+    std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology;
+    std::shared_ptr<HOST_INFO> reader_a;
+    std::shared_ptr<HOST_INFO> reader_b;
+
+    static void SetUpTestSuite() {}
+
+    static void TearDownTestSuite() {
+        mysql_library_end();
+    }
+
+    void SetUp() override {
+        allocate_odbc_handles(env, dbc, ds);
+        dbc->ds = ds;
+        ds->opt_ENABLE_READ_WRITE_SPLITTING = true;
+
+        writer_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+        reader_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+        EXPECT_CALL(*writer_proxy, mock_connection_proxy_destructor());
+        EXPECT_CALL(*reader_proxy, mock_connection_proxy_destructor());
+
+        reader_a = std::make_shared<HOST_INFO>("reader-a", 3306, UP, false);
+        reader_b = std::make_shared<HOST_INFO>("reader-b", 3306, UP, false);
+        topology = std::make_shared<CLUSTER_TOPOLOGY_INFO>();
+        topology->add_host(std::make_shared<HOST_INFO>("writer", 3306, UP, true));
+        topology->add_host(reader_a);
+        topology->add_host(reader_b);
+
+        mock_ts = std::make_shared<MOCK_TOPOLOGY_SERVICE>();
+        dbc->topology_service = mock_ts;
+        ON_CALL(*mock_ts, get_topology(_, _)).WillByDefault(Return(topology));
+        ON_CALL(*reader_proxy, is_connected()).WillByDefault(Return(true));
+    }
+
+    void TearDown() override {
+        dbc->topology_service.reset();
+        dbc->ds = nullptr;
+        cleanup_odbc_handles(env, dbc, ds);
+    }
+};
+
+TEST_F(ReadWriteSplittingProxyTest, IsReadOnlyQuery) {
+    EXPECT_TRUE(is_read_only("SELECT 1"));
+    EXPECT_TRUE(is_read_only("  select a, b FROM t WHERE a > 1"));
+    EXPECT_TRUE(is_read_only("(SELECT a FROM t) UNION (SELECT a FROM u)"));
+    EXPECT_TRUE(is_read_only("SELECT format FROM t"));
+
+    EXPECT_FALSE(is_read_only("SELECT a FROM t FOR UPDATE"));
+    EXPECT_FALSE(is_read_only("SELECT a FROM t LOCK IN SHARE MODE"));
+    EXPECT_FALSE(is_read_only("SELECT a INTO @a FROM t"));
+    EXPECT_FALSE(is_read_only("SELECT LAST_INSERT_ID()"));
+    EXPECT_FALSE(is_read_only("SELECT GET_LOCK('a', 10)"));
+    EXPECT_FALSE(is_read_only("SELECT 1; DELETE FROM t"));
+    EXPECT_FALSE(is_read_only("SELECTED"));
+    EXPECT_FALSE(is_read_only("UPDATE t SET a = 1"));
+    EXPECT_FALSE(is_read_only("SHOW TABLES"));
+}
+
+TEST_F(ReadWriteSplittingProxyTest, ReadOnlyModeUsesReader) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(StrEq("SELECT 1"), 8)).Times(2).WillRepeatedly(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("INSERT INTO t VALUES (1)"), _)).WillOnce(Return(0));
+
+    dbc->read_only = true;
+    EXPECT_EQ(0, proxy.query("SELECT 1"));
+    EXPECT_EQ(0, proxy.query("SELECT 1"));
+
+    dbc->read_only = false;
+    EXPECT_EQ(0, proxy.query("INSERT INTO t VALUES (1)"));
+}
+
+TEST_F(ReadWriteSplittingProxyTest, TransactionStaysOnReader) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(_, _)).Times(2).WillRepeatedly(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(_, _)).Times(0);
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+
+    dbc->transaction_open = true;
+    dbc->read_only = false;
+    proxy.query("COMMIT");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, AutocommitSelectsUseReader) {
+    ds->opt_READ_WRITE_SPLITTING_SELECTS = true;
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(*writer_proxy, get_server_status()).WillRepeatedly(Return(SERVER_STATUS_AUTOCOMMIT));
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(StrEq("SELECT a FROM t"), _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("SELECT a FROM t FOR UPDATE"), _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("UPDATE t SET a = 1"), _)).WillOnce(Return(0));
+
+    proxy.query("SELECT a FROM t");
+    proxy.query("SELECT a FROM t FOR UPDATE");
+    proxy.query("UPDATE t SET a = 1");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, SelectsUseWriterWithoutAutocommit) {
+    ds->opt_READ_WRITE_SPLITTING_SELECTS = true;
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(*writer_proxy, get_server_status()).WillRepeatedly(Return(0));
+    EXPECT_CALL(proxy, connect_to_reader(_)).Times(0);
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("SELECT a FROM t"), _)).WillOnce(Return(0));
+
+    proxy.query("SELECT a FROM t");
+    delete reader_proxy;
+}
+
+TEST_F(ReadWriteSplittingProxyTest, SessionStatementsAppliedToBoth) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(StrEq("SELECT 1"), _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("SET AUTOCOMMIT=0"), _)).WillOnce(Return(0));
+    EXPECT_CALL(*reader_proxy, real_query(StrEq("SET AUTOCOMMIT=0"), _)).WillOnce(Return(0));
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+    proxy.query("SET AUTOCOMMIT=0");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, SessionStatementsReplayedOnNewReader) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("USE other_db"), _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("SET @@time_zone = '+00:00'"), _)).WillOnce(Return(0));
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    {
+        InSequence reader_session;
+        EXPECT_CALL(*reader_proxy, select_db(StrEq("other_db"))).WillOnce(Return(0));
+        EXPECT_CALL(*reader_proxy, real_query(StrEq("USE other_db"), _)).WillOnce(Return(0));
+        EXPECT_CALL(*reader_proxy, real_query(StrEq("SET @@time_zone = '+00:00'"), _)).WillOnce(Return(0));
+        EXPECT_CALL(*reader_proxy, real_query(StrEq("SELECT 1"), _)).WillOnce(Return(0));
+    }
+
+    // Neither statement needed the reader, which is opened afterwards
+    proxy.query("USE other_db");
+    proxy.query("SET @@time_zone = '+00:00'");
+    dbc->database = "other_db";
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, ReaderNotUsedIfSessionCannotBeRestored) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("USE other_db"), _)).WillOnce(Return(0));
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(StrEq("USE other_db"), _)).WillOnce(Return(1));
+    EXPECT_CALL(*reader_proxy, error()).WillRepeatedly(Return("Unknown database"));
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("SELECT 1"), _)).WillOnce(Return(0));
+    EXPECT_CALL(*mock_ts, mark_host_down(_)).Times(0);
+
+    proxy.query("USE other_db");
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, UnavailableReadersUseWriter) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(*mock_ts, get_topology(_, _)).Times(1);
+    EXPECT_CALL(proxy, connect_to_reader(_)).Times(2).WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(*mock_ts, mark_host_down(_)).Times(2);
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("SELECT 1"), _)).Times(2).WillRepeatedly(Return(0));
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+    // Readers are not tried again before the topology is refreshed
+    proxy.query("SELECT 1");
+    delete reader_proxy;
+}
+
+TEST_F(ReadWriteSplittingProxyTest, LeastReplicaLagSelector) {
+    const std::string strategy = READER_HOST_SELECTOR_LEAST_REPLICA_LAG;
+    ds->opt_READER_HOST_SELECTOR_STRATEGY.set_remove_brackets(to_sqlwchar_string(strategy).c_str(), strategy.size());
+    reader_a->replica_lag = "20";
+    reader_b->replica_lag = "5";
+
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(Truly(is_host("reader-b")))).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(_, _)).WillOnce(Return(0));
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, CloseReleasesReader) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(_, _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, close());
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+    proxy.close();
+}
+
+TEST_F(ReadWriteSplittingProxyTest, PreparedStatementStaysOnReader) {
+    MYSQL_STMT* const stmt = reinterpret_cast<MYSQL_STMT*>(0x10);
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, stmt_init()).WillOnce(Return(stmt));
+    EXPECT_CALL(*reader_proxy, stmt_execute(stmt)).WillOnce(Return(0));
+    EXPECT_CALL(*reader_proxy, stmt_close(stmt)).WillOnce(Return(false));
+    EXPECT_CALL(*writer_proxy, stmt_execute(_)).Times(0);
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("INSERT INTO t VALUES (1)"), _)).WillOnce(Return(0));
+
+    dbc->read_only = true;
+    EXPECT_EQ(stmt, proxy.stmt_init());
+
+    dbc->read_only = false;
+    EXPECT_EQ(0, proxy.query("INSERT INTO t VALUES (1)"));
+    EXPECT_EQ(0, proxy.stmt_execute(stmt));
+    EXPECT_FALSE(proxy.stmt_close(stmt));
+}
+
+TEST_F(ReadWriteSplittingProxyTest, PendingResultsKeepConnection) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(_, _)).Times(2).WillRepeatedly(Return(0));
+    EXPECT_CALL(*reader_proxy, more_results()).WillOnce(Return(true));
+    EXPECT_CALL(*writer_proxy, real_query(_, _)).Times(0);
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1; SELECT 2");
+
+    // The next result of the statement is still to be read from the reader
+    dbc->read_only = false;
+    proxy.query("SELECT 3");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, LostReaderDoesNotFailOverWriter) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(_, _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(StrEq("SELECT 1"), _)).WillOnce(Return(0));
+    EXPECT_CALL(*mock_ts, mark_host_down(_)).Times(1);
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+
+    EXPECT_CALL(*reader_proxy, is_connected()).WillRepeatedly(Return(false));
+    EXPECT_TRUE(proxy.release_failed_reader());
+
+    dbc->read_only = false;
+    proxy.query("SELECT 1");
+}
+
+TEST_F(ReadWriteSplittingProxyTest, LostWriterFailsOver) {
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, real_query(_, _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, real_query(_, _)).WillOnce(Return(0));
+    EXPECT_CALL(*writer_proxy, is_connected()).WillRepeatedly(Return(false));
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+    dbc->read_only = false;
+    proxy.query("INSERT INTO t VALUES (1)");
+
+    // Both connections were lost while the writer was in use
+    EXPECT_CALL(*reader_proxy, is_connected()).WillRepeatedly(Return(false));
+    EXPECT_FALSE(proxy.release_failed_reader());
+}
+
+TEST_F(ReadWriteSplittingProxyTest, ReaderKeptUntilStatementsClosed) {
+    MYSQL_STMT* const stmt = reinterpret_cast<MYSQL_STMT*>(0x10);
+    bool reader_deleted = false;
+    ON_CALL(*reader_proxy, mock_connection_proxy_destructor()).WillByDefault([&reader_deleted]() {
+        reader_deleted = true;
+    });
+
+    TEST_READ_WRITE_SPLITTING_PROXY proxy(dbc, ds, writer_proxy);
+    EXPECT_CALL(proxy, connect_to_reader(_)).WillOnce(Return(reader_proxy));
+    EXPECT_CALL(*reader_proxy, stmt_init()).WillOnce(Return(stmt));
+    EXPECT_CALL(*reader_proxy, stmt_close(stmt)).WillOnce(Return(false));
+    EXPECT_CALL(*reader_proxy, real_query(_, _)).WillOnce(Return(0));
+    EXPECT_CALL(*mock_ts, mark_host_down(_)).Times(1);
+
+    dbc->read_only = true;
+    proxy.query("SELECT 1");
+    proxy.stmt_init();
+
+    EXPECT_CALL(*reader_proxy, is_connected()).WillRepeatedly(Return(false));
+    EXPECT_TRUE(proxy.release_failed_reader());
+    EXPECT_FALSE(reader_deleted);
+
+    proxy.stmt_close(stmt);
+    EXPECT_TRUE(reader_deleted);
+}
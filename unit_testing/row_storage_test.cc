@@ -0,0 +1,100 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+
+#include <gtest/gtest.h>
+
+#include "test_utils.h"
+
+#include <string>
+
+class RowStorageTest : public testing::Test {};
+
+TEST_F(RowStorageTest, StoresValuesAndNulls) {
+  ROW_STORAGE storage(1, 3);
+
+  storage[0] = "value";
+  storage[1] = (const char*)nullptr;
+  storage[2] = "";
+
+  const char** data = storage.data();
+  EXPECT_STREQ("value", data[0]);
+  EXPECT_EQ(nullptr, data[1]);
+  EXPECT_STREQ("", data[2]);
+}
+
+TEST_F(RowStorageTest, OverwrittenValuesAreReclaimed) {
+  ROW_STORAGE storage(2, 2);
+  const std::string value(100, 'x');
+
+  for (int i = 0; i < 10000; ++i) {
+    storage[i % 2] = value.c_str();
+  }
+  storage.next_row();
+  storage[0] = "second row";
+
+  // Without reclaiming, 10000 values of 101 bytes would have been appended
+  EXPECT_GT(3 * ROW_STORAGE_MIN_GARBAGE, storage.m_arena.size());
+
+  const char** data = storage.data();
+  EXPECT_EQ(value, data[0]);
+  EXPECT_EQ(value, data[1]);
+  EXPECT_STREQ("second row", data[2]);
+  EXPECT_STREQ("", data[3]);
+}
+
+TEST_F(RowStorageTest, CopiedCellsSurviveCompaction) {
+  ROW_STORAGE storage(1, 3);
+
+  storage[0] = "shared";
+  storage[1] = storage[0];
+
+  // Overwriting the original enough times compacts the arena
+  for (int i = 0; i < 1000; ++i) {
+    storage[2] = std::to_string(i).append(50, '-').c_str();
+  }
+  storage[0] = "changed";
+
+  const char** data = storage.data();
+  EXPECT_STREQ("changed", data[0]);
+  EXPECT_STREQ("shared", data[1]);
+  EXPECT_EQ(std::string("999").append(50, '-'), data[2]);
+}
+
+TEST_F(RowStorageTest, InvalidateKeepsStorageUsable) {
+  ROW_STORAGE storage(1, 1);
+
+  storage[0] = "before";
+  EXPECT_TRUE(storage.invalidate());
+  EXPECT_FALSE(storage.is_valid());
+
+  storage.set_size(1, 1);
+  storage[0] = "after";
+  EXPECT_STREQ("after", storage.data()[0]);
+}
@@ -0,0 +1,143 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using testing::_;
+using testing::Return;
+using testing::StrEq;
+
+class SelectLimitTest : public testing::Test {
+ protected:
+  SQLHENV env;
+  DBC* dbc;
+  DataSource* ds;
+  MOCK_CONNECTION_PROXY* mock_connection_proxy;
+  STMT* stmt;
+
+  static void SetUpTestSuite() {}
+
+  static void TearDownTestSuite() { mysql_library_end(); }
+
+  void SetUp() override {
+    allocate_odbc_handles(env, dbc, ds);
+    dbc->ds = ds;
+    // A recent query spares the ping of is_server_alive()
+    dbc->last_query_time = time(nullptr);
+    dbc->cxn_charset_info = get_charset_by_csname("utf8mb4", MYF(MY_CS_PRIMARY), MYF(0));
+    mock_connection_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+    EXPECT_CALL(*mock_connection_proxy, get_server_version()).WillRepeatedly(Return((char*)"8.0.32"));
+    delete dbc->connection_proxy;
+    dbc->connection_proxy = mock_connection_proxy;
+
+    stmt = new STMT(dbc);
+    stmt->stmt_options.max_rows = 10;
+  }
+
+  void TearDown() override {
+    delete stmt;
+    dbc->ds = nullptr;
+    cleanup_odbc_handles(env, dbc, ds);
+  }
+
+  // Returns the query as do_query() would send it, "" if no hint was added
+  std::string with_hint(const std::string& text) {
+    std::string copy(text);
+    stmt->query.reset(&copy[0], &copy[0] + copy.size(), dbc->cxn_charset_info);
+    EXPECT_FALSE(parse(&stmt->query));
+
+    const char* query = GET_QUERY(&stmt->query);
+    SQLULEN query_length = copy.size();
+    if (!add_select_limit_hint(stmt, &query, &query_length)) {
+      return "";
+    }
+    return std::string(query, query_length);
+  }
+};
+
+TEST_F(SelectLimitTest, HintAddedToSelect) {
+  EXPECT_EQ("SELECT /*+ SET_VAR(sql_select_limit=10) */ a FROM t", with_hint("SELECT a FROM t"));
+  EXPECT_EQ("  select /*+ SET_VAR(sql_select_limit=10) */ a FROM t", with_hint("  select a FROM t"));
+}
+
+TEST_F(SelectLimitTest, HintAddedBeforeComment) {
+  EXPECT_EQ("SELECT /*+ SET_VAR(sql_select_limit=10) */ /* note */ a FROM t",
+            with_hint("SELECT /* note */ a FROM t"));
+}
+
+TEST_F(SelectLimitTest, NoHintAfterExistingHint) {
+  EXPECT_EQ("", with_hint("SELECT /*+ MAX_EXECUTION_TIME(1000) */ a FROM t"));
+}
+
+TEST_F(SelectLimitTest, NoHintForOtherStatements) {
+  EXPECT_EQ("", with_hint("UPDATE t SET a = 1"));
+  EXPECT_EQ("", with_hint("INSERT INTO t SELECT a FROM u"));
+}
+
+TEST_F(SelectLimitTest, NoHintWithoutLimitOrOnOldServer) {
+  stmt->stmt_options.max_rows = 0;
+  EXPECT_EQ("", with_hint("SELECT a FROM t"));
+
+  stmt->stmt_options.max_rows = 10;
+  dbc->sql_select_limit = 5;
+  EXPECT_EQ("", with_hint("SELECT a FROM t"));
+
+  dbc->sql_select_limit = 0;
+  EXPECT_CALL(*mock_connection_proxy, get_server_version()).WillRepeatedly(Return((char*)"5.7.44"));
+  EXPECT_EQ("", with_hint("SELECT a FROM t"));
+}
+
+TEST_F(SelectLimitTest, NoQueryForUnlimitedFirstStatement) {
+  EXPECT_CALL(*mock_connection_proxy, real_query(_, _)).Times(0);
+
+  // The driver has not set a limit for the session yet
+  EXPECT_EQ(SQL_SUCCESS, set_sql_select_limit(dbc, 0, false));
+  EXPECT_EQ(SQL_SUCCESS, set_sql_select_limit(dbc, sql_select_unlimited, false));
+}
+
+TEST_F(SelectLimitTest, SessionLimitSetAndReset) {
+  EXPECT_CALL(*mock_connection_proxy, is_connected()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock_connection_proxy, real_query(StrEq("set @@sql_select_limit=10"), _)).WillOnce(Return(0));
+  EXPECT_CALL(*mock_connection_proxy, real_query(StrEq("set @@sql_select_limit=DEFAULT"), _)).WillOnce(Return(0));
+
+  EXPECT_EQ(SQL_SUCCESS, set_sql_select_limit(dbc, 10, false));
+  EXPECT_EQ(10u, dbc->sql_select_limit);
+  EXPECT_EQ(SQL_SUCCESS, set_sql_select_limit(dbc, 10, false));
+
+  EXPECT_EQ(SQL_SUCCESS, set_sql_select_limit(dbc, 0, false));
+  EXPECT_EQ(0u, dbc->sql_select_limit);
+  EXPECT_EQ(SQL_SUCCESS, set_sql_select_limit(dbc, 0, false));
+}
@@ -0,0 +1,87 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include <errmsg.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using testing::Return;
+
+class ServerAliveTest : public testing::Test {
+ protected:
+  SQLHENV env;
+  DBC* dbc;
+  DataSource* ds;
+  MOCK_CONNECTION_PROXY* mock_connection_proxy;
+
+  static void SetUpTestSuite() {}
+
+  static void TearDownTestSuite() { mysql_library_end(); }
+
+  void SetUp() override {
+    allocate_odbc_handles(env, dbc, ds);
+    dbc->ds = ds;
+    mock_connection_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+    delete dbc->connection_proxy;
+    dbc->connection_proxy = mock_connection_proxy;
+  }
+
+  void TearDown() override {
+    dbc->ds = nullptr;
+    cleanup_odbc_handles(env, dbc, ds);
+  }
+};
+
+TEST_F(ServerAliveTest, PingsAfterIdlePeriod) {
+  dbc->last_query_time = 0;
+  EXPECT_CALL(*mock_connection_proxy, ping()).WillOnce(Return(1));
+  EXPECT_CALL(*mock_connection_proxy, error_code()).WillOnce(Return(CR_SERVER_GONE_ERROR));
+
+  EXPECT_FALSE(is_server_alive(dbc));
+}
+
+TEST_F(ServerAliveTest, NoPingWhileActive) {
+  dbc->last_query_time = time(nullptr);
+  EXPECT_CALL(*mock_connection_proxy, ping()).Times(0);
+
+  EXPECT_TRUE(is_server_alive(dbc));
+}
+
+TEST_F(ServerAliveTest, NoIdlePing) {
+  ds->opt_NO_IDLE_PING = true;
+  dbc->last_query_time = 0;
+  EXPECT_CALL(*mock_connection_proxy, ping()).Times(0);
+
+  EXPECT_TRUE(is_server_alive(dbc));
+  EXPECT_NE(0, dbc->last_query_time);
+}
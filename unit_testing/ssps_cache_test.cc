@@ -0,0 +1,190 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "driver/ssps_cache.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using testing::_;
+using testing::Return;
+
+namespace {
+// The cache never dereferences the handles it keeps
+MYSQL_STMT* const stmt_a = reinterpret_cast<MYSQL_STMT*>(0x10);
+MYSQL_STMT* const stmt_b = reinterpret_cast<MYSQL_STMT*>(0x20);
+MYSQL_STMT* const stmt_c = reinterpret_cast<MYSQL_STMT*>(0x30);
+}  // namespace
+
+class SspsCacheTest : public testing::Test {
+ protected:
+  SQLHENV env;
+  DBC* dbc;
+  DataSource* ds;
+  MOCK_CONNECTION_PROXY* mock_connection_proxy;
+
+  static void SetUpTestSuite() {}
+
+  static void TearDownTestSuite() { mysql_library_end(); }
+
+  void SetUp() override {
+    allocate_odbc_handles(env, dbc, ds);
+    mock_connection_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    EXPECT_CALL(*mock_connection_proxy, mock_connection_proxy_destructor());
+  }
+
+  void TearDown() override {
+    delete mock_connection_proxy;
+    cleanup_odbc_handles(env, dbc, ds);
+  }
+};
+
+TEST_F(SspsCacheTest, KeyIgnoresSurroundingWhitespace) {
+  const std::string query = "SELECT ? FROM t";
+  const std::string padded = "  \n" + query + " \t";
+
+  EXPECT_EQ(SSPS_CACHE::make_key(query.c_str(), query.size(), 255, "db"),
+            SSPS_CACHE::make_key(padded.c_str(), padded.size(), 255, "db"));
+  EXPECT_NE(SSPS_CACHE::make_key(query.c_str(), query.size(), 255, "db"),
+            SSPS_CACHE::make_key(query.c_str(), query.size(), 8, "db"));
+  EXPECT_NE(SSPS_CACHE::make_key(query.c_str(), query.size(), 255, "db"),
+            SSPS_CACHE::make_key(query.c_str(), query.size(), 255, "other"));
+}
+
+TEST_F(SspsCacheTest, TakeReturnsCachedHandleOnce) {
+  SSPS_CACHE cache;
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(_)).Times(0);
+
+  cache.put("a", stmt_a, cache.get_epoch(), 2, mock_connection_proxy);
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ(stmt_a, cache.take("a"));
+  EXPECT_EQ(nullptr, cache.take("a"));
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(SspsCacheTest, EvictsLeastRecentlyUsed) {
+  SSPS_CACHE cache;
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(stmt_b)).WillOnce(Return(false));
+
+  cache.put("a", stmt_a, cache.get_epoch(), 2, mock_connection_proxy);
+  cache.put("b", stmt_b, cache.get_epoch(), 2, mock_connection_proxy);
+  // Using "a" again makes "b" the least recently used handle
+  cache.put("a", cache.take("a"), cache.get_epoch(), 2, mock_connection_proxy);
+  cache.put("c", stmt_c, cache.get_epoch(), 2, mock_connection_proxy);
+
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(nullptr, cache.take("b"));
+  EXPECT_EQ(stmt_a, cache.take("a"));
+  EXPECT_EQ(stmt_c, cache.take("c"));
+}
+
+TEST_F(SspsCacheTest, ClosesDuplicateHandle) {
+  SSPS_CACHE cache;
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(stmt_b)).WillOnce(Return(false));
+
+  cache.put("a", stmt_a, cache.get_epoch(), 2, mock_connection_proxy);
+  cache.put("a", stmt_b, cache.get_epoch(), 2, mock_connection_proxy);
+
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ(stmt_a, cache.take("a"));
+}
+
+TEST_F(SspsCacheTest, ClearInvalidatesOutstandingHandles) {
+  SSPS_CACHE cache;
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(stmt_a)).WillOnce(Return(false));
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(stmt_b)).WillOnce(Return(false));
+
+  const unsigned long long epoch = cache.get_epoch();
+  cache.put("a", stmt_a, epoch, 2, mock_connection_proxy);
+  cache.clear(mock_connection_proxy);
+  EXPECT_EQ(0, cache.size());
+
+  // Handle prepared on the previous connection
+  cache.put("b", stmt_b, epoch, 2, mock_connection_proxy);
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(SspsCacheTest, DisabledCacheClosesHandles) {
+  SSPS_CACHE cache;
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(stmt_a)).WillOnce(Return(false));
+
+  cache.put("a", stmt_a, cache.get_epoch(), 0, mock_connection_proxy);
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(SspsCacheTest, ClosedStatementIsResetBeforeCaching) {
+  ds->opt_SSPS_CACHE_SIZE = 2;
+  dbc->ds = ds;
+  CONNECTION_PROXY* connection_proxy = dbc->connection_proxy;
+  dbc->connection_proxy = mock_connection_proxy;
+
+  STMT* stmt = new STMT(dbc);
+  stmt->ssps = stmt_a;
+  stmt->ssps_cache_key = "a";
+  stmt->ssps_cache_epoch = dbc->ssps_cache.get_epoch();
+
+  EXPECT_CALL(*mock_connection_proxy, stmt_free_result(stmt_a)).WillOnce(Return(false));
+  EXPECT_CALL(*mock_connection_proxy, stmt_reset(stmt_a)).WillOnce(Return(false));
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(_)).Times(0);
+
+  ssps_close(stmt);
+  EXPECT_EQ(nullptr, stmt->ssps);
+  EXPECT_EQ(stmt_a, dbc->ssps_cache.take("a"));
+
+  delete stmt;
+  dbc->connection_proxy = connection_proxy;
+  dbc->ds = nullptr;
+}
+
+TEST_F(SspsCacheTest, StatementThatCannotBeResetIsClosed) {
+  ds->opt_SSPS_CACHE_SIZE = 2;
+  dbc->ds = ds;
+  CONNECTION_PROXY* connection_proxy = dbc->connection_proxy;
+  dbc->connection_proxy = mock_connection_proxy;
+
+  STMT* stmt = new STMT(dbc);
+  stmt->ssps = stmt_a;
+  stmt->ssps_cache_key = "a";
+  stmt->ssps_cache_epoch = dbc->ssps_cache.get_epoch();
+
+  EXPECT_CALL(*mock_connection_proxy, stmt_free_result(stmt_a)).WillOnce(Return(false));
+  EXPECT_CALL(*mock_connection_proxy, stmt_reset(stmt_a)).WillOnce(Return(true));
+  EXPECT_CALL(*mock_connection_proxy, stmt_close(stmt_a)).WillOnce(Return(false));
+
+  ssps_close(stmt);
+  EXPECT_EQ(nullptr, stmt->ssps);
+  EXPECT_EQ(0, dbc->ssps_cache.size());
+
+  delete stmt;
+  dbc->connection_proxy = connection_proxy;
+  dbc->ds = nullptr;
+}
@@ -0,0 +1,233 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "driver/standby_connections.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::Truly;
+
+namespace {
+    std::function<bool(std::shared_ptr<HOST_INFO>)> is_host(const std::string& host) {
+        return [host](std::shared_ptr<HOST_INFO> h) { return h->get_host() == host; };
+    }
+}  // namespace
+
+class StandbyConnectionsTest : public testing::Test {
+protected:
+    SQLHENV env;
+    DBC* dbc;
+    DataSource* ds;
+    std::shared_ptr<MOCK_CONNECTION_HANDLER> mock_connection_handler;
+    std::shared_ptr<MOCK_TOPOLOGY_SERVICE> mock_ts;
+    std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology;
+    std::shared_ptr<HOST_INFO> writer;
+    std::shared_ptr<HOST_INFO> reader_a;
+    std::shared_ptr<HOST_INFO> reader_b;
+    std::shared_ptr<HOST_INFO> reader_c;
+
+    static void SetUpTestSuite() {}
+
+    static void TearDownTestSuite() {
+        mysql_library_end();
+    }
+
+    void SetUp() override {
+        allocate_odbc_handles(env, dbc, ds);
+        mock_connection_handler = std::make_shared<MOCK_CONNECTION_HANDLER>();
+        mock_ts = std::make_shared<MOCK_TOPOLOGY_SERVICE>();
+
+        writer = std::make_shared<HOST_INFO>("writer", 3306, UP, true);
+        reader_a = std::make_shared<HOST_INFO>("reader-a", 3306, UP, false);
+        reader_b = std::make_shared<HOST_INFO>("reader-b", 3306, UP, false);
+        reader_c = std::make_shared<HOST_INFO>("reader-c", 3306, UP, false);
+        reader_a->replica_lag = "30";
+        reader_b->replica_lag = "10";
+        reader_c->replica_lag = "20";
+
+        topology = std::make_shared<CLUSTER_TOPOLOGY_INFO>();
+        topology->add_host(writer);
+        topology->add_host(reader_a);
+        topology->add_host(reader_b);
+        topology->add_host(reader_c);
+        ON_CALL(*mock_ts, get_cached_topology()).WillByDefault(Return(topology));
+    }
+
+    void TearDown() override {
+        cleanup_odbc_handles(env, dbc, ds);
+    }
+
+    MOCK_CONNECTION_PROXY* new_connection() {
+        auto proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+        ON_CALL(*proxy, is_connected()).WillByDefault(Return(true));
+        EXPECT_CALL(*proxy, mock_connection_proxy_destructor());
+        return proxy;
+    }
+};
+
+// Connections are kept to the readers with the lowest replication lag
+TEST_F(StandbyConnectionsTest, RefreshOpensConnections) {
+    STANDBY_CONNECTIONS standby(mock_ts, ds, 2, std::chrono::milliseconds(1000), 0);
+    standby.add_connection_handler(mock_connection_handler);
+    standby.set_current_host(mock_connection_handler, writer);
+
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-b")), _, false))
+        .WillOnce(Return(new_connection()));
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-c")), _, false))
+        .WillOnce(Return(new_connection()));
+
+    standby.refresh();
+    EXPECT_EQ(2u, standby.size());
+
+    standby.stop();
+    EXPECT_EQ(0u, standby.size());
+}
+
+TEST_F(StandbyConnectionsTest, TakeChecksConnection) {
+    STANDBY_CONNECTIONS standby(mock_ts, ds, 1, std::chrono::milliseconds(1000), 0);
+    standby.add_connection_handler(mock_connection_handler);
+    standby.set_current_host(mock_connection_handler, writer);
+
+    auto connection = new_connection();
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-b")), _, false))
+        .WillOnce(Return(connection));
+    EXPECT_CALL(*connection, ping()).WillOnce(Return(0));
+
+    standby.refresh();
+    EXPECT_EQ(nullptr, standby.take(reader_a));
+    EXPECT_EQ(connection, standby.take(reader_b));
+    EXPECT_EQ(nullptr, standby.take(reader_b));
+    EXPECT_EQ(0u, standby.size());
+
+    delete connection;
+}
+
+TEST_F(StandbyConnectionsTest, TakeDropsFailedConnection) {
+    STANDBY_CONNECTIONS standby(mock_ts, ds, 1, std::chrono::milliseconds(1000), 0);
+    standby.add_connection_handler(mock_connection_handler);
+    standby.set_current_host(mock_connection_handler, writer);
+
+    auto connection = new_connection();
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-b")), _, false))
+        .WillOnce(Return(connection));
+    EXPECT_CALL(*connection, ping()).WillOnce(Return(1));
+    EXPECT_CALL(*connection, delete_ds());
+
+    standby.refresh();
+    EXPECT_EQ(nullptr, standby.take(reader_b));
+    EXPECT_EQ(0u, standby.size());
+}
+
+// Connections to hosts that failed or became the current host are replaced
+TEST_F(StandbyConnectionsTest, RefreshReplacesConnections) {
+    STANDBY_CONNECTIONS standby(mock_ts, ds, 2, std::chrono::milliseconds(1000), 0);
+    standby.add_connection_handler(mock_connection_handler);
+    standby.set_current_host(mock_connection_handler, writer);
+
+    auto connection_b = new_connection();
+    auto connection_c = new_connection();
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-b")), _, false))
+        .WillOnce(Return(connection_b));
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-c")), _, false))
+        .WillOnce(Return(connection_c))
+        .WillOnce(Return(new_connection()));
+    standby.refresh();
+
+    // reader-b became the writer, reader-c stopped responding
+    standby.set_current_host(mock_connection_handler, reader_b);
+    EXPECT_CALL(*connection_b, delete_ds());
+    EXPECT_CALL(*connection_c, ping()).WillOnce(Return(1));
+    EXPECT_CALL(*connection_c, delete_ds());
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-a")), _, false))
+        .WillOnce(Return(new_connection()));
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("writer")), _, false)).Times(0);
+    standby.refresh();
+
+    EXPECT_EQ(2u, standby.size());
+}
+
+TEST_F(StandbyConnectionsTest, SharedPerClusterAndSettings) {
+    auto standby = STANDBY_CONNECTIONS::get_or_create("cluster-a", mock_ts, ds, 1, std::chrono::milliseconds(1000), 0);
+    EXPECT_EQ(standby, STANDBY_CONNECTIONS::get_or_create("cluster-a", mock_ts, ds, 1, std::chrono::milliseconds(1000), 0));
+    EXPECT_NE(standby, STANDBY_CONNECTIONS::get_or_create("cluster-b", mock_ts, ds, 1, std::chrono::milliseconds(1000), 0));
+
+    // Connections opened for another user are not handed over
+    DataSource other_ds;
+    other_ds.copy(ds);
+    const std::string user = "other-user";
+    other_ds.opt_UID.set_remove_brackets(to_sqlwchar_string(user).c_str(), user.size());
+    EXPECT_NE(standby,
+              STANDBY_CONNECTIONS::get_or_create("cluster-a", mock_ts, &other_ds, 1, std::chrono::milliseconds(1000), 0));
+}
+
+// Connections are opened through the handler of another connection once the first one is gone
+TEST_F(StandbyConnectionsTest, RemovedHandlerClosesItsConnections) {
+    auto other_connection_handler = std::make_shared<MOCK_CONNECTION_HANDLER>();
+    STANDBY_CONNECTIONS standby(mock_ts, ds, 1, std::chrono::milliseconds(1000), 0);
+    standby.add_connection_handler(mock_connection_handler);
+    standby.add_connection_handler(other_connection_handler);
+    standby.set_current_host(mock_connection_handler, writer);
+    standby.set_current_host(other_connection_handler, writer);
+
+    auto connection = new_connection();
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-b")), _, false))
+        .WillOnce(Return(connection));
+    standby.refresh();
+    EXPECT_EQ(1u, standby.size());
+
+    EXPECT_CALL(*connection, delete_ds());
+    standby.remove_connection_handler(mock_connection_handler);
+    EXPECT_EQ(0u, standby.size());
+
+    EXPECT_CALL(*other_connection_handler, connect_impl(Truly(is_host("reader-b")), _, false))
+        .WillOnce(Return(new_connection()));
+    standby.refresh();
+    EXPECT_EQ(1u, standby.size());
+}
+
+// Only the host every connection is connected to is skipped
+TEST_F(StandbyConnectionsTest, KeepsConnectionToHostOfOtherConnections) {
+    auto other_connection_handler = std::make_shared<MOCK_CONNECTION_HANDLER>();
+    STANDBY_CONNECTIONS standby(mock_ts, ds, 1, std::chrono::milliseconds(1000), 0);
+    standby.add_connection_handler(mock_connection_handler);
+    standby.add_connection_handler(other_connection_handler);
+    standby.set_current_host(mock_connection_handler, reader_b);
+    standby.set_current_host(other_connection_handler, writer);
+
+    EXPECT_CALL(*mock_connection_handler, connect_impl(Truly(is_host("reader-b")), _, false))
+        .WillOnce(Return(new_connection()));
+    standby.refresh();
+    EXPECT_EQ(1u, standby.size());
+}
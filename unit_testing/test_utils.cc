@@ -32,6 +32,8 @@
 #include "driver/custom_endpoint_monitor.h"
 #include "driver/custom_endpoint_proxy.h"
 
+#include <thread>
+
 void allocate_odbc_handles(SQLHENV& env, DBC*& dbc, DataSource*& ds) {
     SQLHDBC hdbc = nullptr;
 
@@ -63,6 +65,17 @@ void cleanup_odbc_handles(SQLHENV env, DBC*& dbc, DataSource*& ds, bool call_myo
     }
 }
 
+bool TEST_UTILS::wait_until(std::function<bool()> condition, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
 std::chrono::milliseconds TEST_UTILS::get_connection_check_interval(std::shared_ptr<MONITOR> monitor) {
     return monitor->get_connection_check_interval();
 }
@@ -88,7 +101,7 @@ bool TEST_UTILS::has_monitor(std::shared_ptr<MONITOR_THREAD_CONTAINER> container
 }
 
 bool TEST_UTILS::has_task(std::shared_ptr<MONITOR_THREAD_CONTAINER> container, std::shared_ptr<MONITOR> monitor) {
-    return container->task_map.count(monitor) > 0;
+    return container->task_map.count(monitor) > 0 || container->scheduled_monitors.count(monitor) > 0;
 }
 
 bool TEST_UTILS::has_available_monitor(std::shared_ptr<MONITOR_THREAD_CONTAINER> container) {
@@ -103,13 +116,17 @@ std::shared_ptr<MONITOR> TEST_UTILS::get_available_monitor(std::shared_ptr<MONIT
 }
 
 bool TEST_UTILS::has_any_tasks(std::shared_ptr<MONITOR_THREAD_CONTAINER> container) {
-    return !container->task_map.empty();
+    return !container->task_map.empty() || !container->scheduled_monitors.empty();
 }
 
 size_t TEST_UTILS::get_map_size(std::shared_ptr<MONITOR_THREAD_CONTAINER> container) {
     return container->monitor_map.size();
 }
 
+int TEST_UTILS::get_thread_pool_size(std::shared_ptr<MONITOR_THREAD_CONTAINER> container) {
+    return container->thread_pool.size();
+}
+
 std::list<std::shared_ptr<MONITOR_CONNECTION_CONTEXT>> TEST_UTILS::get_contexts(std::shared_ptr<MONITOR> monitor) {
     return monitor->contexts;
 }
@@ -170,6 +187,10 @@ std::string TEST_UTILS::get_rds_instance_host_pattern(std::string host) {
     return RDS_UTILS::get_rds_instance_host_pattern(host);
 }
 
+RDS_ENDPOINT TEST_UTILS::parse_rds_endpoint(std::string host) {
+    return RDS_UTILS::parse_endpoint(host);
+}
+
 CACHE_MAP<std::string, std::shared_ptr<CUSTOM_ENDPOINT_INFO>>& TEST_UTILS::get_custom_endpoint_cache() {
   return std::ref(CUSTOM_ENDPOINT_MONITOR::custom_endpoint_cache);
 }
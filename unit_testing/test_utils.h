@@ -49,6 +49,8 @@ void cleanup_odbc_handles(SQLHENV env, DBC*& dbc, DataSource*& ds, bool call_myo
 
 class TEST_UTILS {
  public:
+  // Returns whether the condition became true before the timeout
+  static bool wait_until(std::function<bool()> condition, std::chrono::milliseconds timeout = std::chrono::seconds(10));
   static std::chrono::milliseconds get_connection_check_interval(std::shared_ptr<MONITOR> monitor);
   static CONNECTION_STATUS check_connection_status(std::shared_ptr<MONITOR> monitor);
   static void populate_monitor_map(std::shared_ptr<MONITOR_THREAD_CONTAINER> container, std::set<std::string> node_keys,
@@ -60,6 +62,7 @@ class TEST_UTILS {
   static bool has_available_monitor(std::shared_ptr<MONITOR_THREAD_CONTAINER> container);
   static std::shared_ptr<MONITOR> get_available_monitor(std::shared_ptr<MONITOR_THREAD_CONTAINER> container);
   static size_t get_map_size(std::shared_ptr<MONITOR_THREAD_CONTAINER> container);
+  static int get_thread_pool_size(std::shared_ptr<MONITOR_THREAD_CONTAINER> container);
   static std::list<std::shared_ptr<MONITOR_CONNECTION_CONTEXT>> get_contexts(std::shared_ptr<MONITOR> monitor);
   static std::string build_cache_key(const char* host, const char* region, unsigned int port, const char* user);
   static bool token_cache_contains_key(std::unordered_map<std::string, TOKEN_INFO> token_cache, std::string cache_key);
@@ -75,6 +78,7 @@ class TEST_UTILS {
   static std::string get_rds_cluster_id(std::string host);
   static std::string get_rds_instance_id(std::string host);
   static std::string get_rds_instance_host_pattern(std::string host);
+  static RDS_ENDPOINT parse_rds_endpoint(std::string host);
   static CACHE_MAP<std::string, std::shared_ptr<CUSTOM_ENDPOINT_INFO>>& get_custom_endpoint_cache();
   static SLIDING_EXPIRATION_CACHE_WITH_CLEAN_UP_THREAD<std::string, std::shared_ptr<CUSTOM_ENDPOINT_MONITOR>>&
   get_custom_endpoint_monitor_cache();
@@ -0,0 +1,131 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, version 2.0
+// (GPLv2), as published by the Free Software Foundation, with the
+// following additional permissions:
+//
+// This program is distributed with certain software that is licensed
+// under separate terms, as designated in a particular file or component
+// or in the license documentation. Without limiting your rights under
+// the GPLv2, the authors of this program hereby grant you an additional
+// permission to link the program and your derivative works with the
+// separately licensed software that they have included with the program.
+//
+// Without limiting the foregoing grant of rights under the GPLv2 and
+// additional permission as to separately licensed software, this
+// program is also subject to the Universal FOSS Exception, version 1.0,
+// a copy of which can be found along with its FAQ at
+// http://oss.oracle.com/licenses/universal-foss-exception.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License, version 2.0, for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see
+// http://www.gnu.org/licenses/gpl-2.0.html.
+
+#include "driver/topology_monitor.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "test_utils.h"
+#include "mock_objects.h"
+
+using ::testing::_;
+using ::testing::DeleteArg;
+using ::testing::Return;
+using ::testing::ReturnNew;
+using ::testing::StrEq;
+
+namespace {
+    std::string cluster_id("topology-monitor-test-cluster");
+    char* writer[4] = { "writer-instance", WRITER_SESSION_ID, "2020-09-15 17:51:53.0", "13.5" };
+}  // namespace
+
+class TopologyMonitorTest : public testing::Test {
+protected:
+    SQLHENV env;
+    DBC* dbc;
+    DataSource* ds;
+    std::shared_ptr<HOST_INFO> host_template;
+    std::shared_ptr<HOST_INFO> initial_host;
+    std::shared_ptr<MOCK_CONNECTION_HANDLER> mock_connection_handler;
+    std::shared_ptr<TOPOLOGY_SERVICE> ts;
+
+    static void SetUpTestSuite() {}
+
+    static void TearDownTestSuite() {
+        mysql_library_end();
+    }
+
+    void SetUp() override {
+        allocate_odbc_handles(env, dbc, ds);
+        host_template = std::make_shared<HOST_INFO>("?.XYZ.us-east-2.rds.amazonaws.com", 1234);
+        initial_host = std::make_shared<HOST_INFO>("my-cluster.cluster-XYZ.us-east-2.rds.amazonaws.com", 1234);
+        mock_connection_handler = std::make_shared<MOCK_CONNECTION_HANDLER>();
+
+        ts = std::make_shared<TOPOLOGY_SERVICE>(0);
+        ts->set_cluster_id(cluster_id);
+    }
+
+    void TearDown() override {
+        ts->clear_all();
+        cleanup_odbc_handles(env, dbc, ds);
+    }
+};
+
+TEST_F(TopologyMonitorTest, RefreshInterval) {
+    const int stable = TOPOLOGY_MONITOR::STABLE_POLLS;
+
+    // Fast polling until the topology has been stable for a few polls
+    EXPECT_EQ(std::chrono::milliseconds(5000), TOPOLOGY_MONITOR::get_refresh_interval(30000, 5000, 0));
+    EXPECT_EQ(std::chrono::milliseconds(5000), TOPOLOGY_MONITOR::get_refresh_interval(30000, 5000, stable - 1));
+
+    // Then slowing down up to a multiple of the refresh rate
+    EXPECT_EQ(std::chrono::milliseconds(30000), TOPOLOGY_MONITOR::get_refresh_interval(30000, 5000, stable));
+    EXPECT_EQ(std::chrono::milliseconds(60000), TOPOLOGY_MONITOR::get_refresh_interval(30000, 5000, stable + 1));
+    EXPECT_EQ(std::chrono::milliseconds(120000), TOPOLOGY_MONITOR::get_refresh_interval(30000, 5000, stable + 2));
+    EXPECT_EQ(std::chrono::milliseconds(120000), TOPOLOGY_MONITOR::get_refresh_interval(30000, 5000, stable + 10));
+
+    // The fast rate is never slower than the refresh rate
+    EXPECT_EQ(std::chrono::milliseconds(1000), TOPOLOGY_MONITOR::get_refresh_interval(1000, 5000, 0));
+}
+
+TEST_F(TopologyMonitorTest, SharedPerCluster) {
+    auto monitor1 = TOPOLOGY_MONITOR::get_or_create(cluster_id, host_template, initial_host, ds, 0);
+    auto monitor2 = TOPOLOGY_MONITOR::get_or_create(cluster_id, host_template, initial_host, ds, 0);
+    auto monitor3 = TOPOLOGY_MONITOR::get_or_create("other-cluster", host_template, initial_host, ds, 0);
+
+    EXPECT_EQ(monitor1, monitor2);
+    EXPECT_NE(monitor1, monitor3);
+}
+
+TEST_F(TopologyMonitorTest, FastRefreshUpdatesSharedTopology) {
+    auto mock_proxy = new MOCK_CONNECTION_PROXY(dbc, ds);
+    EXPECT_CALL(*mock_connection_handler, connect_impl(_, _, true)).WillOnce(Return(mock_proxy));
+    EXPECT_CALL(*mock_proxy, is_connected()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mock_proxy, query(StrEq(RETRIEVE_TOPOLOGY_SQL))).WillRepeatedly(Return(0));
+    EXPECT_CALL(*mock_proxy, store_result()).WillRepeatedly(ReturnNew<MYSQL_RES>());
+    EXPECT_CALL(*mock_proxy, fetch_row(_))
+        .WillOnce(Return(writer))
+        .WillRepeatedly(Return(MYSQL_ROW{}));
+    EXPECT_CALL(*mock_proxy, free_result(_)).WillRepeatedly(DeleteArg<0>());
+    EXPECT_CALL(*mock_proxy, delete_ds());
+    EXPECT_CALL(*mock_proxy, mock_connection_proxy_destructor());
+
+    auto monitor = TOPOLOGY_MONITOR::get_or_create(cluster_id, host_template, initial_host, ds, 0);
+    monitor->add_connection_handler(mock_connection_handler);
+    monitor->request_fast_refresh();
+    ASSERT_TRUE(TEST_UTILS::wait_until([] { return ts->get_cached_topology() != nullptr; }));
+
+    auto topology = ts->get_cached_topology();
+    EXPECT_EQ(1, topology->total_hosts());
+
+    // Closes the monitoring connection opened through the handler
+    monitor->remove_connection_handler(mock_connection_handler);
+}
@@ -29,6 +29,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <future>
 #include <thread>
 
 #include "test_utils.h"
@@ -36,6 +37,7 @@
 
 using ::testing::_;
 using ::testing::DeleteArg;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnNew;
 using ::testing::StrEq;
@@ -287,3 +289,40 @@ TEST_F(TopologyServiceTest, ClearCache) {
     topology = ts->get_topology(mock_proxy);
     EXPECT_EQ(nullptr, topology);
 }
+
+TEST_F(TopologyServiceTest, ConcurrentRefreshQueriesOnce) {
+    std::promise<void> query_started;
+    std::promise<void> release_query;
+    std::shared_future<void> query_released = release_query.get_future().share();
+    EXPECT_CALL(*mock_proxy, query(StrEq(RETRIEVE_TOPOLOGY_SQL)))
+        .Times(1)
+        .WillOnce(Invoke([&query_started, query_released](const char*) {
+            query_started.set_value();
+            query_released.wait();
+            return 0;
+        }));
+    EXPECT_CALL(*mock_proxy, fetch_row(_))
+        .WillOnce(Return(reader1))
+        .WillOnce(Return(writer))
+        .WillOnce(Return(reader2))
+        .WillRepeatedly(Return(MYSQL_ROW{}));
+
+    TOPOLOGY_SERVICE* ts2 = new TOPOLOGY_SERVICE(0);
+    ts2->set_cluster_instance_template(cluster_instance);
+    ts2->set_cluster_id(cluster_id);
+
+    std::shared_ptr<CLUSTER_TOPOLOGY_INFO> topology1;
+    std::thread refresher([&topology1] { topology1 = ts->get_topology(mock_proxy); });
+    query_started.get_future().wait();
+
+    // The second connection uses the result of the query already in
+    // progress instead of issuing its own, whenever that query completes.
+    auto topology2 = std::async(std::launch::async, [ts2] { return ts2->get_topology(mock_proxy); });
+    release_query.set_value();
+    refresher.join();
+
+    EXPECT_NE(nullptr, topology1);
+    EXPECT_EQ(topology1, topology2.get());
+
+    delete ts2;
+}
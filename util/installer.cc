@@ -273,6 +273,10 @@ static SQLWCHAR W_FAILOVER_TIMEOUT[] = { 'F', 'A', 'I', 'L', 'O', 'V', 'E', 'R',
 static SQLWCHAR W_FAILOVER_TOPOLOGY_REFRESH_RATE[] = { 'F', 'A', 'I', 'L', 'O', 'V', 'E', 'R', '_', 'T', 'O', 'P', 'O', 'L', 'O', 'G', 'Y', '_', 'R', 'E', 'F', 'R', 'E', 'S', 'H', '_', 'R', 'A', 'T', 'E', 0 };
 static SQLWCHAR W_FAILOVER_WRITER_RECONNECT_INTERVAL[] = { 'F', 'A', 'I', 'L', 'O', 'V', 'E', 'R', '_', 'W', 'R', 'I', 'T', 'E', 'R', '_', 'R', 'E', 'C', 'O', 'N', 'N', 'E', 'C', 'T', '_', 'I', 'N', 'T', 'E', 'R', 'V', 'A', 'L', 0 };
 static SQLWCHAR W_FAILOVER_READER_CONNECT_TIMEOUT[] = { 'F', 'A', 'I', 'L', 'O', 'V', 'E', 'R', '_', 'R', 'E', 'A', 'D', 'E', 'R', '_', 'C', 'O', 'N', 'N', 'E', 'C', 'T', '_', 'T', 'I', 'M', 'E', 'O', 'U', 'T', 0 };
+static SQLWCHAR W_FAILOVER_READER_FANOUT[] = { 'F', 'A', 'I', 'L', 'O', 'V', 'E', 'R', '_', 'R', 'E', 'A', 'D', 'E', 'R', '_', 'F', 'A', 'N', 'O', 'U', 'T', 0 };
+static SQLWCHAR W_FAILOVER_READER_CONNECT_STAGGER[] = { 'F', 'A', 'I', 'L', 'O', 'V', 'E', 'R', '_', 'R', 'E', 'A', 'D', 'E', 'R', '_', 'C', 'O', 'N', 'N', 'E', 'C', 'T', '_', 'S', 'T', 'A', 'G', 'G', 'E', 'R', 0 };
+static SQLWCHAR W_STANDBY_CONNECTIONS[] = { 'S', 'T', 'A', 'N', 'D', 'B', 'Y', '_', 'C', 'O', 'N', 'N', 'E', 'C', 'T', 'I', 'O', 'N', 'S', 0 };
+static SQLWCHAR W_STANDBY_CONNECTION_REFRESH_INTERVAL[] = { 'S', 'T', 'A', 'N', 'D', 'B', 'Y', '_', 'C', 'O', 'N', 'N', 'E', 'C', 'T', 'I', 'O', 'N', '_', 'R', 'E', 'F', 'R', 'E', 'S', 'H', '_', 'I', 'N', 'T', 'E', 'R', 'V', 'A', 'L', 0 };
 static SQLWCHAR W_CONNECT_TIMEOUT[] = { 'C', 'O', 'N', 'N', 'E', 'C', 'T', '_', 'T', 'I', 'M', 'E', 'O', 'U', 'T', 0 };
 static SQLWCHAR W_NETWORK_TIMEOUT[] = { 'N', 'E', 'T', 'W', 'O', 'R', 'K', '_', 'T', 'I', 'M', 'E', 'O', 'U', 'T', 0 };
 
@@ -292,6 +296,22 @@ static SQLWCHAR W_WAIT_FOR_CUSTOM_ENDPOINT_INFO_TIMEOUT_MS[] = { 'W', 'A', 'I',
 static SQLWCHAR W_CUSTOM_ENDPOINT_MONITOR_EXPIRATION_MS[] = { 'C', 'U', 'S', 'T', 'O', 'M', '_', 'E', 'N', 'D', 'P', 'O', 'I', 'N', 'T', '_', 'M', 'O', 'N', 'I', 'T', 'O', 'R', '_', 'E', 'X', 'P', 'I', 'R', 'A', 'T', 'I', 'O', 'N', '_', 'M', 'S', 0 };
 static SQLWCHAR W_CUSTOM_ENDPOINT_REGION[] = { 'C', 'U', 'S', 'T', 'O', 'M', '_', 'E', 'N', 'D', 'P', 'O', 'I', 'N', 'T', '_', 'R', 'E', 'G', 'I', 'O', 'N', 0 };
 
+/* Read/write splitting */
+static SQLWCHAR W_ENABLE_READ_WRITE_SPLITTING[] = { 'E', 'N', 'A', 'B', 'L', 'E', '_', 'R', 'E', 'A', 'D', '_', 'W', 'R', 'I', 'T', 'E', '_', 'S', 'P', 'L', 'I', 'T', 'T', 'I', 'N', 'G', 0 };
+static SQLWCHAR W_READ_WRITE_SPLITTING_SELECTS[] = { 'R', 'E', 'A', 'D', '_', 'W', 'R', 'I', 'T', 'E', '_', 'S', 'P', 'L', 'I', 'T', 'T', 'I', 'N', 'G', '_', 'S', 'E', 'L', 'E', 'C', 'T', 'S', 0 };
+static SQLWCHAR W_READER_HOST_SELECTOR_STRATEGY[] = { 'R', 'E', 'A', 'D', 'E', 'R', '_', 'H', 'O', 'S', 'T', '_', 'S', 'E', 'L', 'E', 'C', 'T', 'O', 'R', '_', 'S', 'T', 'R', 'A', 'T', 'E', 'G', 'Y', 0 };
+
+/* Performance */
+static SQLWCHAR W_ENABLE_BATCH_INSERTS[] = { 'E', 'N', 'A', 'B', 'L', 'E', '_', 'B', 'A', 'T', 'C', 'H', '_', 'I', 'N', 'S', 'E', 'R', 'T', 'S', 0 };
+static SQLWCHAR W_SSPS_CACHE_SIZE[] = { 'S', 'S', 'P', 'S', '_', 'C', 'A', 'C', 'H', 'E', '_', 'S', 'I', 'Z', 'E', 0 };
+static SQLWCHAR W_ENABLE_TOPOLOGY_MONITORING[] = { 'E', 'N', 'A', 'B', 'L', 'E', '_', 'T', 'O', 'P', 'O', 'L', 'O', 'G', 'Y', '_', 'M', 'O', 'N', 'I', 'T', 'O', 'R', 'I', 'N', 'G', 0 };
+static SQLWCHAR W_MONITOR_THREAD_POOL_SIZE[] = { 'M', 'O', 'N', 'I', 'T', 'O', 'R', '_', 'T', 'H', 'R', 'E', 'A', 'D', '_', 'P', 'O', 'O', 'L', '_', 'S', 'I', 'Z', 'E', 0 };
+static SQLWCHAR W_PARSED_QUERY_CACHE_SIZE[] = { 'P', 'A', 'R', 'S', 'E', 'D', '_', 'Q', 'U', 'E', 'R', 'Y', '_', 'C', 'A', 'C', 'H', 'E', '_', 'S', 'I', 'Z', 'E', 0 };
+static SQLWCHAR W_NO_IDLE_PING[] = { 'N', 'O', '_', 'I', 'D', 'L', 'E', '_', 'P', 'I', 'N', 'G', 0 };
+static SQLWCHAR W_READ_AHEAD_ROWS[] = { 'R', 'E', 'A', 'D', '_', 'A', 'H', 'E', 'A', 'D', '_', 'R', 'O', 'W', 'S', 0 };
+static SQLWCHAR W_DNS_CACHE_TTL[] = { 'D', 'N', 'S', '_', 'C', 'A', 'C', 'H', 'E', '_', 'T', 'T', 'L', 0 };
+static SQLWCHAR W_CONNECT_BY_CACHED_IP[] = { 'C', 'O', 'N', 'N', 'E', 'C', 'T', '_', 'B', 'Y', '_', 'C', 'A', 'C', 'H', 'E', 'D', '_', 'I', 'P', 0 };
+
 /* DS_PARAM */
 /* externally used strings */
 const SQLWCHAR W_DRIVER_PARAM[]= {';', 'D', 'R', 'I', 'V', 'E', 'R', '=', 0};
@@ -344,7 +364,10 @@ SQLWCHAR *dsnparams[]= {W_DSN, W_DRIVER, W_DESCRIPTION, W_SERVER,
                         W_HOST_PATTERN, W_CLUSTER_ID, W_TOPOLOGY_REFRESH_RATE,
                         W_FAILOVER_TIMEOUT, W_FAILOVER_TOPOLOGY_REFRESH_RATE,
                         W_FAILOVER_WRITER_RECONNECT_INTERVAL,
-                        W_FAILOVER_READER_CONNECT_TIMEOUT, W_CONNECT_TIMEOUT,
+                        W_FAILOVER_READER_CONNECT_TIMEOUT,
+                        W_FAILOVER_READER_FANOUT, W_FAILOVER_READER_CONNECT_STAGGER,
+                        W_STANDBY_CONNECTIONS, W_STANDBY_CONNECTION_REFRESH_INTERVAL,
+                        W_CONNECT_TIMEOUT,
                         W_NETWORK_TIMEOUT,
                         /* Monitoring */
                         W_ENABLE_FAILURE_DETECTION, W_FAILURE_DETECTION_TIME,
@@ -353,7 +376,15 @@ SQLWCHAR *dsnparams[]= {W_DSN, W_DRIVER, W_DESCRIPTION, W_SERVER,
                         /* Custom Endpoints */
                         W_ENABLE_CUSTOM_ENDPOINT_MONITORING,
                         W_CUSTOM_ENDPOINT_INFO_REFRESH_RATE_MS, W_WAIT_FOR_CUSTOM_ENDPOINT_INFO,
-                        W_WAIT_FOR_CUSTOM_ENDPOINT_INFO_TIMEOUT_MS, W_CUSTOM_ENDPOINT_MONITOR_EXPIRATION_MS, W_CUSTOM_ENDPOINT_REGION};
+                        W_WAIT_FOR_CUSTOM_ENDPOINT_INFO_TIMEOUT_MS, W_CUSTOM_ENDPOINT_MONITOR_EXPIRATION_MS, W_CUSTOM_ENDPOINT_REGION,
+                        /* Performance */
+                        W_ENABLE_BATCH_INSERTS, W_SSPS_CACHE_SIZE,
+                        W_ENABLE_TOPOLOGY_MONITORING, W_MONITOR_THREAD_POOL_SIZE,
+                        W_PARSED_QUERY_CACHE_SIZE, W_NO_IDLE_PING, W_READ_AHEAD_ROWS,
+                        W_DNS_CACHE_TTL, W_CONNECT_BY_CACHED_IP,
+                        /* Read/write splitting */
+                        W_ENABLE_READ_WRITE_SPLITTING, W_READ_WRITE_SPLITTING_SELECTS,
+                        W_READER_HOST_SELECTOR_STRATEGY};
 
 static const
 int dsnparamcnt= sizeof(dsnparams) / sizeof(SQLWCHAR *);
@@ -1061,6 +1092,9 @@ void DataSource::reset() {
   this->opt_TOPOLOGY_REFRESH_RATE.set_default(TOPOLOGY_REFRESH_RATE_MS);
   this->opt_FAILOVER_TIMEOUT.set_default(FAILOVER_TIMEOUT_MS);
   this->opt_FAILOVER_READER_CONNECT_TIMEOUT.set_default(FAILOVER_READER_CONNECT_TIMEOUT_MS);
+  this->opt_FAILOVER_READER_FANOUT.set_default(DEFAULT_FAILOVER_READER_FANOUT);
+  this->opt_STANDBY_CONNECTION_REFRESH_INTERVAL.set_default(STANDBY_CONNECTION_REFRESH_INTERVAL_MS);
+  this->opt_DNS_CACHE_TTL.set_default(DNS_CACHE_TTL_MS);
   this->opt_FAILOVER_TOPOLOGY_REFRESH_RATE.set_default(FAILOVER_TOPOLOGY_REFRESH_RATE_MS);
   this->opt_FAILOVER_WRITER_RECONNECT_INTERVAL.set_default(FAILOVER_WRITER_RECONNECT_INTERVAL_MS);
   this->opt_CONNECT_TIMEOUT.set_default(DEFAULT_CONNECT_TIMEOUT_SECS);
@@ -284,6 +284,11 @@ class Driver {
 #define FAILOVER_TIMEOUT_MS 60000
 #define FAILOVER_READER_CONNECT_TIMEOUT_MS 30000
 #define FAILOVER_WRITER_RECONNECT_INTERVAL_MS 5000
+#define DEFAULT_FAILOVER_READER_FANOUT 2
+#define STANDBY_CONNECTION_REFRESH_INTERVAL_MS 30000
+
+// DNS cache default settings
+#define DNS_CACHE_TTL_MS 30000
 
 // Monitoring default settings
 #define FAILURE_DETECTION_TIME_MS 30000
@@ -346,13 +351,17 @@ unsigned int get_network_timeout(unsigned int seconds);
   X(CLUSTER_ID)                      \
   X(FAILOVER_MODE)
 
-#define FAILOVER_INT_OPTIONS_LIST(X)    \
-  X(TOPOLOGY_REFRESH_RATE)              \
-  X(FAILOVER_TIMEOUT)                   \
-  X(FAILOVER_TOPOLOGY_REFRESH_RATE)     \
-  X(FAILOVER_WRITER_RECONNECT_INTERVAL) \
-  X(FAILOVER_READER_CONNECT_TIMEOUT)    \
-  X(CONNECT_TIMEOUT)                    \
+#define FAILOVER_INT_OPTIONS_LIST(X)     \
+  X(TOPOLOGY_REFRESH_RATE)               \
+  X(FAILOVER_TIMEOUT)                    \
+  X(FAILOVER_TOPOLOGY_REFRESH_RATE)      \
+  X(FAILOVER_WRITER_RECONNECT_INTERVAL)  \
+  X(FAILOVER_READER_CONNECT_TIMEOUT)     \
+  X(FAILOVER_READER_FANOUT)              \
+  X(FAILOVER_READER_CONNECT_STAGGER)     \
+  X(STANDBY_CONNECTIONS)                 \
+  X(STANDBY_CONNECTION_REFRESH_INTERVAL) \
+  X(CONNECT_TIMEOUT)                     \
   X(NETWORK_TIMEOUT)
 
 #define MONITORING_BOOL_OPTIONS_LIST(X) X(ENABLE_FAILURE_DETECTION)
@@ -374,6 +383,16 @@ unsigned int get_network_timeout(unsigned int seconds);
 
 #define CUSTOM_ENDPOINT_STR_OPTIONS_LIST(X) X(CUSTOM_ENDPOINT_REGION)
 
+#define READ_WRITE_SPLITTING_BOOL_OPTIONS_LIST(X) X(ENABLE_READ_WRITE_SPLITTING) X(READ_WRITE_SPLITTING_SELECTS)
+
+#define READ_WRITE_SPLITTING_STR_OPTIONS_LIST(X) X(READER_HOST_SELECTOR_STRATEGY)
+
+#define PERFORMANCE_BOOL_OPTIONS_LIST(X) X(ENABLE_BATCH_INSERTS) X(ENABLE_TOPOLOGY_MONITORING) \
+  X(NO_IDLE_PING) X(CONNECT_BY_CACHED_IP)
+
+#define PERFORMANCE_INT_OPTIONS_LIST(X) X(SSPS_CACHE_SIZE) X(MONITOR_THREAD_POOL_SIZE) \
+  X(PARSED_QUERY_CACHE_SIZE) X(READ_AHEAD_ROWS) X(DNS_CACHE_TTL)
+
 #define STR_OPTIONS_LIST(X)                                                   \
   X(DSN)                                                                      \
   X(DRIVER)                                                                   \
@@ -385,7 +404,8 @@ unsigned int get_network_timeout(unsigned int seconds);
       X(SSL_CIPHER) X(SSL_MODE) X(RSAKEY) X(SAVEFILE) X(PLUGIN_DIR) X(DEFAULT_AUTH) X(LOAD_DATA_LOCAL_DIR)           \
           X(OCI_CONFIG_FILE) X(OCI_CONFIG_PROFILE) X(AUTHENTICATION_KERBEROS_MODE) X(TLS_VERSIONS) X(SSL_CRL)        \
               X(SSL_CRLPATH) X(SSLVERIFY) X(OPENTELEMETRY) AWS_AUTH_STR_OPTIONS_LIST(X) FAILOVER_STR_OPTIONS_LIST(X) \
-                  CUSTOM_ENDPOINT_STR_OPTIONS_LIST(X) FED_AUTH_STR_OPTIONS_LIST(X)
+                  CUSTOM_ENDPOINT_STR_OPTIONS_LIST(X) FED_AUTH_STR_OPTIONS_LIST(X)                   \
+                      READ_WRITE_SPLITTING_STR_OPTIONS_LIST(X)
 
 #define INT_OPTIONS_LIST(X)                                                                            \
   X(PORT)                                                                                              \
@@ -393,7 +413,7 @@ unsigned int get_network_timeout(unsigned int seconds);
   X(WRITETIMEOUT)                                                                                      \
   X(CLIENT_INTERACTIVE)                                                                                \
   X(PREFETCH) FAILOVER_INT_OPTIONS_LIST(X) AWS_AUTH_INT_OPTIONS_LIST(X) MONITORING_INT_OPTIONS_LIST(X) \
-      CUSTOM_ENDPOINT_INT_OPTIONS_LIST(X) FED_AUTH_INT_OPTIONS_LIST(X)
+      CUSTOM_ENDPOINT_INT_OPTIONS_LIST(X) FED_AUTH_INT_OPTIONS_LIST(X) PERFORMANCE_INT_OPTIONS_LIST(X)
 
 // TODO: remove AUTO_RECONNECT when special handling (warning)
 //       is not needed anymore.
@@ -410,7 +430,8 @@ unsigned int get_network_timeout(unsigned int seconds);
               X(MULTI_STATEMENTS) X(COLUMN_SIZE_S32) X(MIN_DATE_TO_ZERO) X(ZERO_DATE_TO_MIN) X(DFLT_BIGINT_BIND_STR) \
                   X(LOG_QUERY) X(NO_SSPS) X(NO_TLS_1_2) X(NO_TLS_1_3) X(NO_DATE_OVERFLOW) X(ENABLE_LOCAL_INFILE)     \
                       X(ENABLE_DNS_SRV) X(MULTI_HOST) FAILOVER_BOOL_OPTIONS_LIST(X) MONITORING_BOOL_OPTIONS_LIST(X)  \
-                          CUSTOM_ENDPOINT_BOOL_OPTIONS_LIST(X) FED_AUTH_BOOL_OPTIONS_LIST(X)
+                          CUSTOM_ENDPOINT_BOOL_OPTIONS_LIST(X) FED_AUTH_BOOL_OPTIONS_LIST(X)                         \
+                              PERFORMANCE_BOOL_OPTIONS_LIST(X) READ_WRITE_SPLITTING_BOOL_OPTIONS_LIST(X)
 
 #define FULL_OPTIONS_LIST(X) \
   STR_OPTIONS_LIST(X) INT_OPTIONS_LIST(X) BOOL_OPTIONS_LIST(X)
@@ -507,6 +528,10 @@ extern const SQLWCHAR W_INVALID_ATTR_STR[];
 #define FAILOVER_MODE_STRICT_READER     "STRICT READER"
 #define FAILOVER_MODE_READER_OR_WRITER  "READER OR WRITER"
 
+#define READER_HOST_SELECTOR_RANDOM             "RANDOM"
+#define READER_HOST_SELECTOR_ROUND_ROBIN        "ROUND ROBIN"
+#define READER_HOST_SELECTOR_LEAST_REPLICA_LAG  "LEAST REPLICA LAG"
+
 /*
  * Deprecated connection parameters
  */